@@ -1,7 +1,4 @@
 #include "Audio/AudioEngine.h"
-#include "Nodes/Audio/FFTAnalyzerNode.h"
-#include "Nodes/Audio/EnvelopeFollowerNode.h"
-#include "Nodes/Audio/BandSplitterNode.h"
 #include <cstring>
 
 namespace pf
@@ -77,12 +74,22 @@ void AudioEngine::initialise()
         blockSize_.store (device->getCurrentBufferSizeSamples(), std::memory_order_release);
     }
 
+    workerPool_.start (AudioWorkerPool::getDefaultNumWorkers());
     deviceManager_.addAudioCallback (this);
 }
 
 void AudioEngine::shutdown()
 {
+    recorder_.stop();
     deviceManager_.removeAudioCallback (this);
+
+    // The callback can no longer run, so drop our hold on the last graph
+    if (auto* graphs = graphs_.load (std::memory_order_acquire))
+        graphs->release (GraphReclaimer::Reader::Audio);
+    localGraph_ = nullptr;
+    inputNode_ = nullptr;
+
+    workerPool_.stop();
 }
 
 void AudioEngine::audioDeviceAboutToStart (juce::AudioIODevice* device)
@@ -99,6 +106,11 @@ void AudioEngine::audioDeviceStopped()
     DBG ("AudioEngine: device stopped");
 }
 
+juce::String AudioEngine::startRecording (const juce::File& file, GraphModel& model)
+{
+    return recorder_.start (file, getSampleRate(), getBlockSize(), model);
+}
+
 void AudioEngine::audioDeviceIOCallbackWithContext (
     const float* const* inputChannelData,
     int numInputChannels,
@@ -107,11 +119,29 @@ void AudioEngine::audioDeviceIOCallbackWithContext (
     int numSamples,
     const juce::AudioIODeviceCallbackContext& /*context*/)
 {
-    // Check for new graph (atomic swap)
-    RuntimeGraph* newGraph = pendingGraph_.exchange (nullptr, std::memory_order_acquire);
-    if (newGraph)
+    // Recorded whether or not a graph is running, so a trace keeps the session's timeline
+    recorder_.pushBlock (inputChannelData, numInputChannels, numSamples);
+
+    // Announce the graph we're about to run; it can't be freed until we move off it
+    auto* graphs = graphs_.load (std::memory_order_acquire);
+    RuntimeGraph* newGraph = graphs ? graphs->acquire (GraphReclaimer::Reader::Audio) : nullptr;
+    if (newGraph != localGraph_)
     {
-        // Old localGraph_ lifecycle managed externally (GraphCompiler holds the unique_ptr)
+        inputNode_ = nullptr;
+        if (newGraph)
+        {
+            newGraph->bindAudioNodes();
+
+            // The engine writes device input into the AudioInput node's buffers
+            for (auto* node : newGraph->getAudioProcessOrder())
+            {
+                if (node->getTypeId() == "AudioInput")
+                {
+                    inputNode_ = static_cast<AudioInputNode*> (node);
+                    break;
+                }
+            }
+        }
         localGraph_ = newGraph;
     }
 
@@ -122,92 +152,30 @@ void AudioEngine::audioDeviceIOCallbackWithContext (
 
     if (! localGraph_) return;
 
-    // Find AudioInput node and write device input into its buffers
-    for (auto* node : localGraph_->getAudioProcessOrder())
+    // Port storage holds one prepared block, so larger device buffers run in chunks
+    const int maxChunk = juce::jmax (1, localGraph_->getBlockSize());
+    for (int offset = 0; offset < numSamples; offset += maxChunk)
     {
-        if (node->getTypeId() == "AudioInput")
-        {
-            auto* inputNode = static_cast<AudioInputNode*> (node);
-            inputNode->ensureOutputBufferSize (numSamples);
-
-            auto* outL = inputNode->getAudioOutputBuffer (0);
-            auto* outR = inputNode->getAudioOutputBuffer (1);
-
-            if (outL && numInputChannels > 0 && inputChannelData[0])
-                std::memcpy (outL, inputChannelData[0], sizeof (float) * static_cast<size_t> (numSamples));
-            else if (outL)
-                std::memset (outL, 0, sizeof (float) * static_cast<size_t> (numSamples));
-
-            if (outR && numInputChannels > 1 && inputChannelData[1])
-                std::memcpy (outR, inputChannelData[1], sizeof (float) * static_cast<size_t> (numSamples));
-            else if (outR)
-                std::memset (outR, 0, sizeof (float) * static_cast<size_t> (numSamples));
-
-            break;
-        }
-    }
-
-    // Process the audio graph
-    localGraph_->processAudioBlock (numSamples);
+        const int chunk = juce::jmin (maxChunk, numSamples - offset);
 
-    // Gather analysis data into a frame and push to FIFO
-    currentFrame_ = {};
-    bool hasAnalysis = false;
-
-    for (auto* node : localGraph_->getAudioProcessOrder())
-    {
-        if (node->getTypeId() == "FFTAnalyzer")
+        if (inputNode_)
         {
-            auto data = node->getBufferOutputData (0);
-            if (! data.empty())
+            for (int ch = 0; ch < 2; ++ch)
             {
-                currentFrame_.numBins = static_cast<int> (data.size());
-                int copySize = juce::jmin (currentFrame_.numBins,
-                                           static_cast<int> (currentFrame_.magnitudes.size()));
-                std::memcpy (currentFrame_.magnitudes.data(), data.data(),
-                             sizeof (float) * static_cast<size_t> (copySize));
-                hasAnalysis = true;
+                auto* out = inputNode_->getAudioOutputBuffer (ch);
+                if (! out)
+                    continue;
+
+                if (ch < numInputChannels && inputChannelData[ch])
+                    std::memcpy (out, inputChannelData[ch] + offset, sizeof (float) * static_cast<size_t> (chunk));
+                else
+                    std::memset (out, 0, sizeof (float) * static_cast<size_t> (chunk));
             }
         }
-        else if (node->getTypeId() == "EnvelopeFollower")
-        {
-            currentFrame_.envelope = node->getSignalOutputValue (0);
-            hasAnalysis = true;
-        }
-        else if (node->getTypeId() == "BandSplitter")
-        {
-            for (int i = 0; i < 5; ++i)
-                currentFrame_.bands[i] = node->getSignalOutputValue (i);
-            hasAnalysis = true;
-        }
-    }
 
-    // Snapshot waveform from first AudioInput
-    for (auto* node : localGraph_->getAudioProcessOrder())
-    {
-        if (node->getTypeId() == "AudioInput")
-        {
-            auto* bufL = node->getAudioOutputBuffer (0);
-            auto* bufR = node->getAudioOutputBuffer (1);
-            if (bufL || bufR)
-            {
-                int copySize = juce::jmin (numSamples, static_cast<int> (currentFrame_.waveform.size()));
-                for (int i = 0; i < copySize; ++i)
-                {
-                    if (bufL && bufR)
-                        currentFrame_.waveform[static_cast<size_t> (i)] = 0.5f * (bufL[i] + bufR[i]);
-                    else
-                        currentFrame_.waveform[static_cast<size_t> (i)] = (bufL != nullptr) ? bufL[i] : bufR[i];
-                }
-                currentFrame_.waveformSize = copySize;
-                hasAnalysis = true;
-            }
-            break;
-        }
+        // Process the audio graph
+        localGraph_->processAudioBlock (chunk, &workerPool_);
     }
-
-    if (hasAnalysis)
-        analysisFifo_.pushFrame (currentFrame_);
 }
 
 } // namespace pf
@@ -1,7 +1,8 @@
 #pragma once
 #include <juce_audio_devices/juce_audio_devices.h>
-#include "Graph/RuntimeGraph.h"
-#include "Audio/AnalysisSnapshot.h"
+#include "Graph/GraphReclaimer.h"
+#include "Audio/AudioWorkerPool.h"
+#include "Audio/SessionRecorder.h"
 #include "Nodes/Audio/AudioInputNode.h"
 #include <atomic>
 
@@ -10,7 +11,8 @@ namespace pf
 
 /**
  * Owns AudioDeviceManager. Runs the real-time audio callback.
- * Consumes RuntimeGraph via atomic pointer swap from GraphCompiler.
+ * Acquires the current RuntimeGraph from GraphCompiler's GraphReclaimer each block,
+ * and lends it a worker pool for graphs scheduled to run in parallel.
  */
 class AudioEngine : public juce::AudioIODeviceCallback
 {
@@ -35,28 +37,26 @@ public:
     void audioDeviceStopped() override;
 
     //==============================================================================
-    // Graph management (called from GUI thread)
-    void setNewGraph (RuntimeGraph* graph)
-    {
-        RuntimeGraph* old = pendingGraph_.exchange (graph, std::memory_order_release);
-        // If there was an unconsumed pending graph, it's now orphaned — caller manages lifecycle
-        juce::ignoreUnused (old);
-    }
+    // Graph management (called from GUI thread, before initialise())
+    void setGraphSource (GraphReclaimer* graphs) { graphs_.store (graphs, std::memory_order_release); }
 
     //==============================================================================
-    // Analysis data (read by GUI thread)
-    AnalysisFIFO& getAnalysisFIFO() { return analysisFifo_; }
+    // Session recording (called from GUI thread), see SessionRecorder
+    juce::String startRecording (const juce::File& file, GraphModel& model);
+    void stopRecording() { recorder_.stop(); }
+    bool isRecording() const { return recorder_.isRecording(); }
 
     double getSampleRate() const { return sampleRate_.load (std::memory_order_acquire); }
     int getBlockSize() const { return blockSize_.load (std::memory_order_acquire); }
 
 private:
     juce::AudioDeviceManager deviceManager_;
-    std::atomic<RuntimeGraph*> pendingGraph_ { nullptr };
-    RuntimeGraph* localGraph_ = nullptr;  // Audio thread's cached pointer
+    std::atomic<GraphReclaimer*> graphs_ { nullptr };
+    RuntimeGraph* localGraph_ = nullptr;  // Audio thread's announced graph
+    AudioInputNode* inputNode_ = nullptr; // localGraph_'s AudioInput, which the device feeds
+    AudioWorkerPool workerPool_;
 
-    AnalysisFIFO analysisFifo_;
-    AnalysisFrame currentFrame_;
+    SessionRecorder recorder_;
 
     std::atomic<double> sampleRate_ { 44100.0 };
     std::atomic<int> blockSize_ { 512 };
@@ -0,0 +1,138 @@
+#include "Audio/AudioWorkerPool.h"
+#include <thread>
+
+namespace pf
+{
+
+class AudioWorkerPool::Worker : public juce::Thread
+{
+public:
+    Worker (AudioWorkerPool& pool, int index)
+        : juce::Thread ("PatchFlow Audio Worker " + juce::String (index)), pool_ (pool) {}
+
+    void run() override
+    {
+        while (! pool_.exiting_.load (std::memory_order_acquire))
+        {
+            // Read the wake count before draining: a batch published after this point
+            // bumps it, so the wait below returns straight away instead of missing it
+            auto seen = pool_.wakeCount_.load (std::memory_order_acquire);
+            pool_.drain();
+            pool_.wakeCount_.wait (seen, std::memory_order_acquire);
+        }
+    }
+
+private:
+    AudioWorkerPool& pool_;
+};
+
+//==============================================================================
+AudioWorkerPool::AudioWorkerPool() = default;
+
+AudioWorkerPool::~AudioWorkerPool()
+{
+    stop();
+}
+
+void AudioWorkerPool::start (int numWorkers)
+{
+    if (! workers_.empty())
+        return;
+
+    exiting_.store (false, std::memory_order_release);
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        auto worker = std::make_unique<Worker> (*this, i);
+        if (! worker->startRealtimeThread (juce::Thread::RealtimeOptions{}))
+            worker->startThread (juce::Thread::Priority::highest);
+        workers_.push_back (std::move (worker));
+    }
+
+    DBG ("AudioWorkerPool: " + juce::String (numWorkers) + " workers");
+}
+
+void AudioWorkerPool::stop()
+{
+    if (workers_.empty())
+        return;
+
+    exiting_.store (true, std::memory_order_release);
+    wakeCount_.fetch_add (1, std::memory_order_release);
+    wakeCount_.notify_all();
+
+    for (auto& worker : workers_)
+        worker->stopThread (1000);
+
+    workers_.clear();
+}
+
+void AudioWorkerPool::parallelFor (int count, ItemFn fn, void* context)
+{
+    if (count <= 0)
+        return;
+
+    if (workers_.empty() || count == 1 || count > kMaxItems)
+    {
+        for (int i = 0; i < count; ++i)
+            fn (context, i);
+        return;
+    }
+
+    // The previous batch has fully completed, so no worker still reads these; the
+    // release store of the cursor publishes them with the new batch
+    fn_ = fn;
+    context_ = context;
+    remaining_.store (count, std::memory_order_relaxed);
+
+    const auto batch = batchOf (cursor_.load (std::memory_order_relaxed)) + 1;
+    cursor_.store (makeCursor (batch, count), std::memory_order_release);
+
+    wakeCount_.fetch_add (1, std::memory_order_release);
+    wakeCount_.notify_all();
+
+    drain();
+
+    // Wait for items other threads claimed; they're already running, so this is short
+    for (int spins = 0; remaining_.load (std::memory_order_acquire) > 0; ++spins)
+        if (spins >= 1024)
+            std::this_thread::yield();
+}
+
+void AudioWorkerPool::drain()
+{
+    auto cursor = cursor_.load (std::memory_order_acquire);
+    const auto batch = batchOf (cursor);
+
+    for (;;)
+    {
+        const auto index = indexOf (cursor);
+        if (index >= countOf (cursor))
+            return;
+
+        // Fails if another thread took this item or a new batch started meanwhile;
+        // either way cursor now holds the current word
+        if (! cursor_.compare_exchange_weak (cursor, cursor + 1, std::memory_order_acq_rel,
+                                             std::memory_order_acquire))
+        {
+            if (batchOf (cursor) != batch)
+                return;   // the worker loop comes back for the new batch
+
+            continue;
+        }
+
+        fn_ (context_, index);
+        remaining_.fetch_sub (1, std::memory_order_release);
+        cursor = cursor_.load (std::memory_order_acquire);
+        if (batchOf (cursor) != batch)
+            return;
+    }
+}
+
+int AudioWorkerPool::getDefaultNumWorkers()
+{
+    // Leave a core each for the audio callback itself and the GL thread
+    return juce::jlimit (0, 3, juce::SystemStats::getNumPhysicalCpus() - 2);
+}
+
+} // namespace pf
@@ -0,0 +1,82 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace pf
+{
+
+/**
+ * Pre-spawned realtime-priority threads that help the audio callback run
+ * independent work items.
+ *
+ * The audio thread hands out one batch at a time through parallelFor() and works
+ * on it too. Items are claimed from a lock-free cursor and counted down on
+ * completion; nothing allocates or locks on the audio thread. Idle workers sleep
+ * on an atomic wait, so waking them costs one notify per batch.
+ */
+class AudioWorkerPool
+{
+public:
+    /** Work item callback: fn (context, itemIndex). */
+    using ItemFn = void (*) (void* context, int index);
+
+    AudioWorkerPool();
+    ~AudioWorkerPool();
+
+    /** Message thread: spawns the workers. Does nothing if they're already running. */
+    void start (int numWorkers);
+
+    /** Message thread: stops and joins the workers. No parallelFor() may be running. */
+    void stop();
+
+    int getNumWorkers() const { return static_cast<int> (workers_.size()); }
+
+    /** Audio thread: runs fn (context, i) for every i in [0, count) on the workers and
+        the calling thread, and returns once all items have finished. */
+    void parallelFor (int count, ItemFn fn, void* context);
+
+    /** Suggested worker count for this machine: one per spare physical core, capped. */
+    static int getDefaultNumWorkers();
+
+private:
+    class Worker;
+
+    /** Claims and runs items of the current batch until none are left. */
+    void drain();
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+
+    // Batch cursor: the batch id, the batch's item count and the next item, in one
+    // word so that a single load sees all three together. Claiming an item is a CAS
+    // on the whole word, so a worker still finishing an old batch can never take an
+    // index from the next one, and bails out once it sees the batch has changed.
+    static constexpr int kIndexBits = 20;
+    static constexpr int kCountBits = 20;
+    static constexpr int kMaxItems = (1 << kIndexBits) - 1;
+
+    static uint64_t makeCursor (uint64_t batch, int count)
+    {
+        return (batch << (kIndexBits + kCountBits)) | (static_cast<uint64_t> (count) << kIndexBits);
+    }
+
+    static uint64_t batchOf (uint64_t cursor) { return cursor >> (kIndexBits + kCountBits); }
+    static int countOf (uint64_t cursor)      { return static_cast<int> ((cursor >> kIndexBits) & kMaxItems); }
+    static int indexOf (uint64_t cursor)      { return static_cast<int> (cursor & kMaxItems); }
+
+    std::atomic<uint64_t> cursor_ { 0 };
+    std::atomic<int> remaining_ { 0 };
+    std::atomic<uint32_t> wakeCount_ { 0 };
+    std::atomic<bool> exiting_ { false };
+
+    // Written before the batch's cursor is published, and only read after claiming
+    // one of its items, which the caller waits for before starting another batch
+    ItemFn fn_ = nullptr;
+    void* context_ = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (AudioWorkerPool)
+};
+
+} // namespace pf
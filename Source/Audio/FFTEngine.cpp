@@ -0,0 +1,177 @@
+#include "Audio/FFTEngine.h"
+#include "Audio/FFTKernels.h"
+#include <juce_dsp/juce_dsp.h>
+#include <algorithm>
+#include <cmath>
+
+namespace pf
+{
+
+namespace
+{
+
+class JuceFFTEngine final : public FFTEngine
+{
+public:
+    explicit JuceFFTEngine (int order)
+        : FFTEngine (order, Backend::juce),
+          fft_ (order),
+          buffer_ (static_cast<size_t> (2 * getSize()))
+    {
+    }
+
+    void computeMagnitudes (const float* input, float* magnitudes) override
+    {
+        const auto size = static_cast<size_t> (getSize());
+        std::copy_n (input, size, buffer_.begin());
+        std::fill (buffer_.begin() + static_cast<std::ptrdiff_t> (size), buffer_.end(), 0.f);
+
+        fft_.performFrequencyOnlyForwardTransform (buffer_.data(), true);
+        std::copy_n (buffer_.begin(), size / 2, magnitudes);
+    }
+
+private:
+    juce::dsp::FFT fft_;
+    std::vector<float> buffer_;
+};
+
+/** A 2n-sample real frame as an n-point complex transform of its even and odd
+    samples, split back into bins afterwards. */
+class RealFFTEngine final : public FFTEngine
+{
+public:
+    RealFFTEngine (int order, Backend backend, const FFTKernels& kernels)
+        : FFTEngine (order, backend), kernels_ (kernels), n_ (getSize() / 2)
+    {
+        const auto n = static_cast<size_t> (n_);
+
+        // Pass twiddles e^(-2 pi i p / 2 half), one run per pass
+        for (int half = n_ / 2; half >= 1; half /= 2)
+        {
+            for (int p = 0; p < half; ++p)
+            {
+                const auto angle = juce::MathConstants<double>::pi * p / half;
+                twiddlesRe_.push_back (static_cast<float> (std::cos (angle)));
+                twiddlesIm_.push_back (static_cast<float> (-std::sin (angle)));
+            }
+        }
+
+        cosines_.resize (n);
+        sines_.resize (n);
+        for (size_t k = 0; k < n; ++k)
+        {
+            const auto angle = juce::MathConstants<double>::pi * static_cast<double> (k) / n_;
+            cosines_[k] = static_cast<float> (std::cos (angle));
+            sines_[k] = static_cast<float> (std::sin (angle));
+        }
+
+        for (auto* buffer : { &re_[0], &im_[0], &re_[1], &im_[1] })
+            buffer->resize (n);
+    }
+
+    void computeMagnitudes (const float* input, float* magnitudes) override
+    {
+        auto* xRe = re_[0].data();
+        auto* xIm = im_[0].data();
+        auto* yRe = re_[1].data();
+        auto* yIm = im_[1].data();
+
+        kernels_.deinterleave (input, xRe, xIm, n_);
+
+        const float* twRe = twiddlesRe_.data();
+        const float* twIm = twiddlesIm_.data();
+        for (int half = n_ / 2, stride = 1; half >= 1; half /= 2, stride *= 2)
+        {
+            kernels_.pass (xRe, xIm, yRe, yIm, twRe, twIm, half, stride);
+            twRe += half;
+            twIm += half;
+            std::swap (xRe, yRe);
+            std::swap (xIm, yIm);
+        }
+
+        // DC is the sum of the even and odd halves' DC
+        magnitudes[0] = std::abs (xRe[0] + xIm[0]);
+        kernels_.magnitudes (xRe, xIm, cosines_.data(), sines_.data(), magnitudes, n_, 1);
+    }
+
+private:
+    const FFTKernels& kernels_;
+    const int n_;
+
+    std::vector<float> twiddlesRe_, twiddlesIm_;
+    std::vector<float> cosines_, sines_;
+    std::vector<float> re_[2], im_[2];   // ping-pong between passes
+};
+
+const FFTKernels* getKernels (FFTEngine::Backend backend)
+{
+    switch (backend)
+    {
+        case FFTEngine::Backend::scalar: return getScalarFFTKernels();
+        case FFTEngine::Backend::sse2:   return juce::SystemStats::hasSSE2() ? getSSE2FFTKernels() : nullptr;
+        case FFTEngine::Backend::avx2:   return juce::SystemStats::hasAVX2() && juce::SystemStats::hasFMA3() ? getAVX2FFTKernels() : nullptr;
+        case FFTEngine::Backend::neon:   return juce::SystemStats::hasNeon() ? getNEONFFTKernels() : nullptr;
+        case FFTEngine::Backend::juce:   break;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+//==============================================================================
+std::unique_ptr<FFTEngine> FFTEngine::create (int order)
+{
+    return create (order, getDefaultBackend());
+}
+
+std::unique_ptr<FFTEngine> FFTEngine::create (int order, Backend backend)
+{
+    jassert (order >= 4);
+
+    if (backend == Backend::juce)
+        return std::make_unique<JuceFFTEngine> (order);
+
+    if (auto* kernels = getKernels (backend))
+        return std::make_unique<RealFFTEngine> (order, backend, *kernels);
+
+    return nullptr;
+}
+
+FFTEngine::Backend FFTEngine::getDefaultBackend()
+{
+    static const auto backend = []
+    {
+        for (auto candidate : { Backend::avx2, Backend::neon, Backend::sse2 })
+            if (getKernels (candidate) != nullptr)
+                return candidate;
+
+        return Backend::scalar;
+    }();
+
+    return backend;
+}
+
+std::vector<FFTEngine::Backend> FFTEngine::getAvailableBackends()
+{
+    std::vector<Backend> backends { Backend::juce };
+    for (auto backend : { Backend::scalar, Backend::sse2, Backend::avx2, Backend::neon })
+        if (getKernels (backend) != nullptr)
+            backends.push_back (backend);
+
+    return backends;
+}
+
+const char* FFTEngine::getBackendName (Backend backend)
+{
+    switch (backend)
+    {
+        case Backend::juce:   return "juce";
+        case Backend::scalar: return "scalar";
+        case Backend::sse2:   return "sse2";
+        case Backend::avx2:   return "avx2";
+        case Backend::neon:   return "neon";
+    }
+    return "";
+}
+
+} // namespace pf
@@ -0,0 +1,60 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <memory>
+#include <vector>
+
+namespace pf
+{
+
+/**
+ * Magnitude spectrum of a real frame whose length is a power of two.
+ *
+ * Two implementations sit behind this interface: juce::dsp::FFT, and PatchFlow's
+ * own real FFT, which packs the frame into a complex transform of half its length
+ * (radix-2 Stockham passes over split real/imaginary arrays, with the twiddles of
+ * every pass precomputed for the order) and splits the result back into bins.
+ * The latter has scalar, SSE2, AVX2 and NEON kernels; the default backend is the
+ * widest of them the CPU supports, chosen once, the first time it's asked for.
+ *
+ * An engine is built for one order. computeMagnitudes() doesn't allocate or lock,
+ * so it can run on the audio thread.
+ */
+class FFTEngine
+{
+public:
+    enum class Backend { juce, scalar, sse2, avx2, neon };
+
+    virtual ~FFTEngine() = default;
+
+    /** Writes |X[k]| for k in [0, getSize() / 2), X being the unnormalised forward
+        transform of the getSize() samples at input (as juce::dsp::FFT's
+        performFrequencyOnlyForwardTransform() computes it). */
+    virtual void computeMagnitudes (const float* input, float* magnitudes) = 0;
+
+    int getOrder() const       { return order_; }
+    int getSize() const        { return 1 << order_; }
+    Backend getBackend() const { return backend_; }
+
+    /** An engine on the default backend. */
+    static std::unique_ptr<FFTEngine> create (int order);
+
+    /** An engine on the given backend, or nullptr if this build or CPU lacks it. */
+    static std::unique_ptr<FFTEngine> create (int order, Backend backend);
+
+    /** The fastest in-tree backend this build and CPU support. */
+    static Backend getDefaultBackend();
+
+    /** Every backend create() accepts here, JUCE's first. */
+    static std::vector<Backend> getAvailableBackends();
+
+    static const char* getBackendName (Backend backend);
+
+protected:
+    FFTEngine (int order, Backend backend) : order_ (order), backend_ (backend) {}
+
+private:
+    int order_;
+    Backend backend_;
+};
+
+} // namespace pf
@@ -0,0 +1,356 @@
+#include "Audio/FFTKernels.h"
+#include <cmath>
+
+#if defined (__SSE2__) || defined (_M_X64)
+ #define PATCHFLOW_FFT_SSE2 1
+ #include <emmintrin.h>
+#elif defined (__ARM_NEON) && defined (__aarch64__)
+ #define PATCHFLOW_FFT_NEON 1
+ #include <arm_neon.h>
+#endif
+
+namespace pf
+{
+
+namespace
+{
+
+//==============================================================================
+// Scalar
+
+void deinterleaveScalar (const float* input, float* re, float* im, int count)
+{
+    for (int k = 0; k < count; ++k)
+    {
+        re[k] = input[2 * k];
+        im[k] = input[2 * k + 1];
+    }
+}
+
+void passScalar (const float* xRe, const float* xIm, float* yRe, float* yIm,
+                 const float* twRe, const float* twIm, int half, int stride)
+{
+    for (int p = 0; p < half; ++p)
+    {
+        const float wr = twRe[p];
+        const float wi = twIm[p];
+        const int a = stride * p;
+        const int b = stride * (p + half);
+        const int y0 = stride * 2 * p;
+        const int y1 = y0 + stride;
+
+        for (int q = 0; q < stride; ++q)
+        {
+            const float dr = xRe[a + q] - xRe[b + q];
+            const float di = xIm[a + q] - xIm[b + q];
+            yRe[y0 + q] = xRe[a + q] + xRe[b + q];
+            yIm[y0 + q] = xIm[a + q] + xIm[b + q];
+            yRe[y1 + q] = dr * wr - di * wi;
+            yIm[y1 + q] = dr * wi + di * wr;
+        }
+    }
+}
+
+void magnitudesScalar (const float* zRe, const float* zIm, const float* cosines, const float* sines,
+                       float* magnitudes, int n, int first)
+{
+    for (int k = first; k < n; ++k)
+    {
+        // X[k] = (Z[k] + conj Z[n-k]) / 2 - i e^(-i pi k / n) (Z[k] - conj Z[n-k]) / 2
+        const float p = zRe[k] + zRe[n - k];
+        const float q = zIm[k] - zIm[n - k];
+        const float r = zIm[k] + zIm[n - k];
+        const float s = zRe[n - k] - zRe[k];
+        const float xr = p + cosines[k] * r + sines[k] * s;
+        const float xi = q + cosines[k] * s - sines[k] * r;
+        magnitudes[k] = 0.5f * std::sqrt (xr * xr + xi * xi);
+    }
+}
+
+const FFTKernels scalarKernels { deinterleaveScalar, passScalar, magnitudesScalar };
+
+//==============================================================================
+#if PATCHFLOW_FFT_SSE2
+
+void deinterleaveSSE2 (const float* input, float* re, float* im, int count)
+{
+    int k = 0;
+    for (; k + 4 <= count; k += 4)
+    {
+        const auto lo = _mm_loadu_ps (input + 2 * k);
+        const auto hi = _mm_loadu_ps (input + 2 * k + 4);
+        _mm_storeu_ps (re + k, _mm_shuffle_ps (lo, hi, _MM_SHUFFLE (2, 0, 2, 0)));
+        _mm_storeu_ps (im + k, _mm_shuffle_ps (lo, hi, _MM_SHUFFLE (3, 1, 3, 1)));
+    }
+
+    deinterleaveScalar (input + 2 * k, re + k, im + k, count - k);
+}
+
+inline void butterflySSE2 (__m128 ar, __m128 ai, __m128 br, __m128 bi, __m128 wr, __m128 wi,
+                           __m128& sumRe, __m128& sumIm, __m128& difRe, __m128& difIm)
+{
+    const auto dr = _mm_sub_ps (ar, br);
+    const auto di = _mm_sub_ps (ai, bi);
+    sumRe = _mm_add_ps (ar, br);
+    sumIm = _mm_add_ps (ai, bi);
+    difRe = _mm_sub_ps (_mm_mul_ps (dr, wr), _mm_mul_ps (di, wi));
+    difIm = _mm_add_ps (_mm_mul_ps (dr, wi), _mm_mul_ps (di, wr));
+}
+
+void passSSE2 (const float* xRe, const float* xIm, float* yRe, float* yIm,
+               const float* twRe, const float* twIm, int half, int stride)
+{
+    __m128 sumRe, sumIm, difRe, difIm;
+
+    if (stride >= 4)
+    {
+        // One twiddle per p, four q at a time
+        for (int p = 0; p < half; ++p)
+        {
+            const auto wr = _mm_set1_ps (twRe[p]);
+            const auto wi = _mm_set1_ps (twIm[p]);
+            const int a = stride * p;
+            const int b = stride * (p + half);
+            const int y0 = stride * 2 * p;
+            const int y1 = y0 + stride;
+
+            for (int q = 0; q < stride; q += 4)
+            {
+                butterflySSE2 (_mm_loadu_ps (xRe + a + q), _mm_loadu_ps (xIm + a + q),
+                               _mm_loadu_ps (xRe + b + q), _mm_loadu_ps (xIm + b + q),
+                               wr, wi, sumRe, sumIm, difRe, difIm);
+                _mm_storeu_ps (yRe + y0 + q, sumRe);
+                _mm_storeu_ps (yIm + y0 + q, sumIm);
+                _mm_storeu_ps (yRe + y1 + q, difRe);
+                _mm_storeu_ps (yIm + y1 + q, difIm);
+            }
+        }
+    }
+    else if (stride == 2 && half >= 2)
+    {
+        // Two p of two q each: the sums and differences of a p are adjacent pairs
+        for (int p = 0; p < half; p += 2)
+        {
+            const auto wr = _mm_set_ps (twRe[p + 1], twRe[p + 1], twRe[p], twRe[p]);
+            const auto wi = _mm_set_ps (twIm[p + 1], twIm[p + 1], twIm[p], twIm[p]);
+            butterflySSE2 (_mm_loadu_ps (xRe + 2 * p), _mm_loadu_ps (xIm + 2 * p),
+                           _mm_loadu_ps (xRe + 2 * (p + half)), _mm_loadu_ps (xIm + 2 * (p + half)),
+                           wr, wi, sumRe, sumIm, difRe, difIm);
+            _mm_storeu_ps (yRe + 4 * p,     _mm_movelh_ps (sumRe, difRe));
+            _mm_storeu_ps (yRe + 4 * p + 4, _mm_movehl_ps (difRe, sumRe));
+            _mm_storeu_ps (yIm + 4 * p,     _mm_movelh_ps (sumIm, difIm));
+            _mm_storeu_ps (yIm + 4 * p + 4, _mm_movehl_ps (difIm, sumIm));
+        }
+    }
+    else if (stride == 1 && half >= 4)
+    {
+        // Four p at a time, interleaving sums and differences on the way out
+        for (int p = 0; p < half; p += 4)
+        {
+            butterflySSE2 (_mm_loadu_ps (xRe + p), _mm_loadu_ps (xIm + p),
+                           _mm_loadu_ps (xRe + p + half), _mm_loadu_ps (xIm + p + half),
+                           _mm_loadu_ps (twRe + p), _mm_loadu_ps (twIm + p), sumRe, sumIm, difRe, difIm);
+            _mm_storeu_ps (yRe + 2 * p,     _mm_unpacklo_ps (sumRe, difRe));
+            _mm_storeu_ps (yRe + 2 * p + 4, _mm_unpackhi_ps (sumRe, difRe));
+            _mm_storeu_ps (yIm + 2 * p,     _mm_unpacklo_ps (sumIm, difIm));
+            _mm_storeu_ps (yIm + 2 * p + 4, _mm_unpackhi_ps (sumIm, difIm));
+        }
+    }
+    else
+    {
+        passScalar (xRe, xIm, yRe, yIm, twRe, twIm, half, stride);
+    }
+}
+
+void magnitudesSSE2 (const float* zRe, const float* zIm, const float* cosines, const float* sines,
+                     float* magnitudes, int n, int first)
+{
+    const auto halfScale = _mm_set1_ps (0.5f);
+    int k = first;
+
+    // Z[n-k] for four k is four descending entries, loaded and reversed
+    for (; k + 4 <= n; k += 4)
+    {
+        const auto ar = _mm_loadu_ps (zRe + k);
+        const auto ai = _mm_loadu_ps (zIm + k);
+        auto br = _mm_loadu_ps (zRe + n - k - 3);
+        auto bi = _mm_loadu_ps (zIm + n - k - 3);
+        br = _mm_shuffle_ps (br, br, _MM_SHUFFLE (0, 1, 2, 3));
+        bi = _mm_shuffle_ps (bi, bi, _MM_SHUFFLE (0, 1, 2, 3));
+
+        const auto c = _mm_loadu_ps (cosines + k);
+        const auto s = _mm_loadu_ps (sines + k);
+        const auto p = _mm_add_ps (ar, br);
+        const auto q = _mm_sub_ps (ai, bi);
+        const auto r = _mm_add_ps (ai, bi);
+        const auto d = _mm_sub_ps (br, ar);
+        const auto xr = _mm_add_ps (p, _mm_add_ps (_mm_mul_ps (c, r), _mm_mul_ps (s, d)));
+        const auto xi = _mm_add_ps (q, _mm_sub_ps (_mm_mul_ps (c, d), _mm_mul_ps (s, r)));
+        const auto power = _mm_add_ps (_mm_mul_ps (xr, xr), _mm_mul_ps (xi, xi));
+        _mm_storeu_ps (magnitudes + k, _mm_mul_ps (halfScale, _mm_sqrt_ps (power)));
+    }
+
+    magnitudesScalar (zRe, zIm, cosines, sines, magnitudes, n, k);
+}
+
+const FFTKernels sse2Kernels { deinterleaveSSE2, passSSE2, magnitudesSSE2 };
+
+#endif
+
+//==============================================================================
+#if PATCHFLOW_FFT_NEON
+
+void deinterleaveNEON (const float* input, float* re, float* im, int count)
+{
+    int k = 0;
+    for (; k + 4 <= count; k += 4)
+    {
+        const auto pairs = vld2q_f32 (input + 2 * k);
+        vst1q_f32 (re + k, pairs.val[0]);
+        vst1q_f32 (im + k, pairs.val[1]);
+    }
+
+    deinterleaveScalar (input + 2 * k, re + k, im + k, count - k);
+}
+
+inline void butterflyNEON (float32x4_t ar, float32x4_t ai, float32x4_t br, float32x4_t bi, float32x4_t wr, float32x4_t wi,
+                           float32x4_t& sumRe, float32x4_t& sumIm, float32x4_t& difRe, float32x4_t& difIm)
+{
+    const auto dr = vsubq_f32 (ar, br);
+    const auto di = vsubq_f32 (ai, bi);
+    sumRe = vaddq_f32 (ar, br);
+    sumIm = vaddq_f32 (ai, bi);
+    difRe = vfmsq_f32 (vmulq_f32 (dr, wr), di, wi);
+    difIm = vfmaq_f32 (vmulq_f32 (dr, wi), di, wr);
+}
+
+void passNEON (const float* xRe, const float* xIm, float* yRe, float* yIm,
+               const float* twRe, const float* twIm, int half, int stride)
+{
+    float32x4_t sumRe, sumIm, difRe, difIm;
+
+    if (stride >= 4)
+    {
+        // One twiddle per p, four q at a time
+        for (int p = 0; p < half; ++p)
+        {
+            const auto wr = vdupq_n_f32 (twRe[p]);
+            const auto wi = vdupq_n_f32 (twIm[p]);
+            const int a = stride * p;
+            const int b = stride * (p + half);
+            const int y0 = stride * 2 * p;
+            const int y1 = y0 + stride;
+
+            for (int q = 0; q < stride; q += 4)
+            {
+                butterflyNEON (vld1q_f32 (xRe + a + q), vld1q_f32 (xIm + a + q),
+                               vld1q_f32 (xRe + b + q), vld1q_f32 (xIm + b + q),
+                               wr, wi, sumRe, sumIm, difRe, difIm);
+                vst1q_f32 (yRe + y0 + q, sumRe);
+                vst1q_f32 (yIm + y0 + q, sumIm);
+                vst1q_f32 (yRe + y1 + q, difRe);
+                vst1q_f32 (yIm + y1 + q, difIm);
+            }
+        }
+    }
+    else if (stride == 2 && half >= 2)
+    {
+        // Two p of two q each: the sums and differences of a p are adjacent pairs
+        for (int p = 0; p < half; p += 2)
+        {
+            const auto wr2 = vld1_f32 (twRe + p);
+            const auto wi2 = vld1_f32 (twIm + p);
+            butterflyNEON (vld1q_f32 (xRe + 2 * p), vld1q_f32 (xIm + 2 * p),
+                           vld1q_f32 (xRe + 2 * (p + half)), vld1q_f32 (xIm + 2 * (p + half)),
+                           vcombine_f32 (vdup_lane_f32 (wr2, 0), vdup_lane_f32 (wr2, 1)),
+                           vcombine_f32 (vdup_lane_f32 (wi2, 0), vdup_lane_f32 (wi2, 1)),
+                           sumRe, sumIm, difRe, difIm);
+            vst1q_f32 (yRe + 4 * p,     vcombine_f32 (vget_low_f32 (sumRe), vget_low_f32 (difRe)));
+            vst1q_f32 (yRe + 4 * p + 4, vcombine_f32 (vget_high_f32 (sumRe), vget_high_f32 (difRe)));
+            vst1q_f32 (yIm + 4 * p,     vcombine_f32 (vget_low_f32 (sumIm), vget_low_f32 (difIm)));
+            vst1q_f32 (yIm + 4 * p + 4, vcombine_f32 (vget_high_f32 (sumIm), vget_high_f32 (difIm)));
+        }
+    }
+    else if (stride == 1 && half >= 4)
+    {
+        // Four p at a time, interleaving sums and differences on the way out
+        for (int p = 0; p < half; p += 4)
+        {
+            butterflyNEON (vld1q_f32 (xRe + p), vld1q_f32 (xIm + p),
+                           vld1q_f32 (xRe + p + half), vld1q_f32 (xIm + p + half),
+                           vld1q_f32 (twRe + p), vld1q_f32 (twIm + p), sumRe, sumIm, difRe, difIm);
+            vst2q_f32 (yRe + 2 * p, (float32x4x2_t { { sumRe, difRe } }));
+            vst2q_f32 (yIm + 2 * p, (float32x4x2_t { { sumIm, difIm } }));
+        }
+    }
+    else
+    {
+        passScalar (xRe, xIm, yRe, yIm, twRe, twIm, half, stride);
+    }
+}
+
+inline float32x4_t reverseNEON (float32x4_t v)
+{
+    const auto pairsSwapped = vrev64q_f32 (v);
+    return vextq_f32 (pairsSwapped, pairsSwapped, 2);
+}
+
+void magnitudesNEON (const float* zRe, const float* zIm, const float* cosines, const float* sines,
+                     float* magnitudes, int n, int first)
+{
+    int k = first;
+
+    // Z[n-k] for four k is four descending entries, loaded and reversed
+    for (; k + 4 <= n; k += 4)
+    {
+        const auto ar = vld1q_f32 (zRe + k);
+        const auto ai = vld1q_f32 (zIm + k);
+        const auto br = reverseNEON (vld1q_f32 (zRe + n - k - 3));
+        const auto bi = reverseNEON (vld1q_f32 (zIm + n - k - 3));
+
+        const auto c = vld1q_f32 (cosines + k);
+        const auto s = vld1q_f32 (sines + k);
+        const auto p = vaddq_f32 (ar, br);
+        const auto q = vsubq_f32 (ai, bi);
+        const auto r = vaddq_f32 (ai, bi);
+        const auto d = vsubq_f32 (br, ar);
+        const auto xr = vfmaq_f32 (vfmaq_f32 (p, c, r), s, d);
+        const auto xi = vfmsq_f32 (vfmaq_f32 (q, c, d), s, r);
+        const auto power = vfmaq_f32 (vmulq_f32 (xr, xr), xi, xi);
+        vst1q_f32 (magnitudes + k, vmulq_n_f32 (vsqrtq_f32 (power), 0.5f));
+    }
+
+    magnitudesScalar (zRe, zIm, cosines, sines, magnitudes, n, k);
+}
+
+const FFTKernels neonKernels { deinterleaveNEON, passNEON, magnitudesNEON };
+
+#endif
+
+} // namespace
+
+//==============================================================================
+const FFTKernels* getScalarFFTKernels()
+{
+    return &scalarKernels;
+}
+
+const FFTKernels* getSSE2FFTKernels()
+{
+   #if PATCHFLOW_FFT_SSE2
+    return &sse2Kernels;
+   #else
+    return nullptr;
+   #endif
+}
+
+const FFTKernels* getNEONFFTKernels()
+{
+   #if PATCHFLOW_FFT_NEON
+    return &neonKernels;
+   #else
+    return nullptr;
+   #endif
+}
+
+} // namespace pf
@@ -0,0 +1,45 @@
+#pragma once
+
+namespace pf
+{
+
+/**
+ * The inner loops of FFTEngine's real FFT, one set per instruction set.
+ *
+ * Complex data is held as separate real and imaginary arrays; loads and stores are
+ * unaligned. The AVX2 set is in a translation unit of its own, built for AVX2
+ * without raising the baseline of the rest of the program, and only handed out
+ * when the CPU has it. Keep that file free of anything with inline linkage (the
+ * standard library included), as a copy built for AVX2 could be linked in place
+ * of everyone else's.
+ */
+struct FFTKernels
+{
+    /** re[k] = input[2k] and im[k] = input[2k + 1], for k in [0, count). */
+    void (*deinterleave) (const float* input, float* re, float* im, int count);
+
+    /** One radix-2 Stockham pass: for p in [0, half) and q in [0, stride),
+            a = x[q + stride * p], b = x[q + stride * (p + half)],
+            y[q + stride * 2p] = a + b, y[q + stride * (2p + 1)] = (a - b) * tw[p].
+        Passes with half = n/2, n/4 ... 1 and stride = 1, 2 ... n/2 transform n
+        points in natural order. */
+    void (*pass) (const float* xRe, const float* xIm, float* yRe, float* yIm,
+                  const float* twRe, const float* twIm, int half, int stride);
+
+    /** Given the n-point transform Z of a 2n-sample real frame packed as
+        z[k] = x[2k] + i x[2k + 1], writes |X[k]| for k in [first, n), where
+        cosines[k] and sines[k] hold cos and sin of pi k / n. first must be >= 1. */
+    void (*magnitudes) (const float* zRe, const float* zIm, const float* cosines, const float* sines,
+                        float* magnitudes, int n, int first);
+};
+
+/** Plain C++, available everywhere. */
+const FFTKernels* getScalarFFTKernels();
+
+/** nullptr where this build wasn't made for the instruction set. They don't check
+    the CPU, which is FFTEngine's job. */
+const FFTKernels* getSSE2FFTKernels();
+const FFTKernels* getAVX2FFTKernels();
+const FFTKernels* getNEONFFTKernels();
+
+} // namespace pf
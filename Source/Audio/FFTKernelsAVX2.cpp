@@ -0,0 +1,162 @@
+#include "Audio/FFTKernels.h"
+
+// Built with AVX2 and FMA enabled (see CMakeLists.txt); see FFTKernels.h before
+// including anything else here
+#if defined (__AVX2__) && (defined (__FMA__) || defined (_MSC_VER))
+ #define PATCHFLOW_FFT_AVX2 1
+ #include <immintrin.h>
+#endif
+
+namespace pf
+{
+
+#if PATCHFLOW_FFT_AVX2
+
+namespace
+{
+
+inline void butterflyAVX2 (__m256 ar, __m256 ai, __m256 br, __m256 bi, __m256 wr, __m256 wi,
+                           __m256& sumRe, __m256& sumIm, __m256& difRe, __m256& difIm)
+{
+    const auto dr = _mm256_sub_ps (ar, br);
+    const auto di = _mm256_sub_ps (ai, bi);
+    sumRe = _mm256_add_ps (ar, br);
+    sumIm = _mm256_add_ps (ai, bi);
+    difRe = _mm256_fmsub_ps (dr, wr, _mm256_mul_ps (di, wi));
+    difIm = _mm256_fmadd_ps (dr, wi, _mm256_mul_ps (di, wr));
+}
+
+void deinterleaveAVX2 (const float* input, float* re, float* im, int count)
+{
+    int k = 0;
+    for (; k + 8 <= count; k += 8)
+    {
+        const auto lo = _mm256_loadu_ps (input + 2 * k);
+        const auto hi = _mm256_loadu_ps (input + 2 * k + 8);
+
+        // Within each 128-bit lane, then the lanes' middle quarters swapped
+        const auto even = _mm256_shuffle_ps (lo, hi, _MM_SHUFFLE (2, 0, 2, 0));
+        const auto odd  = _mm256_shuffle_ps (lo, hi, _MM_SHUFFLE (3, 1, 3, 1));
+        _mm256_storeu_ps (re + k, _mm256_castpd_ps (_mm256_permute4x64_pd (_mm256_castps_pd (even), _MM_SHUFFLE (3, 1, 2, 0))));
+        _mm256_storeu_ps (im + k, _mm256_castpd_ps (_mm256_permute4x64_pd (_mm256_castps_pd (odd),  _MM_SHUFFLE (3, 1, 2, 0))));
+    }
+
+    getSSE2FFTKernels()->deinterleave (input + 2 * k, re + k, im + k, count - k);
+}
+
+void passAVX2 (const float* xRe, const float* xIm, float* yRe, float* yIm,
+               const float* twRe, const float* twIm, int half, int stride)
+{
+    __m256 sumRe, sumIm, difRe, difIm;
+
+    if (stride >= 8)
+    {
+        // One twiddle per p, eight q at a time
+        for (int p = 0; p < half; ++p)
+        {
+            const auto wr = _mm256_broadcast_ss (twRe + p);
+            const auto wi = _mm256_broadcast_ss (twIm + p);
+            const int a = stride * p;
+            const int b = stride * (p + half);
+            const int y0 = stride * 2 * p;
+            const int y1 = y0 + stride;
+
+            for (int q = 0; q < stride; q += 8)
+            {
+                butterflyAVX2 (_mm256_loadu_ps (xRe + a + q), _mm256_loadu_ps (xIm + a + q),
+                               _mm256_loadu_ps (xRe + b + q), _mm256_loadu_ps (xIm + b + q),
+                               wr, wi, sumRe, sumIm, difRe, difIm);
+                _mm256_storeu_ps (yRe + y0 + q, sumRe);
+                _mm256_storeu_ps (yIm + y0 + q, sumIm);
+                _mm256_storeu_ps (yRe + y1 + q, difRe);
+                _mm256_storeu_ps (yIm + y1 + q, difIm);
+            }
+        }
+    }
+    else if (stride == 4 && half >= 2)
+    {
+        // Two p of four q each, one per 128-bit lane
+        for (int p = 0; p < half; p += 2)
+        {
+            const auto wr = _mm256_set_m128 (_mm_broadcast_ss (twRe + p + 1), _mm_broadcast_ss (twRe + p));
+            const auto wi = _mm256_set_m128 (_mm_broadcast_ss (twIm + p + 1), _mm_broadcast_ss (twIm + p));
+            butterflyAVX2 (_mm256_loadu_ps (xRe + 4 * p), _mm256_loadu_ps (xIm + 4 * p),
+                           _mm256_loadu_ps (xRe + 4 * (p + half)), _mm256_loadu_ps (xIm + 4 * (p + half)),
+                           wr, wi, sumRe, sumIm, difRe, difIm);
+            _mm256_storeu_ps (yRe + 8 * p,     _mm256_permute2f128_ps (sumRe, difRe, 0x20));
+            _mm256_storeu_ps (yRe + 8 * p + 8, _mm256_permute2f128_ps (sumRe, difRe, 0x31));
+            _mm256_storeu_ps (yIm + 8 * p,     _mm256_permute2f128_ps (sumIm, difIm, 0x20));
+            _mm256_storeu_ps (yIm + 8 * p + 8, _mm256_permute2f128_ps (sumIm, difIm, 0x31));
+        }
+    }
+    else if (stride == 1 && half >= 8)
+    {
+        // Eight p at a time, interleaving sums and differences on the way out
+        for (int p = 0; p < half; p += 8)
+        {
+            butterflyAVX2 (_mm256_loadu_ps (xRe + p), _mm256_loadu_ps (xIm + p),
+                           _mm256_loadu_ps (xRe + p + half), _mm256_loadu_ps (xIm + p + half),
+                           _mm256_loadu_ps (twRe + p), _mm256_loadu_ps (twIm + p), sumRe, sumIm, difRe, difIm);
+
+            const auto reLo = _mm256_unpacklo_ps (sumRe, difRe);
+            const auto reHi = _mm256_unpackhi_ps (sumRe, difRe);
+            const auto imLo = _mm256_unpacklo_ps (sumIm, difIm);
+            const auto imHi = _mm256_unpackhi_ps (sumIm, difIm);
+            _mm256_storeu_ps (yRe + 2 * p,     _mm256_permute2f128_ps (reLo, reHi, 0x20));
+            _mm256_storeu_ps (yRe + 2 * p + 8, _mm256_permute2f128_ps (reLo, reHi, 0x31));
+            _mm256_storeu_ps (yIm + 2 * p,     _mm256_permute2f128_ps (imLo, imHi, 0x20));
+            _mm256_storeu_ps (yIm + 2 * p + 8, _mm256_permute2f128_ps (imLo, imHi, 0x31));
+        }
+    }
+    else
+    {
+        getSSE2FFTKernels()->pass (xRe, xIm, yRe, yIm, twRe, twIm, half, stride);
+    }
+}
+
+void magnitudesAVX2 (const float* zRe, const float* zIm, const float* cosines, const float* sines,
+                     float* magnitudes, int n, int first)
+{
+    const auto reversed = _mm256_setr_epi32 (7, 6, 5, 4, 3, 2, 1, 0);
+    const auto halfScale = _mm256_set1_ps (0.5f);
+    int k = first;
+
+    // Z[n-k] for eight k is eight descending entries, loaded and reversed
+    for (; k + 8 <= n; k += 8)
+    {
+        const auto ar = _mm256_loadu_ps (zRe + k);
+        const auto ai = _mm256_loadu_ps (zIm + k);
+        const auto br = _mm256_permutevar8x32_ps (_mm256_loadu_ps (zRe + n - k - 7), reversed);
+        const auto bi = _mm256_permutevar8x32_ps (_mm256_loadu_ps (zIm + n - k - 7), reversed);
+
+        const auto c = _mm256_loadu_ps (cosines + k);
+        const auto s = _mm256_loadu_ps (sines + k);
+        const auto p = _mm256_add_ps (ar, br);
+        const auto q = _mm256_sub_ps (ai, bi);
+        const auto r = _mm256_add_ps (ai, bi);
+        const auto d = _mm256_sub_ps (br, ar);
+        const auto xr = _mm256_fmadd_ps (s, d, _mm256_fmadd_ps (c, r, p));
+        const auto xi = _mm256_fnmadd_ps (s, r, _mm256_fmadd_ps (c, d, q));
+        const auto power = _mm256_fmadd_ps (xi, xi, _mm256_mul_ps (xr, xr));
+        _mm256_storeu_ps (magnitudes + k, _mm256_mul_ps (halfScale, _mm256_sqrt_ps (power)));
+    }
+
+    getSSE2FFTKernels()->magnitudes (zRe, zIm, cosines, sines, magnitudes, n, k);
+}
+
+const FFTKernels avx2Kernels { deinterleaveAVX2, passAVX2, magnitudesAVX2 };
+
+} // namespace
+
+#endif
+
+const FFTKernels* getAVX2FFTKernels()
+{
+   #if PATCHFLOW_FFT_AVX2
+    return &avx2Kernels;
+   #else
+    return nullptr;
+   #endif
+}
+
+} // namespace pf
@@ -0,0 +1,234 @@
+#include "Audio/SessionRecorder.h"
+#include <cstring>
+
+namespace pf
+{
+
+SessionRecorder::SessionRecorder()
+    : juce::Thread ("PatchFlow Session Recorder")
+{
+    for (auto& channel : samples_)
+        channel.resize (static_cast<size_t> (kFifoSamples));
+}
+
+SessionRecorder::~SessionRecorder()
+{
+    stop();
+}
+
+juce::String SessionRecorder::start (const juce::File& file, double sampleRate, int blockSize, GraphModel& model)
+{
+    stop();
+
+    auto stream = std::make_unique<juce::FileOutputStream> (file);
+    if (! stream->openedOk())
+        return "can't write " + file.getFullPathName();
+
+    stream->setPosition (0);
+    stream->truncate();
+
+    stream->write ("PFTR", 4);
+    stream->writeInt (SessionTrace::kVersion);
+    stream->writeDouble (sampleRate);
+    stream->writeInt (blockSize);
+    stream->writeInt (SessionTrace::kNumChannels);
+
+    stream_ = std::move (stream);
+    sampleFifo_.reset();
+    blockFifo_.reset();
+    edits_.clear();
+    position_.store (0, std::memory_order_relaxed);
+    dropped_.store (0, std::memory_order_relaxed);
+
+    model_ = &model;
+    addEdit ({ SessionTrace::graphEdit, 0, model.toJSON(), {}, {}, {} });
+    model.addListener (this);
+
+    startThread();
+    active_.store (true);
+    return {};
+}
+
+void SessionRecorder::stop()
+{
+    if (model_ == nullptr)
+        return;
+
+    handleUpdateNowIfNeeded();
+    model_->removeListener (this);
+    model_ = nullptr;
+
+    // Let a block the audio thread is pushing land before the writer's last drain
+    // (sequentially consistent, pairing with pushBlock()'s increment-then-check)
+    active_.store (false);
+    while (pushing_.load() > 0)
+        juce::Thread::yield();
+
+    stopThread (5000);
+
+    stream_->writeByte (static_cast<char> (SessionTrace::end));
+    stream_->writeInt64 (position_.load (std::memory_order_acquire));
+    stream_->writeInt64 (dropped_.load (std::memory_order_relaxed));
+    stream_.reset();
+}
+
+//==============================================================================
+void SessionRecorder::pushBlock (const float* const* channels, int numChannels, int numSamples)
+{
+    pushing_.fetch_add (1);
+
+    if (active_.load() && numSamples > 0)
+    {
+        const auto position = position_.load (std::memory_order_relaxed);
+
+        if (sampleFifo_.getFreeSpace() >= numSamples && blockFifo_.getFreeSpace() >= 1)
+        {
+            int start1, size1, start2, size2;
+            sampleFifo_.prepareToWrite (numSamples, start1, size1, start2, size2);
+
+            for (int ch = 0; ch < SessionTrace::kNumChannels; ++ch)
+            {
+                auto* dest = samples_[static_cast<size_t> (ch)].data();
+                const float* source = ch < numChannels ? channels[ch] : nullptr;
+
+                if (source != nullptr)
+                {
+                    std::memcpy (dest + start1, source, sizeof (float) * static_cast<size_t> (size1));
+                    std::memcpy (dest + start2, source + size1, sizeof (float) * static_cast<size_t> (size2));
+                }
+                else
+                {
+                    std::memset (dest + start1, 0, sizeof (float) * static_cast<size_t> (size1));
+                    std::memset (dest + start2, 0, sizeof (float) * static_cast<size_t> (size2));
+                }
+            }
+            sampleFifo_.finishedWrite (size1 + size2);
+
+            blockFifo_.prepareToWrite (1, start1, size1, start2, size2);
+            blocks_[static_cast<size_t> (size1 > 0 ? start1 : start2)] = { position, numSamples };
+            blockFifo_.finishedWrite (1);
+        }
+        else
+        {
+            dropped_.fetch_add (numSamples, std::memory_order_relaxed);
+        }
+
+        // Published after the block, so an edit stamped with this position is never
+        // drained ahead of it
+        position_.store (position + numSamples, std::memory_order_release);
+    }
+
+    pushing_.fetch_sub (1, std::memory_order_release);
+}
+
+//==============================================================================
+void SessionRecorder::graphChanged()
+{
+    triggerAsyncUpdate();
+}
+
+void SessionRecorder::nodeParamChanged (const juce::String& nodeId, const juce::Identifier& param)
+{
+    // A param edit may depend on the structural change before it (e.g. a new node)
+    handleUpdateNowIfNeeded();
+
+    auto value = model_->getParamsTree (nodeId).getProperty (param);
+    addEdit ({ SessionTrace::paramEdit, 0, {}, nodeId, param.toString(), juce::JSON::toString (value, true) });
+}
+
+void SessionRecorder::handleAsyncUpdate()
+{
+    if (model_ != nullptr)
+        addEdit ({ SessionTrace::graphEdit, 0, model_->toJSON(), {}, {}, {} });
+}
+
+void SessionRecorder::addEdit (Edit edit)
+{
+    {
+        const juce::ScopedLock sl (editLock_);
+        edit.position = position_.load (std::memory_order_acquire);
+        edits_.push_back (std::move (edit));
+    }
+    notify();
+}
+
+//==============================================================================
+void SessionRecorder::run()
+{
+    while (! threadShouldExit())
+    {
+        wait (10);
+        drain();
+    }
+
+    drain();
+}
+
+void SessionRecorder::drain()
+{
+    // Every edit taken here was stamped after the blocks before its position were
+    // pushed, so those blocks are among the ones ready now
+    std::vector<Edit> edits;
+    int numBlocks = 0;
+    {
+        const juce::ScopedLock sl (editLock_);
+        edits.swap (edits_);
+        numBlocks = blockFifo_.getNumReady();
+    }
+
+    size_t nextEdit = 0;
+    for (int i = 0; i < numBlocks; ++i)
+    {
+        int start1, size1, start2, size2;
+        blockFifo_.prepareToRead (1, start1, size1, start2, size2);
+        auto block = blocks_[static_cast<size_t> (size1 > 0 ? start1 : start2)];
+        blockFifo_.finishedRead (1);
+
+        while (nextEdit < edits.size() && edits[nextEdit].position <= block.position)
+            writeEdit (edits[nextEdit++]);
+
+        writeBlock (block);
+    }
+
+    while (nextEdit < edits.size())
+        writeEdit (edits[nextEdit++]);
+
+    stream_->flush();
+}
+
+void SessionRecorder::writeBlock (const BlockInfo& block)
+{
+    stream_->writeByte (static_cast<char> (SessionTrace::audioBlock));
+    stream_->writeInt64 (block.position);
+    stream_->writeInt (block.numSamples);
+
+    int start1, size1, start2, size2;
+    sampleFifo_.prepareToRead (block.numSamples, start1, size1, start2, size2);
+
+    for (auto& channel : samples_)
+    {
+        stream_->write (channel.data() + start1, sizeof (float) * static_cast<size_t> (size1));
+        stream_->write (channel.data() + start2, sizeof (float) * static_cast<size_t> (size2));
+    }
+
+    sampleFifo_.finishedRead (size1 + size2);
+}
+
+void SessionRecorder::writeEdit (const Edit& edit)
+{
+    stream_->writeByte (static_cast<char> (edit.type));
+    stream_->writeInt64 (edit.position);
+
+    if (edit.type == SessionTrace::graphEdit)
+    {
+        stream_->writeString (edit.patchJson);
+    }
+    else
+    {
+        stream_->writeString (edit.nodeId);
+        stream_->writeString (edit.param);
+        stream_->writeString (edit.valueJson);
+    }
+}
+
+} // namespace pf
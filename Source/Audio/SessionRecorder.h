@@ -0,0 +1,101 @@
+#pragma once
+#include <juce_events/juce_events.h>
+#include "Audio/SessionTrace.h"
+#include "Graph/GraphModel.h"
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace pf
+{
+
+/**
+ * Records a live session into a SessionTrace file: every block of device input the
+ * engine processes, and every edit made to the GraphModel meanwhile, stamped with
+ * the input position it was made at.
+ *
+ * The audio thread only copies into preallocated FIFOs (no locks, no allocation);
+ * if the disk falls behind, whole blocks are dropped and counted. A background
+ * thread drains the FIFOs and the edit log to the file in position order.
+ *
+ * Structural edits are stored as the whole patch, serialised once per burst of
+ * changes (loading a patch changes the graph once per node and connection) and
+ * stamped when serialised; the compiler debounces them the same way live.
+ */
+class SessionRecorder : public GraphModel::Listener,
+                         private juce::AsyncUpdater,
+                         private juce::Thread
+{
+public:
+    SessionRecorder();
+    ~SessionRecorder() override;
+
+    /** Message thread: starts recording into file, beginning with the model's current
+        patch. Returns an error message, or an empty string on success. */
+    juce::String start (const juce::File& file, double sampleRate, int blockSize, GraphModel& model);
+
+    /** Message thread: stops recording and finishes the file. */
+    void stop();
+
+    bool isRecording() const { return model_ != nullptr; }
+
+    /** Samples lost so far because the writer couldn't keep up. */
+    juce::int64 getDroppedSamples() const { return dropped_.load (std::memory_order_relaxed); }
+
+    /** Audio thread: records one block of device input. Missing channels are recorded
+        as silence. Does nothing unless recording. */
+    void pushBlock (const float* const* channels, int numChannels, int numSamples);
+
+    //==============================================================================
+    // GraphModel::Listener
+    void graphChanged() override;
+    void nodeParamChanged (const juce::String& nodeId, const juce::Identifier& param) override;
+
+private:
+    struct BlockInfo
+    {
+        juce::int64 position = 0;
+        int numSamples = 0;
+    };
+
+    struct Edit
+    {
+        SessionTrace::RecordType type = SessionTrace::graphEdit;
+        juce::int64 position = 0;
+        juce::String patchJson;
+        juce::String nodeId, param, valueJson;
+    };
+
+    void handleAsyncUpdate() override;
+    void addEdit (Edit edit);
+
+    void run() override;
+    void drain();
+    void writeBlock (const BlockInfo& block);
+    void writeEdit (const Edit& edit);
+
+    static constexpr int kFifoSamples = 1 << 19;   // ~11 s at 48 kHz
+    static constexpr int kFifoBlocks = 4096;
+
+    GraphModel* model_ = nullptr;
+    std::unique_ptr<juce::FileOutputStream> stream_;
+
+    // Audio thread -> writer thread
+    juce::AbstractFifo sampleFifo_ { kFifoSamples };
+    std::array<std::vector<float>, SessionTrace::kNumChannels> samples_;
+    juce::AbstractFifo blockFifo_ { kFifoBlocks };
+    std::array<BlockInfo, kFifoBlocks> blocks_;
+
+    std::atomic<bool> active_ { false };
+    std::atomic<int> pushing_ { 0 };
+    std::atomic<juce::int64> position_ { 0 };   // input samples recorded (or dropped) so far
+    std::atomic<juce::int64> dropped_ { 0 };
+
+    // Message thread -> writer thread
+    juce::CriticalSection editLock_;
+    std::vector<Edit> edits_;
+
+    JUCE_DECLARE_NON_COPYABLE (SessionRecorder)
+};
+
+} // namespace pf
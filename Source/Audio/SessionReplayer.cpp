@@ -0,0 +1,92 @@
+#include "Audio/SessionReplayer.h"
+
+namespace pf
+{
+
+SessionReplayer::SessionReplayer (GraphModel& model, GraphCompiler& compiler, AudioEngine& engine)
+    : model_ (model), compiler_ (compiler), engine_ (engine)
+{
+}
+
+juce::String SessionReplayer::open (const juce::File& file)
+{
+    auto error = reader_.open (file);
+    if (error.isNotEmpty())
+        return error;
+
+    compiler_.setSampleRateAndBlockSize (reader_.getSampleRate(), reader_.getBlockSize());
+    droppedSamples_ = 0;
+    startMillis_ = -1.0;
+    return {};
+}
+
+bool SessionReplayer::advance()
+{
+    graphChanged_ = false;
+
+    while (reader_.readNext (record_))
+    {
+        switch (record_.type)
+        {
+            case SessionTrace::graphEdit:
+                model_.loadFromJSON (record_.patchJson);
+                graphChanged_ = true;
+                break;
+
+            case SessionTrace::paramEdit:
+                // Published straight into the live graph, unless the param needs a recompile
+                model_.setNodeParam (record_.nodeId, record_.param, record_.value);
+                break;
+
+            case SessionTrace::end:
+                droppedSamples_ = record_.droppedSamples;
+                return false;
+
+            case SessionTrace::audioBlock:
+                // Live, the compiler debounces edits; here they take effect at the
+                // block they were recorded before
+                if (compiler_.isCompilePending())
+                {
+                    compiler_.compileNow();
+                    graphChanged_ = true;
+                }
+                compiler_.collectRetiredGraphs();
+                return true;
+        }
+    }
+
+    return false;
+}
+
+void SessionReplayer::processBlock()
+{
+    const float* inputs[SessionTrace::kNumChannels];
+    for (int ch = 0; ch < SessionTrace::kNumChannels; ++ch)
+        inputs[ch] = record_.audio.getReadPointer (ch);
+
+    engine_.audioDeviceIOCallbackWithContext (inputs, SessionTrace::kNumChannels, nullptr, 0,
+                                              record_.numSamples, juce::AudioIODeviceCallbackContext {});
+}
+
+bool SessionReplayer::processNextBlock (bool realtime)
+{
+    if (! advance())
+        return false;
+
+    if (realtime)
+    {
+        const auto now = juce::Time::getMillisecondCounterHiRes();
+        const auto blockTime = 1000.0 * static_cast<double> (record_.position) / reader_.getSampleRate();
+        if (startMillis_ < 0.0)
+            startMillis_ = now - blockTime;
+
+        const auto wait = startMillis_ + blockTime - now;
+        if (wait >= 1.0)
+            juce::Thread::sleep (static_cast<int> (wait));
+    }
+
+    processBlock();
+    return true;
+}
+
+} // namespace pf
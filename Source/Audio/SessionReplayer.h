@@ -0,0 +1,66 @@
+#pragma once
+#include "Audio/SessionTrace.h"
+#include "Audio/AudioEngine.h"
+#include "Graph/GraphModel.h"
+#include "Graph/GraphCompiler.h"
+
+namespace pf
+{
+
+/**
+ * Plays a SessionTrace back through an AudioEngine with no audio device: the
+ * recorded edits are applied to the model at the positions they were made at,
+ * compiled on the calling thread, and the recorded input is fed to the engine's
+ * callback block by block, as the device delivered it.
+ *
+ * Every step runs on the calling thread in trace order, so a replay is
+ * deterministic. The engine must take its graphs from the compiler (see
+ * AudioEngine::setGraphSource) and not be running a device.
+ */
+class SessionReplayer
+{
+public:
+    SessionReplayer (GraphModel& model, GraphCompiler& compiler, AudioEngine& engine);
+
+    /** Opens a trace and sets the compiler to its sample rate and block size.
+        Returns an error message, or an empty string on success. */
+    juce::String open (const juce::File& file);
+
+    double getSampleRate() const { return reader_.getSampleRate(); }
+    int getBlockSize() const { return reader_.getBlockSize(); }
+
+    /** Applies the edits recorded before the next block and compiles them. Returns
+        false at the end of the trace. */
+    bool advance();
+
+    /** Runs the block advance() stopped at through the engine. */
+    void processBlock();
+
+    /** advance() and processBlock(), waiting first until the block's recorded time
+        if realtime is set (otherwise running as fast as possible). */
+    bool processNextBlock (bool realtime);
+
+    /** Input position of the block advance() stopped at. */
+    juce::int64 getPosition() const { return record_.position; }
+    int getNumSamples() const { return record_.numSamples; }
+
+    /** Samples the recorder dropped, known once the end of the trace is reached. */
+    juce::int64 getDroppedSamples() const { return droppedSamples_; }
+
+    /** True when the last advance() changed the patch structurally. */
+    bool graphChanged() const { return graphChanged_; }
+
+private:
+    GraphModel& model_;
+    GraphCompiler& compiler_;
+    AudioEngine& engine_;
+
+    SessionTrace::Reader reader_;
+    SessionTrace::Record record_;
+    juce::int64 droppedSamples_ = 0;
+    bool graphChanged_ = false;
+
+    double startMillis_ = -1.0;   // realtime: when position 0 was (or would have been) due
+};
+
+} // namespace pf
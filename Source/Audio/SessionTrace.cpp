@@ -0,0 +1,78 @@
+#include "Audio/SessionTrace.h"
+#include <cstring>
+
+namespace pf
+{
+
+namespace SessionTrace
+{
+
+juce::String Reader::open (const juce::File& file)
+{
+    stream_ = std::make_unique<juce::FileInputStream> (file);
+    if (! stream_->openedOk())
+        return "can't open " + file.getFullPathName();
+
+    char magic[4] = {};
+    if (stream_->read (magic, 4) != 4 || std::memcmp (magic, "PFTR", 4) != 0)
+        return file.getFileName() + " is not a session trace";
+
+    auto version = stream_->readInt();
+    if (version != kVersion)
+        return "unsupported trace version " + juce::String (version);
+
+    sampleRate_ = stream_->readDouble();
+    blockSize_ = stream_->readInt();
+    numChannels_ = stream_->readInt();
+
+    if (sampleRate_ <= 0.0 || blockSize_ <= 0 || numChannels_ != kNumChannels)
+        return file.getFileName() + " has a corrupt header";
+
+    return {};
+}
+
+bool Reader::readNext (Record& record)
+{
+    if (stream_ == nullptr || stream_->isExhausted())
+        return false;
+
+    record.type = static_cast<RecordType> (stream_->readByte());
+    record.position = stream_->readInt64();
+
+    switch (record.type)
+    {
+        case audioBlock:
+        {
+            record.numSamples = stream_->readInt();
+            if (record.numSamples <= 0)
+                return false;
+
+            record.audio.setSize (numChannels_, record.numSamples, false, false, true);
+            const auto bytes = static_cast<int> (sizeof (float)) * record.numSamples;
+            for (int ch = 0; ch < numChannels_; ++ch)
+                if (stream_->read (record.audio.getWritePointer (ch), bytes) != bytes)
+                    return false;
+            return true;
+        }
+
+        case graphEdit:
+            record.patchJson = stream_->readString();
+            return true;
+
+        case paramEdit:
+            record.nodeId = stream_->readString();
+            record.param = stream_->readString();
+            record.value = juce::JSON::parse (stream_->readString());
+            return true;
+
+        case end:
+            record.droppedSamples = stream_->readInt64();
+            return true;
+    }
+
+    return false;   // unknown record type: corrupt or from a newer version
+}
+
+} // namespace SessionTrace
+
+} // namespace pf
@@ -0,0 +1,73 @@
+#pragma once
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <memory>
+
+namespace pf
+{
+
+/**
+ * Binary trace of a live session: the device input blocks the engine processed and
+ * the patch edits made meanwhile, each stamped with the input sample position it
+ * took effect at. Written by SessionRecorder, read back by SessionReplayer.
+ *
+ * Layout (little-endian):
+ *
+ *   header   "PFTR", int32 version, double sampleRate, int32 blockSize, int32 numChannels
+ *   record   uint8 type, int64 position, then by type:
+ *              'A' audio   int32 numSamples, numChannels × numSamples float32 (channel by channel)
+ *              'G' graph   string patch JSON (the whole patch, after a structural edit)
+ *              'P' param   string nodeId, string param name, string value as JSON
+ *              'E' end     int64 samples dropped while recording (disk too slow)
+ *
+ * Records are in position order, edits before the block they precede.
+ */
+namespace SessionTrace
+{
+    static constexpr int kVersion = 1;
+    static constexpr int kNumChannels = 2;
+
+    enum RecordType : juce::uint8
+    {
+        audioBlock = 'A',
+        graphEdit  = 'G',
+        paramEdit  = 'P',
+        end        = 'E'
+    };
+
+    struct Record
+    {
+        RecordType type = end;
+        juce::int64 position = 0;
+
+        juce::AudioBuffer<float> audio;   // audioBlock: kNumChannels × numSamples
+        int numSamples = 0;
+
+        juce::String patchJson;           // graphEdit
+        juce::String nodeId, param;       // paramEdit
+        juce::var value;
+
+        juce::int64 droppedSamples = 0;   // end
+    };
+
+    class Reader
+    {
+    public:
+        /** Returns an error message, or an empty string on success. */
+        juce::String open (const juce::File& file);
+
+        double getSampleRate() const { return sampleRate_; }
+        int getBlockSize() const { return blockSize_; }
+
+        /** Reads the next record into record (reusing its audio buffer). Returns false
+            at the end of the trace, or if it is truncated. */
+        bool readNext (Record& record);
+
+    private:
+        std::unique_ptr<juce::FileInputStream> stream_;
+        double sampleRate_ = 0.0;
+        int blockSize_ = 0;
+        int numChannels_ = kNumChannels;
+    };
+}
+
+} // namespace pf
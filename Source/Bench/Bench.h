@@ -0,0 +1,75 @@
+#pragma once
+#include <juce_opengl/juce_opengl.h>
+#include <functional>
+#include <vector>
+
+namespace pf
+{
+
+/**
+ * Shared pieces of the PatchFlowBench suites.
+ *
+ * Every suite appends BenchResults: one per measured configuration, holding the
+ * distribution of per-iteration times in microseconds. BenchMain prints them as a
+ * table and, with --json, writes them out for regression checks; a result is
+ * identified by suite, name and config, which stay stable between runs.
+ */
+struct BenchOptions
+{
+    juce::String filter;          // only subjects whose name contains this
+    juce::File patchesDir;        // example patches for the "patch" suite
+    std::vector<int> graphSizes;  // node counts for the "compile" suite
+    juce::File trace;             // session trace for the "trace" suite
+    bool quick = false;           // fewer iterations and configurations, for smoke runs
+
+    bool matches (const juce::String& name) const
+    {
+        return filter.isEmpty() || name.containsIgnoreCase (filter);
+    }
+
+    int iterations (int full) const { return quick ? juce::jmax (1, full / 10) : full; }
+};
+
+struct BenchResult
+{
+    juce::String suite;           // "audio", "fft", "visual", "patch", "compile" or "trace"
+    juce::String name;            // node type, FFT backend, patch or trace file, or compile phase
+    juce::NamedValueSet config;   // e.g. blockSize, fftOrder, width, height
+
+    double median = 0.0, mean = 0.0, min = 0.0, p99 = 0.0;   // microseconds
+    int iterations = 0;
+
+    /** Fills the statistics from per-iteration times in microseconds. */
+    void setSamples (std::vector<double> micros);
+
+    juce::var toVar() const;
+};
+
+/** Runs fn warmup times untimed, then times each of iterations runs, in microseconds. */
+std::vector<double> timeIterations (int warmup, int iterations, const std::function<void()>& fn);
+
+//==============================================================================
+// Suites
+
+/** processBlock() of every non-visual node type, over block sizes and FFT orders. */
+void runAudioNodeBench (const BenchOptions& options, std::vector<BenchResult>& results);
+
+/** FFTEngine::computeMagnitudes() on every backend this machine has, JUCE's
+    included, over the FFT orders; each is checked against JUCE's output first. */
+void runFFTBench (const BenchOptions& options, std::vector<BenchResult>& results);
+
+/** renderFrame() of every visual node type at several resolutions. Needs a current
+    offscreen context; gl is only used to reach the GL functions. */
+void runVisualNodeBench (const BenchOptions& options, juce::OpenGLContext& gl, std::vector<BenchResult>& results);
+
+/** Audio blocks and (with gl) visual frames of every patch in options.patchesDir. */
+void runPatchBench (const BenchOptions& options, juce::OpenGLContext* gl, std::vector<BenchResult>& results);
+
+/** Cold, warm and edit compiles of generated patches of options.graphSizes nodes. */
+void runCompileBench (const BenchOptions& options, std::vector<BenchResult>& results);
+
+/** Replays options.trace at full speed: the engine callback of every recorded block
+    and (with gl) the visual frames due during it, at 60 fps of trace time. */
+void runTraceBench (const BenchOptions& options, juce::OpenGLContext* gl, std::vector<BenchResult>& results);
+
+} // namespace pf
@@ -0,0 +1,211 @@
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "Bench/Bench.h"
+#include "Rendering/GLResourceRegistry.h"
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+
+#if PATCHFLOW_BENCH_GL
+ #include "Render/OffscreenGLContext.h"
+#endif
+
+/**
+ * PatchFlow's benchmark suites.
+ *
+ *   PatchFlowBench [--suite=audio,fft,visual,patch,compile,trace] [--filter=<text>]
+ *                  [--json=<file>] [--patches=<dir>] [--nodes=<n>] [--trace=<file>] [--quick]
+ *
+ *   audio    processBlock() of every non-visual node type, block sizes 64-4096,
+ *            every FFT order for nodes that have one
+ *   fft      the FFT engine's magnitude spectrum on every backend the machine has
+ *            (JUCE's, and the in-tree scalar/SSE2/AVX2/NEON kernels), orders 9-13
+ *   visual   renderFrame() of every visual node type, 256x256 to 1920x1080, timed
+ *            to completion on the GPU (offscreen EGL context, Linux only)
+ *   patch    audio blocks and visual frames of each example patch
+ *            (Resources/ExamplePatches, or --patches)
+ *   compile  cold, warm and edit compiles of generated patches (500 to 8000 nodes,
+ *            or --nodes)
+ *   trace    engine callbacks and visual frames of a recorded session
+ *            (File > Record Session... in the app), replayed deterministically
+ *
+ * All suites run by default, trace only when --trace names one. Results are
+ * printed as a table; --json also writes them with the machine's description,
+ * for comparison against a baseline.
+ */
+namespace pf
+{
+
+std::vector<double> timeIterations (int warmup, int iterations, const std::function<void()>& fn)
+{
+    for (int i = 0; i < warmup; ++i)
+        fn();
+
+    std::vector<double> micros;
+    micros.reserve (static_cast<size_t> (iterations));
+    for (int i = 0; i < iterations; ++i)
+    {
+        auto start = juce::Time::getHighResolutionTicks();
+        fn();
+        auto elapsed = juce::Time::getHighResolutionTicks() - start;
+        micros.push_back (juce::Time::highResolutionTicksToSeconds (elapsed) * 1.0e6);
+    }
+    return micros;
+}
+
+void BenchResult::setSamples (std::vector<double> micros)
+{
+    iterations = static_cast<int> (micros.size());
+    if (micros.empty())
+        return;
+
+    std::sort (micros.begin(), micros.end());
+    min = micros.front();
+    median = micros[micros.size() / 2];
+    p99 = micros[(micros.size() * 99) / 100];
+    mean = std::accumulate (micros.begin(), micros.end(), 0.0) / static_cast<double> (micros.size());
+}
+
+juce::var BenchResult::toVar() const
+{
+    auto* configObject = new juce::DynamicObject();
+    for (auto& property : config)
+        configObject->setProperty (property.name, property.value);
+
+    auto* object = new juce::DynamicObject();
+    object->setProperty ("suite", suite);
+    object->setProperty ("name", name);
+    object->setProperty ("config", juce::var (configObject));
+    object->setProperty ("unit", "us");
+    object->setProperty ("median", median);
+    object->setProperty ("mean", mean);
+    object->setProperty ("min", min);
+    object->setProperty ("p99", p99);
+    object->setProperty ("iterations", iterations);
+    return juce::var (object);
+}
+
+} // namespace pf
+
+//==============================================================================
+namespace
+{
+
+juce::String describeConfig (const juce::NamedValueSet& config)
+{
+    juce::StringArray parts;
+    for (auto& property : config)
+        parts.add (property.name.toString() + "=" + property.value.toString());
+    return parts.joinIntoString (" ");
+}
+
+void printResult (const pf::BenchResult& result)
+{
+    std::printf ("%-8s %-26s %-30s median %10.2f us  p99 %10.2f us  (%d runs)\n",
+                 result.suite.toRawUTF8(), result.name.toRawUTF8(), describeConfig (result.config).toRawUTF8(),
+                 result.median, result.p99, result.iterations);
+    std::fflush (stdout);
+}
+
+bool writeJson (const juce::File& file, const std::vector<pf::BenchResult>& results, const juce::String& renderer)
+{
+    auto* machine = new juce::DynamicObject();
+    machine->setProperty ("os", juce::SystemStats::getOperatingSystemName());
+    machine->setProperty ("cpu", juce::SystemStats::getCpuModel());
+    machine->setProperty ("cores", juce::SystemStats::getNumCpus());
+    machine->setProperty ("glRenderer", renderer);
+
+    juce::Array<juce::var> entries;
+    for (auto& result : results)
+        entries.add (result.toVar());
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty ("schemaVersion", 1);
+    root->setProperty ("date", juce::Time::getCurrentTime().toISO8601 (true));
+    root->setProperty ("machine", juce::var (machine));
+    root->setProperty ("results", entries);
+
+    return file.replaceWithText (juce::JSON::toString (juce::var (root)));
+}
+
+} // namespace
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+    juce::ArgumentList args (argc, argv);
+
+    pf::BenchOptions options;
+    options.filter = args.getValueForOption ("--filter");
+    options.quick = args.containsOption ("--quick");
+
+    options.patchesDir = args.containsOption ("--patches")
+                             ? juce::File::getCurrentWorkingDirectory().getChildFile (args.getValueForOption ("--patches"))
+                             : juce::File (PATCHFLOW_EXAMPLE_PATCHES_DIR);
+
+    if (args.containsOption ("--nodes"))
+        options.graphSizes = { juce::jmax (11, args.getValueForOption ("--nodes").getIntValue()) };
+    else
+        options.graphSizes = options.quick ? std::vector<int> { 500 } : std::vector<int> { 500, 2000, 8000 };
+
+    if (args.containsOption ("--trace"))
+        options.trace = juce::File::getCurrentWorkingDirectory().getChildFile (args.getValueForOption ("--trace"));
+
+    auto suites = juce::StringArray::fromTokens (args.containsOption ("--suite") ? args.getValueForOption ("--suite")
+                                                                                 : "audio,fft,visual,patch,compile", ",", {});
+    if (options.trace != juce::File {} && ! args.containsOption ("--suite"))
+        suites.add ("trace");
+
+    std::unique_ptr<juce::OpenGLContext> gl;
+    juce::String renderer;
+
+   #if PATCHFLOW_BENCH_GL
+    pf::OffscreenGLContext context;
+    if (suites.contains ("visual") || suites.contains ("patch") || suites.contains ("trace"))
+    {
+        auto error = context.create();
+        if (error.isEmpty())
+        {
+            gl = std::make_unique<juce::OpenGLContext>();   // never attached, see OffscreenGLContext
+            renderer = pf::OffscreenGLContext::getRendererName();
+        }
+        else
+        {
+            std::fprintf (stderr, "no offscreen OpenGL context (%s), skipping visual benchmarks\n", error.toRawUTF8());
+        }
+    }
+   #endif
+
+    std::vector<pf::BenchResult> results;
+    auto runSuite = [&] (const char* name, auto&& run)
+    {
+        if (! suites.contains (name))
+            return;
+
+        auto first = results.size();
+        run();
+        for (auto i = first; i < results.size(); ++i)
+            printResult (results[i]);
+    };
+
+    runSuite ("audio",   [&] { pf::runAudioNodeBench (options, results); });
+    runSuite ("fft",     [&] { pf::runFFTBench (options, results); });
+    runSuite ("visual",  [&] { if (gl != nullptr) pf::runVisualNodeBench (options, *gl, results); });
+    runSuite ("patch",   [&] { pf::runPatchBench (options, gl.get(), results); });
+    runSuite ("compile", [&] { pf::runCompileBench (options, results); });
+    runSuite ("trace",   [&] { if (options.trace != juce::File {}) pf::runTraceBench (options, gl.get(), results); });
+
+    if (gl != nullptr)
+        pf::GLResourceRegistry::instance().processPendingReleases (*gl);
+
+    if (args.containsOption ("--json"))
+    {
+        auto file = juce::File::getCurrentWorkingDirectory().getChildFile (args.getValueForOption ("--json"));
+        if (! writeJson (file, results, renderer))
+        {
+            std::fprintf (stderr, "can't write %s\n", file.getFullPathName().toRawUTF8());
+            return 1;
+        }
+    }
+
+    return 0;
+}
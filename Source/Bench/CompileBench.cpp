@@ -0,0 +1,140 @@
+#include "Bench/Bench.h"
+#include "Graph/GraphModel.h"
+#include "Graph/GraphCompiler.h"
+#include <algorithm>
+#include <cstdio>
+
+/**
+ * Times GraphCompiler on generated patches.
+ *
+ * The patch is built from lanes of nine nodes: an envelope follower on the audio
+ * input feeds a chain of control nodes (cross-linked with the previous lane), which
+ * drives a Gradient that is blended into a chain ending at the Output Canvas. So
+ * every node is live, every control chain fuses, and every lane has a bridged
+ * Signal→Visual edge.
+ *
+ * Reported per compile:
+ *   cold  - first build, every node instance created and prepared
+ *   warm  - rebuild of an unchanged patch, every instance reused
+ *   edit  - rebuild after rewiring one input, as when patching
+ */
+namespace
+{
+
+/** The edit step rewires one lane's multiply.b from its MapRange to its Clamp. */
+struct Patch
+{
+    juce::String multiply;
+    juce::String range;
+    juce::String clamp;
+};
+
+Patch generatePatch (pf::GraphModel& model, int numNodes)
+{
+    constexpr int kLaneSize = 9;
+    const int numLanes = std::max (1, (numNodes - 2) / kLaneSize);
+
+    auto connect = [&] (const juce::String& src, int srcPort, const juce::String& dst, int dstPort)
+    {
+        model.addConnection ({ src, srcPort, dst, dstPort });
+    };
+
+    auto input = model.addNode ("AudioInput", 0.f, 0.f);
+    auto canvas = model.addNode ("OutputCanvas", 0.f, 0.f);
+
+    Patch patch;
+    juce::String previousSmoothing, previousBlend;
+
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        auto y = static_cast<float> (lane) * 100.f;
+        auto envelope  = model.addNode ("EnvelopeFollower", 100.f, y);
+        auto range     = model.addNode ("MapRange",         200.f, y);
+        auto smoothing = model.addNode ("Smoothing",        300.f, y);
+        auto add       = model.addNode ("Add",              400.f, y);
+        auto clamp     = model.addNode ("Clamp",            500.f, y);
+        auto multiply  = model.addNode ("Multiply",         600.f, y);
+        auto scale     = model.addNode ("MapRange",         700.f, y);
+        auto gradient  = model.addNode ("Gradient",         800.f, y);
+        auto blend     = model.addNode ("Blend",            900.f, y);
+
+        connect (input, 0, envelope, 0);
+        connect (input, 1, envelope, 1);
+        connect (envelope, 0, range, 0);
+        connect (range, 0, smoothing, 0);
+        connect (smoothing, 0, add, 0);
+        connect (previousSmoothing.isEmpty() ? range : previousSmoothing, 0, add, 1);
+        connect (add, 0, clamp, 0);
+        connect (clamp, 0, multiply, 0);
+        connect (range, 0, multiply, 1);
+        connect (multiply, 0, scale, 0);
+        connect (scale, 0, gradient, 0);
+
+        connect (previousBlend.isEmpty() ? gradient : previousBlend, 0, blend, 0);
+        connect (gradient, 0, blend, 1);
+        connect (clamp, 0, blend, 2);
+
+        if (lane == numLanes / 2)
+            patch = { multiply, range, clamp };
+
+        previousSmoothing = smoothing;
+        previousBlend = blend;
+    }
+
+    connect (previousBlend, 0, canvas, 0);
+    model.getUndoManager().clearUndoHistory();
+    return patch;
+}
+
+/** Microseconds taken by one synchronous compile. */
+double timeCompile (pf::GraphCompiler& compiler)
+{
+    auto start = juce::Time::getHighResolutionTicks();
+    if (! compiler.compileNow())
+        std::fprintf (stderr, "compile failed: %s\n", compiler.getErrorMessage().toRawUTF8());
+    auto elapsed = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start);
+
+    compiler.collectRetiredGraphs();
+    return elapsed * 1.0e6;
+}
+
+} // namespace
+
+//==============================================================================
+namespace pf
+{
+
+void runCompileBench (const BenchOptions& options, std::vector<BenchResult>& results)
+{
+    for (auto numNodes : options.graphSizes)
+    {
+        const auto iterations = options.iterations (20);
+        std::vector<double> cold, warm, edit;
+
+        for (int i = 0; i < iterations; ++i)
+        {
+            GraphModel model;
+            auto patch = generatePatch (model, numNodes);
+
+            GraphCompiler compiler (model);
+            cold.push_back (timeCompile (compiler));
+            warm.push_back (timeCompile (compiler));
+
+            model.removeConnection ({ patch.range, 0, patch.multiply, 1 });
+            model.addConnection ({ patch.clamp, 0, patch.multiply, 1 });
+            edit.push_back (timeCompile (compiler));
+        }
+
+        for (auto* phase : { &cold, &warm, &edit })
+        {
+            BenchResult result;
+            result.suite = "compile";
+            result.name = phase == &cold ? "cold" : phase == &warm ? "warm" : "edit";
+            result.config.set ("nodes", numNodes);
+            result.setSamples (*phase);
+            results.push_back (std::move (result));
+        }
+    }
+}
+
+} // namespace pf
@@ -0,0 +1,56 @@
+#include "Bench/Bench.h"
+#include "Audio/FFTEngine.h"
+#include <cmath>
+#include <cstdio>
+
+namespace pf
+{
+
+void runFFTBench (const BenchOptions& options, std::vector<BenchResult>& results)
+{
+    const auto orders = options.quick ? std::vector<int> { 11 } : std::vector<int> { 9, 10, 11, 12, 13 };
+
+    for (int order : orders)
+    {
+        const auto size = static_cast<size_t> (1 << order);
+
+        juce::Random random (1234);
+        std::vector<float> frame (size);
+        for (auto& sample : frame)
+            sample = random.nextFloat() * 2.f - 1.f;
+
+        std::vector<float> reference (size / 2), magnitudes (size / 2);
+        FFTEngine::create (order, FFTEngine::Backend::juce)->computeMagnitudes (frame.data(), reference.data());
+
+        for (auto backend : FFTEngine::getAvailableBackends())
+        {
+            const juce::String name = FFTEngine::getBackendName (backend);
+            if (! options.matches (name))
+                continue;
+
+            auto engine = FFTEngine::create (order, backend);
+            engine->computeMagnitudes (frame.data(), magnitudes.data());
+
+            // Every backend must agree with JUCE's to float precision
+            float error = 0.f, peak = 0.f;
+            for (size_t k = 0; k < reference.size(); ++k)
+            {
+                error = juce::jmax (error, std::abs (magnitudes[k] - reference[k]));
+                peak = juce::jmax (peak, reference[k]);
+            }
+            if (error > 1.0e-5f * peak)
+                std::fprintf (stderr, "fft %s, order %d: off by %g (peak %g)\n", name.toRawUTF8(), order, error, peak);
+
+            BenchResult result;
+            result.suite = "fft";
+            result.name = name;
+            result.config.set ("fftOrder", order);
+            result.config.set ("default", backend == FFTEngine::getDefaultBackend());
+            result.setSamples (timeIterations (20, options.iterations (2000),
+                                               [&] { engine->computeMagnitudes (frame.data(), magnitudes.data()); }));
+            results.push_back (std::move (result));
+        }
+    }
+}
+
+} // namespace pf
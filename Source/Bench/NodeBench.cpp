@@ -0,0 +1,267 @@
+#include "Bench/Bench.h"
+#include "Nodes/NodeRegistry.h"
+#include "Rendering/GLResourceRegistry.h"
+#include "Rendering/RenderConfig.h"
+#include <algorithm>
+#include <memory>
+
+namespace pf
+{
+
+namespace
+{
+
+/** Stands in for upstream nodes: noise on Audio and Buffer outputs, a mid-range
+    value on Signal and Visual outputs, and a noise texture. */
+class BenchSource : public NodeBase
+{
+public:
+    enum Output : int { audio, signal, buffer, visual, texture };
+
+    BenchSource()
+    {
+        addOutput ("audio",   PortType::Audio);
+        addOutput ("signal",  PortType::Signal);
+        addOutput ("buffer",  PortType::Buffer);
+        addOutput ("visual",  PortType::Visual);
+        addOutput ("texture", PortType::Texture);
+    }
+
+    juce::String getTypeId()      const override { return "BenchSource"; }
+    juce::String getDisplayName() const override { return "Bench Source"; }
+    juce::String getCategory()    const override { return "Bench"; }
+
+    void fill (int blockSize, int bufferSize)
+    {
+        juce::Random random (1234);
+        audio_.resize (static_cast<size_t> (blockSize));
+        for (auto& sample : audio_)
+            sample = random.nextFloat() * 2.f - 1.f;
+
+        buffer_.resize (static_cast<size_t> (bufferSize));
+        for (auto& bin : buffer_)
+            bin = random.nextFloat();
+
+        bindOutputs ({ audio_.data() }, { std::span<float> (buffer_) });
+        setSignalOutputValue (0, 0.5f);
+        setVisualOutputValue (0, 0.5f);
+    }
+
+    static int outputFor (PortType type)
+    {
+        switch (type)
+        {
+            case PortType::Audio:   return audio;
+            case PortType::Signal:  return signal;
+            case PortType::Buffer:  return buffer;
+            case PortType::Visual:  return visual;
+            case PortType::Texture: return texture;
+        }
+        return signal;
+    }
+
+private:
+    std::vector<float> audio_;
+    std::vector<float> buffer_;
+};
+
+/** A node under test with the storage the compiler would otherwise provide. */
+struct NodeHarness
+{
+    std::unique_ptr<NodeBase> node;
+    ParamStore params;
+    std::vector<std::vector<float>> audioStorage;
+    std::vector<std::vector<float>> bufferStorage;
+
+    NodeHarness (const juce::String& typeId, BenchSource& source)
+        : node (NodeRegistry::instance().createNode (typeId))
+    {
+        auto& declared = node->getParams();
+        params.allocate (static_cast<int> (declared.size()));
+        for (size_t i = 0; i < declared.size(); ++i)
+            params.storeVar (static_cast<int> (i), declared[i].defaultValue);
+        node->bindParams (&params, 0);
+
+        for (auto& input : node->getInputs())
+            node->setInputConnection (input.index, &source, BenchSource::outputFor (input.type));
+    }
+
+    void setParam (const juce::String& name, const juce::var& value)
+    {
+        auto& declared = node->getParams();
+        for (size_t i = 0; i < declared.size(); ++i)
+            if (declared[i].name == name)
+                params.storeVar (static_cast<int> (i), value);
+    }
+
+    /** Prepares the node and binds arena-like storage for its outputs. */
+    void prepare (double sampleRate, int blockSize)
+    {
+        node->prepareToPlay (sampleRate, blockSize);
+
+        std::vector<float*> audio;
+        std::vector<std::span<float>> buffers;
+        int bufferIndex = 0;
+        for (auto& output : node->getOutputs())
+        {
+            if (output.type == PortType::Audio)
+                audio.push_back (audioStorage.emplace_back (static_cast<size_t> (blockSize)).data());
+            else if (output.type == PortType::Buffer)
+                buffers.push_back (bufferStorage.emplace_back (static_cast<size_t> (node->getBufferOutputSize (bufferIndex++))));
+        }
+
+        node->bindOutputs (audio, buffers);
+    }
+};
+
+std::vector<NodeRegistry::NodeInfo> getSortedNodeTypes()
+{
+    auto types = NodeRegistry::instance().getAllNodeTypes();
+    std::sort (types.begin(), types.end(), [] (auto& a, auto& b) { return a.typeId < b.typeId; });
+    return types;
+}
+
+/** The values of an int param's range, or a single invalid entry if the node has none. */
+std::vector<int> getParamRange (const NodeBase& node, const juce::String& name, bool quick)
+{
+    for (auto& param : node.getParams())
+    {
+        if (param.name != name)
+            continue;
+
+        if (quick)
+            return { static_cast<int> (param.defaultValue) };
+
+        std::vector<int> values;
+        for (int value = static_cast<int> (param.minValue); value <= static_cast<int> (param.maxValue); ++value)
+            values.push_back (value);
+        return values;
+    }
+
+    return { -1 };
+}
+
+juce::uint32 createNoiseTexture (int width, int height)
+{
+    using namespace juce::gl;
+
+    juce::Random random (1234);
+    std::vector<juce::uint8> pixels (static_cast<size_t> (width) * static_cast<size_t> (height) * 4);
+    for (auto& channel : pixels)
+        channel = static_cast<juce::uint8> (random.nextInt (256));
+
+    GLuint texture = 0;
+    glGenTextures (1, &texture);
+    glBindTexture (GL_TEXTURE_2D, texture);
+    glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D (GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    glBindTexture (GL_TEXTURE_2D, 0);
+    return texture;
+}
+
+} // namespace
+
+//==============================================================================
+void runAudioNodeBench (const BenchOptions& options, std::vector<BenchResult>& results)
+{
+    constexpr double kSampleRate = 48000.0;
+    const std::vector<int> blockSizes = options.quick ? std::vector<int> { 512 }
+                                                      : std::vector<int> { 64, 128, 256, 512, 1024, 2048, 4096 };
+
+    BenchSource source;
+
+    for (auto& type : getSortedNodeTypes())
+    {
+        if (! options.matches (type.typeId))
+            continue;
+
+        auto prototype = NodeRegistry::instance().createNode (type.typeId);
+        if (prototype->isVisualNode())
+            continue;
+
+        for (auto fftOrder : getParamRange (*prototype, "fftOrder", options.quick))
+        {
+            for (auto blockSize : blockSizes)
+            {
+                source.fill (blockSize, 1024);
+
+                NodeHarness harness (type.typeId, source);
+                if (fftOrder >= 0)
+                    harness.setParam ("fftOrder", fftOrder);
+                harness.prepare (kSampleRate, blockSize);
+
+                // About a second of audio per configuration
+                const auto iterations = options.iterations (juce::jlimit (50, 5000, static_cast<int> (kSampleRate) / blockSize));
+
+                BenchResult result;
+                result.suite = "audio";
+                result.name = type.typeId;
+                result.config.set ("blockSize", blockSize);
+                if (fftOrder >= 0)
+                    result.config.set ("fftOrder", fftOrder);
+
+                result.setSamples (timeIterations (iterations / 10, iterations,
+                                                   [&] { harness.node->processBlock (blockSize); }));
+                results.push_back (std::move (result));
+            }
+        }
+    }
+}
+
+void runVisualNodeBench (const BenchOptions& options, juce::OpenGLContext& gl, std::vector<BenchResult>& results)
+{
+    struct Resolution { int width, height; };
+    const std::vector<Resolution> resolutions = options.quick ? std::vector<Resolution> { { 512, 512 } }
+                                                              : std::vector<Resolution> { { 256, 256 }, { 512, 512 },
+                                                                                          { 1280, 720 }, { 1920, 1080 } };
+
+    const auto defaultWidth = RenderConfig::getWidth();
+    const auto defaultHeight = RenderConfig::getHeight();
+
+    BenchSource source;
+    source.fill (512, 1024);
+
+    for (auto& type : getSortedNodeTypes())
+    {
+        if (! options.matches (type.typeId))
+            continue;
+
+        if (! NodeRegistry::instance().createNode (type.typeId)->isVisualNode())
+            continue;
+
+        for (auto [width, height] : resolutions)
+        {
+            RenderConfig::setResolution (width, height);
+            auto texture = createNoiseTexture (width, height);
+            source.setTextureOutput (BenchSource::texture, texture);
+
+            {
+                NodeHarness harness (type.typeId, source);
+                harness.prepare (48000.0, 512);
+
+                BenchResult result;
+                result.suite = "visual";
+                result.name = type.typeId;
+                result.config.set ("width", width);
+                result.config.set ("height", height);
+
+                // Waiting for the GPU makes each sample the frame's real cost; the
+                // warmup frames compile shaders and allocate targets
+                result.setSamples (timeIterations (5, options.iterations (120), [&]
+                {
+                    harness.node->renderFrame (gl);
+                    juce::gl::glFinish();
+                }));
+                results.push_back (std::move (result));
+            }
+
+            GLResourceRegistry::instance().processPendingReleases (gl);
+            juce::gl::glDeleteTextures (1, &texture);
+        }
+    }
+
+    RenderConfig::setResolution (defaultWidth, defaultHeight);
+}
+
+} // namespace pf
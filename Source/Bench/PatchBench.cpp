@@ -0,0 +1,95 @@
+#include "Bench/Bench.h"
+#include "Graph/GraphModel.h"
+#include "Graph/GraphCompiler.h"
+#include "Rendering/GLResourceRegistry.h"
+#include "Rendering/RenderConfig.h"
+#include <cstdio>
+#include <cstring>
+
+namespace pf
+{
+
+void runPatchBench (const BenchOptions& options, juce::OpenGLContext* gl, std::vector<BenchResult>& results)
+{
+    constexpr double kSampleRate = 48000.0;
+    constexpr int kBlockSize = 512;
+
+    auto files = options.patchesDir.findChildFiles (juce::File::findFiles, false, "*.json");
+    files.sort();
+
+    // One block of noise stands in for the device input
+    juce::Random random (1234);
+    std::vector<float> noise (kBlockSize);
+    for (auto& sample : noise)
+        sample = random.nextFloat() * 2.f - 1.f;
+
+    for (auto& file : files)
+    {
+        if (! options.matches (file.getFileName()))
+            continue;
+
+        {
+            GraphModel model;
+            if (! model.loadFromJSON (file.loadFileAsString()))
+            {
+                std::fprintf (stderr, "can't load %s\n", file.getFullPathName().toRawUTF8());
+                continue;
+            }
+
+            GraphCompiler compiler (model);
+            compiler.setSampleRateAndBlockSize (kSampleRate, kBlockSize);
+            if (! compiler.compileNow())
+            {
+                std::fprintf (stderr, "%s: %s\n", file.getFileName().toRawUTF8(), compiler.getErrorMessage().toRawUTF8());
+                continue;
+            }
+
+            auto* graph = compiler.getLatestGraph();
+            graph->bindAudioNodes();
+
+            NodeBase* input = nullptr;
+            for (auto* node : graph->getAudioProcessOrder())
+                if (node->getTypeId() == "AudioInput")
+                    input = node;
+
+            BenchResult audio;
+            audio.suite = "patch";
+            audio.name = file.getFileName();
+            audio.config.set ("stage", "audio");
+            audio.config.set ("blockSize", kBlockSize);
+            audio.setSamples (timeIterations (20, options.iterations (1000), [&]
+            {
+                if (input != nullptr)
+                    for (int ch = 0; ch < 2; ++ch)
+                        if (auto* out = input->getAudioOutputBuffer (ch))
+                            std::memcpy (out, noise.data(), sizeof (float) * noise.size());
+
+                graph->processAudioBlock (kBlockSize);
+            }));
+            results.push_back (std::move (audio));
+
+            if (gl != nullptr)
+            {
+                graph->bindVisualNodes();
+
+                BenchResult visual;
+                visual.suite = "patch";
+                visual.name = file.getFileName();
+                visual.config.set ("stage", "visual");
+                visual.config.set ("width", RenderConfig::getWidth());
+                visual.config.set ("height", RenderConfig::getHeight());
+                visual.setSamples (timeIterations (5, options.iterations (120), [&]
+                {
+                    graph->processVisualFrame (*gl, 1.0 / 60.0);
+                    juce::gl::glFinish();
+                }));
+                results.push_back (std::move (visual));
+            }
+        }
+
+        if (gl != nullptr)
+            GLResourceRegistry::instance().processPendingReleases (*gl);
+    }
+}
+
+} // namespace pf
@@ -0,0 +1,92 @@
+#include "Bench/Bench.h"
+#include "Audio/SessionReplayer.h"
+#include "Rendering/GLResourceRegistry.h"
+#include "Rendering/RenderConfig.h"
+#include <cstdio>
+
+namespace pf
+{
+
+void runTraceBench (const BenchOptions& options, juce::OpenGLContext* gl, std::vector<BenchResult>& results)
+{
+    constexpr double kFrameRate = 60.0;
+
+    {
+        GraphModel model;
+        GraphCompiler compiler (model);
+        AudioEngine engine;   // never initialised: the replayer drives its callback
+        engine.setGraphSource (&compiler.getGraphs());
+
+        SessionReplayer replayer (model, compiler, engine);
+        auto error = replayer.open (options.trace);
+        if (error.isNotEmpty())
+        {
+            std::fprintf (stderr, "%s\n", error.toRawUTF8());
+            return;
+        }
+
+        const auto samplesPerFrame = replayer.getSampleRate() / kFrameRate;
+        double nextFrame = 0.0;
+        std::vector<double> blockMicros, frameMicros;
+
+        while (replayer.advance())
+        {
+            auto start = juce::Time::getHighResolutionTicks();
+            replayer.processBlock();
+            auto elapsed = juce::Time::getHighResolutionTicks() - start;
+            blockMicros.push_back (juce::Time::highResolutionTicksToSeconds (elapsed) * 1.0e6);
+
+            auto* graph = compiler.getLatestGraph();
+            if (gl == nullptr || graph == nullptr)
+                continue;
+
+            if (replayer.graphChanged())
+            {
+                graph->bindVisualNodes();
+                GLResourceRegistry::instance().processPendingReleases (*gl);
+            }
+
+            // Render the frames the canvas would have drawn during this block
+            const auto blockEnd = static_cast<double> (replayer.getPosition() + replayer.getNumSamples());
+            while (nextFrame < blockEnd)
+            {
+                nextFrame += samplesPerFrame;
+
+                start = juce::Time::getHighResolutionTicks();
+                graph->processVisualFrame (*gl, 1.0 / kFrameRate);
+                juce::gl::glFinish();
+                elapsed = juce::Time::getHighResolutionTicks() - start;
+                frameMicros.push_back (juce::Time::highResolutionTicksToSeconds (elapsed) * 1.0e6);
+            }
+        }
+
+        if (replayer.getDroppedSamples() > 0)
+            std::fprintf (stderr, "%s: %lld samples were dropped while recording\n",
+                          options.trace.getFileName().toRawUTF8(), static_cast<long long> (replayer.getDroppedSamples()));
+
+        BenchResult audio;
+        audio.suite = "trace";
+        audio.name = options.trace.getFileName();
+        audio.config.set ("stage", "audio");
+        audio.config.set ("blockSize", replayer.getBlockSize());
+        audio.setSamples (std::move (blockMicros));
+        results.push_back (std::move (audio));
+
+        if (! frameMicros.empty())
+        {
+            BenchResult visual;
+            visual.suite = "trace";
+            visual.name = options.trace.getFileName();
+            visual.config.set ("stage", "visual");
+            visual.config.set ("width", RenderConfig::getWidth());
+            visual.config.set ("height", RenderConfig::getHeight());
+            visual.setSamples (std::move (frameMicros));
+            results.push_back (std::move (visual));
+        }
+    }
+
+    if (gl != nullptr)
+        GLResourceRegistry::instance().processPendingReleases (*gl);
+}
+
+} // namespace pf
@@ -0,0 +1,53 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <memory>
+#include <new>
+
+namespace pf
+{
+
+/**
+ * One zeroed, 64-byte aligned block of floats holding every Audio and Buffer
+ * port of a RuntimeGraph. GraphCompiler hands out offsets into it; ports whose
+ * lifetimes don't overlap share the same range.
+ */
+class BufferArena
+{
+public:
+    static constexpr size_t kAlignment = 64;
+    static constexpr size_t kFloatsPerLine = kAlignment / sizeof (float);
+
+    /** Rounds a port size up so the next port starts on a cache line. */
+    static size_t alignSize (size_t numFloats)
+    {
+        return (numFloats + kFloatsPerLine - 1) / kFloatsPerLine * kFloatsPerLine;
+    }
+
+    void allocate (size_t numFloats)
+    {
+        size_ = numFloats;
+        storage_.reset();
+
+        if (numFloats == 0)
+            return;
+
+        storage_.reset (static_cast<float*> (::operator new[] (numFloats * sizeof (float),
+                                                               std::align_val_t (kAlignment))));
+        std::fill_n (storage_.get(), numFloats, 0.f);
+    }
+
+    float* data() const { return storage_.get(); }
+    size_t size() const { return size_; }
+
+private:
+    struct AlignedDelete
+    {
+        void operator() (float* p) const { ::operator delete[] (p, std::align_val_t (kAlignment)); }
+    };
+
+    std::unique_ptr<float[], AlignedDelete> storage_;
+    size_t size_ = 0;
+};
+
+} // namespace pf
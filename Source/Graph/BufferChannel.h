@@ -0,0 +1,103 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace pf
+{
+
+/**
+ * Carries one Audio or Buffer output from the audio thread to a visual node on the
+ * GL thread.
+ *
+ * A triple buffer sized to the port: the audio thread copies the output into its
+ * own slot after every processed block and publishes it by swapping indices with
+ * the latest slot; once per frame the GL thread swaps the latest slot for the one
+ * it holds, if a newer one was published. Both sides are wait-free, and the GL
+ * thread reads the newest complete block in place until its next latch. Blocks
+ * published between two latches are skipped, as the screen can only show one.
+ *
+ * GraphCompiler inserts one channel per Audio→Visual and Buffer→Visual edge; the
+ * channel has exactly one writer and one reader.
+ */
+class BufferChannel
+{
+public:
+    explicit BufferChannel (int capacity)
+    {
+        for (auto& slot : slots_)
+            slot.data.resize (static_cast<size_t> (juce::jmax (0, capacity)));
+    }
+
+    int getCapacity() const { return static_cast<int> (slots_[0].data.size()); }
+
+    //==============================================================================
+    // Audio thread
+
+    void push (const float* data, int numFloats)
+    {
+        auto& slot = slots_[static_cast<size_t> (writeIndex_)];
+        slot.size = data != nullptr ? juce::jlimit (0, getCapacity(), numFloats) : 0;
+        std::copy_n (data, slot.size, slot.data.data());
+        slot.sequence = ++writeCount_;
+
+        auto previous = latest_.exchange (writeIndex_ | kFresh, std::memory_order_acq_rel);
+        writeIndex_ = previous & kIndexMask;
+    }
+
+    //==============================================================================
+    // GL thread
+
+    /** Takes the newest published block, if there is one the reader hasn't seen. */
+    void latch()
+    {
+        if ((latest_.load (std::memory_order_relaxed) & kFresh) == 0)
+            return;
+
+        auto previous = latest_.exchange (readIndex_, std::memory_order_acq_rel);
+        readIndex_ = previous & kIndexMask;
+    }
+
+    /** The block taken by the last latch (empty before the first push). */
+    std::span<const float> getData() const
+    {
+        auto& slot = slots_[static_cast<size_t> (readIndex_)];
+        return { slot.data.data(), static_cast<size_t> (slot.size) };
+    }
+
+    /** Counts the pushes up to the block taken by the last latch; changes whenever
+        a latch takes a new block. */
+    uint64_t getSequence() const { return slots_[static_cast<size_t> (readIndex_)].sequence; }
+
+    /** Fills the reader's block before anything is pushed: with the one the channel
+        this replaces, in the previous graph, last latched. */
+    void seed (std::span<const float> data)
+    {
+        auto& slot = slots_[static_cast<size_t> (readIndex_)];
+        slot.size = juce::jmin (getCapacity(), static_cast<int> (data.size()));
+        std::copy_n (data.data(), slot.size, slot.data.data());
+    }
+
+private:
+    static constexpr int kFresh = 4;   // set on the latest index until the reader takes it
+    static constexpr int kIndexMask = 3;
+
+    struct Slot
+    {
+        std::vector<float> data;
+        int size = 0;
+        uint64_t sequence = 0;
+    };
+
+    std::array<Slot, 3> slots_;
+    std::atomic<int> latest_ { 2 };
+    int writeIndex_ = 0;        // audio thread only
+    uint64_t writeCount_ = 0;   // audio thread only
+    int readIndex_ = 1;         // GL thread only
+};
+
+} // namespace pf
@@ -0,0 +1,111 @@
+#include "Graph/ControlProgram.h"
+#include "Nodes/Math/AddNode.h"
+#include "Nodes/Math/MultiplyNode.h"
+#include "Nodes/Math/MapRangeNode.h"
+#include "Nodes/Math/ClampNode.h"
+#include "Nodes/Audio/SmoothingNode.h"
+
+namespace pf
+{
+
+bool ControlProgram::canFuse (const NodeBase& node)
+{
+    return dynamic_cast<const AddNode*> (&node) != nullptr
+        || dynamic_cast<const MultiplyNode*> (&node) != nullptr
+        || dynamic_cast<const MapRangeNode*> (&node) != nullptr
+        || dynamic_cast<const ClampNode*> (&node) != nullptr
+        || dynamic_cast<const SmoothingNode*> (&node) != nullptr;
+}
+
+int ControlProgram::allocateRegister()
+{
+    registers_.push_back (0.f);
+    return static_cast<int> (registers_.size()) - 1;
+}
+
+int ControlProgram::addExternalInput (NodeBase* source, int outputIndex)
+{
+    int reg = allocateRegister();
+    externalInputs_.push_back ({ reg, source, outputIndex });
+    return reg;
+}
+
+int ControlProgram::addNode (NodeBase& node, const std::vector<int>& inputRegisters,
+                             const ParamStore* params, int firstParamSlot)
+{
+    params_ = params;
+
+    Instruction ins;
+    ins.dst = allocateRegister();
+    ins.node = &node;
+    ins.paramSlot = firstParamSlot;
+
+    auto input = [&] (size_t i) { return i < inputRegisters.size() ? inputRegisters[i] : kZeroRegister; };
+    ins.a = input (0);
+    ins.b = input (1);
+
+    if (dynamic_cast<AddNode*> (&node) != nullptr)
+        ins.op = Op::Add;
+    else if (dynamic_cast<MultiplyNode*> (&node) != nullptr)
+        ins.op = Op::Multiply;
+    else if (dynamic_cast<MapRangeNode*> (&node) != nullptr)
+        ins.op = Op::MapRange;
+    else if (dynamic_cast<ClampNode*> (&node) != nullptr)
+        ins.op = Op::Clamp;
+    else if (auto* smoothing = dynamic_cast<SmoothingNode*> (&node))
+    {
+        ins.op = Op::Smooth;
+        ins.state = &smoothing->getState();
+    }
+    else
+    {
+        jassertfalse; // canFuse() should have rejected this node
+        return kZeroRegister;
+    }
+
+    tape_.push_back (ins);
+    members_.push_back (&node);
+    return ins.dst;
+}
+
+void ControlProgram::run()
+{
+    auto* regs = registers_.data();
+
+    for (auto& in : externalInputs_)
+        regs[in.reg] = in.source->getSignalOutputValue (in.outputIndex);
+
+    for (auto& ins : tape_)
+    {
+        auto param = [&] (int index) { return params_->load (ins.paramSlot + index); };
+
+        float result = 0.f;
+        switch (ins.op)
+        {
+            case Op::Add:
+                result = regs[ins.a] + regs[ins.b];
+                break;
+            case Op::Multiply:
+                result = regs[ins.a] * regs[ins.b];
+                break;
+            case Op::MapRange:
+                result = MapRangeNode::map (regs[ins.a],
+                                            param (MapRangeNode::Param::inMin),
+                                            param (MapRangeNode::Param::inMax),
+                                            param (MapRangeNode::Param::outMin),
+                                            param (MapRangeNode::Param::outMax));
+                break;
+            case Op::Clamp:
+                result = juce::jlimit (param (ClampNode::Param::min), param (ClampNode::Param::max), regs[ins.a]);
+                break;
+            case Op::Smooth:
+                result = SmoothingNode::step (*ins.state, regs[ins.a], param (SmoothingNode::Param::smoothing));
+                break;
+        }
+
+        regs[ins.dst] = result;
+        ins.node->setSignalOutputValue (0, result);
+    }
+}
+
+} // namespace pf
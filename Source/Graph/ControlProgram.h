@@ -0,0 +1,74 @@
+#pragma once
+#include "Nodes/NodeBase.h"
+#include "Graph/ParamStore.h"
+#include <vector>
+
+namespace pf
+{
+
+/**
+ * A fused chain of control-rate scalar nodes (Add, Multiply, MapRange, Clamp,
+ * Smoothing), compiled by GraphCompiler into a flat instruction tape over a
+ * register file.
+ *
+ * One run() replaces a virtual processBlock() per node: values flow between
+ * members through registers, params are read straight from their ParamStore
+ * slots, and only signals coming from outside the chain are fetched from other
+ * nodes. Every member's output is still written back to the node, so consumers
+ * outside the chain (and the UI) see the same values as before.
+ *
+ * Instructions read a member's params at its first slot plus the node's own
+ * Param index, so the fusable nodes keep their Param enums public.
+ */
+class ControlProgram
+{
+public:
+    /** Whether a node can be compiled into a program. */
+    static bool canFuse (const NodeBase& node);
+
+    /** Register 0 always reads zero; it stands in for unconnected inputs. */
+    static constexpr int kZeroRegister = 0;
+
+    /** Allocates a register loaded from an output outside the program on each run. */
+    int addExternalInput (NodeBase* source, int outputIndex);
+
+    /** Appends a member (in evaluation order). Its inputs are registers; returns its output register. */
+    int addNode (NodeBase& node, const std::vector<int>& inputRegisters, const ParamStore* params,
+                 int firstParamSlot);
+
+    /** Audio thread: evaluate the whole chain. */
+    void run();
+
+    const std::vector<NodeBase*>& getMembers() const { return members_; }
+
+private:
+    enum class Op { Add, Multiply, MapRange, Clamp, Smooth };
+
+    struct Instruction
+    {
+        Op op;
+        int dst = 0;
+        int a = kZeroRegister;
+        int b = kZeroRegister;
+        int paramSlot = 0;        // first param slot of the node
+        float* state = nullptr;   // Smoothing lag state, owned by the node
+        NodeBase* node = nullptr; // receives the result as its signal output
+    };
+
+    struct ExternalInput
+    {
+        int reg = 0;
+        NodeBase* source = nullptr;
+        int outputIndex = 0;
+    };
+
+    int allocateRegister();
+
+    std::vector<Instruction> tape_;
+    std::vector<ExternalInput> externalInputs_;
+    std::vector<float> registers_ { 0.f };
+    std::vector<NodeBase*> members_;
+    const ParamStore* params_ = nullptr;
+};
+
+} // namespace pf
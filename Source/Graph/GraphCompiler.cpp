@@ -1,6 +1,9 @@
 #include "Graph/GraphCompiler.h"
+#include <algorithm>
+#include <utility>
 #include <unordered_map>
-#include <unordered_set>
+#include <map>
+#include <numeric>
 #include <queue>
 
 namespace pf
@@ -15,17 +18,55 @@ GraphCompiler::~GraphCompiler()
 {
     stopTimer();
     model_.removeListener (this);
-    pendingGraph_.store (nullptr, std::memory_order_release);
+
+    // Stop any build in progress before the state it works on goes away. Builds
+    // check for cancellation as they go, so waiting without a timeout always ends
+    buildGeneration_.fetch_add (1);
+    buildPool_.removeAllJobs (true, -1);
+    cancelPendingUpdate();
 }
 
 void GraphCompiler::graphChanged()
 {
-    // Debounce: coalesce rapid changes (e.g. slider drags) into a single recompile
+    // Debounce: coalesce rapid changes (e.g. undo of a multi-node delete) into a single recompile
     compilePending_ = true;
     if (! isTimerRunning())
         startTimer (16); // ~60 Hz max recompile rate
 }
 
+void GraphCompiler::nodeParamChanged (const juce::String& nodeId, const juce::Identifier& param)
+{
+    if (writingDefaults_)
+        return;
+
+    auto* latest = graphs_.getLatest();
+    auto* slots = latest != nullptr ? latest->findNodeSlots (nodeId) : nullptr;
+    if (slots == nullptr)
+        return; // not built yet; the build in flight picks the value up when it's published
+
+    auto* value = model_.getParamsTree (nodeId).getPropertyPointer (param);
+    if (value == nullptr)
+        return;
+
+    // Publish into every graph still in flight; threads that haven't adopted the
+    // latest one yet keep reading the store they're bound to. Each graph finds the
+    // param on its own instance, since a retired graph may hold another node type
+    // under the same id.
+    const auto paramName = param.toString();
+    const NodeParam* latestParam = nullptr;
+    graphs_.forEachGraph ([&] (RuntimeGraph& graph)
+    {
+        auto* published = graph.publishParam (nodeId, paramName, *value);
+        if (&graph == latest)
+            latestParam = published;
+    });
+
+    // Prepare-time params need a new instance, and a merged duplicate that now
+    // differs needs to run on its own
+    if (latestParam != nullptr && (latestParam->requiresPrepare || slots->merged))
+        graphChanged();
+}
+
 void GraphCompiler::timerCallback()
 {
     stopTimer();
@@ -38,183 +79,975 @@ void GraphCompiler::timerCallback()
 
 void GraphCompiler::compile()
 {
-    auto graph = buildRuntimeGraph();
-    if (! graph)
-        return;
-
-    graph->prepareToPlay (currentSampleRate_, currentBlockSize_);
-    RuntimeGraph* graphPtr = graph.get();
-    compiledGraphs_.push_back (std::move (graph));
-    latestGraph_ = graphPtr;
+    auto snapshot = takeSnapshot();
+    auto generation = buildGeneration_.fetch_add (1) + 1;
 
-    // Publish for audio thread
-    RuntimeGraph* old = pendingGraph_.exchange (graphPtr, std::memory_order_release);
-    juce::ignoreUnused (old);
-
-    // Retain only the last few graphs so audio/GL threads never see a freed pointer.
-    // Older graphs are safe to remove since they've been superseded.
-    constexpr size_t kMaxRetainedGraphs = 4;
-    if (compiledGraphs_.size() > kMaxRetainedGraphs)
-        compiledGraphs_.erase (compiledGraphs_.begin(),
-                               compiledGraphs_.end() - static_cast<std::ptrdiff_t> (kMaxRetainedGraphs));
+    buildPool_.addJob ([this, snapshot, generation]() mutable { runBuild (std::move (snapshot), generation); });
 }
 
-bool GraphCompiler::hasCycle (const std::vector<juce::String>& nodeIds,
-                               const std::vector<Connection>& connections)
+bool GraphCompiler::compileNow()
 {
-    // DFS with white(0)/gray(1)/black(2) coloring
-    std::unordered_map<std::string, int> color;
-    std::unordered_map<std::string, std::vector<std::string>> adj;
+    // This build covers any debounced edit
+    stopTimer();
+    compilePending_ = false;
+
+    auto snapshot = takeSnapshot();
+    auto generation = buildGeneration_.fetch_add (1) + 1;
+
+    // The bumped generation cancels a queued or running job; once it's gone, the
+    // build-thread state is ours
+    buildPool_.removeAllJobs (true, -1);
+    cancelPendingUpdate();
+    {
+        const juce::ScopedLock sl (resultLock_);
+        finishedBuilds_.clear();
+    }
 
-    for (auto& id : nodeIds)
-        color[id.toStdString()] = 0;
+    BuildResult result;
+    result.generation = generation;
+    result.graph = buildRuntimeGraph (*snapshot, generation, result);
+    result.snapshot = std::move (snapshot);
+    adoptResult (result);
+    return ! hasError_;
+}
 
-    for (auto& conn : connections)
-        adj[conn.sourceNode.toStdString()].push_back (conn.destNode.toStdString());
+std::shared_ptr<const GraphCompiler::GraphSnapshot> GraphCompiler::takeSnapshot() const
+{
+    auto snapshot = std::make_shared<GraphSnapshot>();
+    snapshot->sampleRate = currentSampleRate_;
+    snapshot->blockSize = currentBlockSize_;
 
-    std::function<bool(const std::string&)> dfs = [&] (const std::string& u) -> bool
+    // A node's handle is its position in the model's topological order, so ids are
+    // resolved once, here, and a valid order needs no sorting by the build
+    snapshot->isSorted = model_.isAcyclic();
+    for (auto& id : model_.getNodeIdsInTopologicalOrder())
     {
-        color[u] = 1; // gray
-        for (auto& v : adj[u])
+        GraphSnapshot::NodeEntry entry;
+        entry.id = id;
+        entry.typeId = model_.getNodeTypeId (id);
+        entry.paramsTree = model_.getParamsTree (id);
+
+        for (int i = 0; i < entry.paramsTree.getNumProperties(); ++i)
         {
-            if (color[v] == 1) return true;  // back edge → cycle
-            if (color[v] == 0 && dfs (v)) return true;
+            auto name = entry.paramsTree.getPropertyName (i);
+            entry.params.set (name, entry.paramsTree.getProperty (name));
         }
-        color[u] = 2; // black
-        return false;
-    };
 
-    for (auto& id : nodeIds)
-        if (color[id.toStdString()] == 0 && dfs (id.toStdString()))
-            return true;
+        snapshot->nodes.push_back (std::move (entry));
+    }
+
+    // Connections as CSR adjacency: the edges leaving node n are
+    // edges[edgeOffsets[n] .. edgeOffsets[n + 1])
+    const auto numNodes = snapshot->nodes.size();
+    std::vector<GraphSnapshot::Edge> edges;
+    for (auto& conn : model_.getAllConnections())
+    {
+        auto source = model_.getTopologicalIndex (conn.sourceNode);
+        auto dest = model_.getTopologicalIndex (conn.destNode);
+        if (source >= 0 && dest >= 0)
+            edges.push_back ({ static_cast<uint32_t> (source), conn.sourcePort,
+                               static_cast<uint32_t> (dest), conn.destPort });
+    }
+
+    snapshot->edgeOffsets.assign (numNodes + 1, 0);
+    for (auto& edge : edges)
+        ++snapshot->edgeOffsets[edge.source + 1];
+    for (size_t n = 0; n < numNodes; ++n)
+        snapshot->edgeOffsets[n + 1] += snapshot->edgeOffsets[n];
+
+    snapshot->edges.resize (edges.size());
+    auto next = snapshot->edgeOffsets;
+    for (auto& edge : edges)
+        snapshot->edges[next[edge.source]++] = edge;
+
+    return snapshot;
+}
+
+void GraphCompiler::runBuild (std::shared_ptr<const GraphSnapshot> snapshot, uint32_t generation)
+{
+    auto result = std::make_unique<BuildResult>();
+    result->generation = generation;
+
+    if (buildGeneration_.load() == generation)
+        result->graph = buildRuntimeGraph (*snapshot, generation, *result);
 
-    return false;
+    // Hand everything back, so the snapshot's ValueTrees are let go on the message thread
+    result->snapshot = std::move (snapshot);
+    {
+        const juce::ScopedLock sl (resultLock_);
+        finishedBuilds_.push_back (std::move (result));
+    }
+    triggerAsyncUpdate();
 }
 
-std::vector<juce::String> GraphCompiler::topologicalSort (
-    const std::vector<juce::String>& nodeIds,
-    const std::vector<Connection>& connections)
+void GraphCompiler::handleAsyncUpdate()
 {
-    // Kahn's algorithm
-    std::unordered_map<std::string, int> inDegree;
-    std::unordered_map<std::string, std::vector<std::string>> adj;
+    std::vector<std::unique_ptr<BuildResult>> results;
+    {
+        const juce::ScopedLock sl (resultLock_);
+        results.swap (finishedBuilds_);
+    }
 
-    for (auto& id : nodeIds)
-        inDegree[id.toStdString()] = 0;
+    // Results of superseded builds are dropped unpublished
+    for (auto& result : results)
+        if (result->generation == buildGeneration_.load())
+            adoptResult (*result);
+}
+
+void GraphCompiler::adoptResult (BuildResult& result)
+{
+    hasError_ = result.errorMessage.isNotEmpty();
+    errorMessage_ = result.errorMessage;
+
+    if (! result.graph)
+        return;
 
-    for (auto& conn : connections)
+    // Complete the model with the defaults of params it didn't have yet
+    writingDefaults_ = true;
+    for (auto& param : result.defaults)
     {
-        adj[conn.sourceNode.toStdString()].push_back (conn.destNode.toStdString());
-        inDegree[conn.destNode.toStdString()]++;
+        auto paramsTree = model_.getParamsTree (param.nodeId);
+        if (paramsTree.isValid() && ! paramsTree.hasProperty (param.name))
+            paramsTree.setProperty (param.name, param.value, nullptr);
     }
+    writingDefaults_ = false;
 
-    std::queue<std::string> queue;
-    for (auto& [id, deg] : inDegree)
-        if (deg == 0)
-            queue.push (id);
+    // Params edited while the build ran aren't in its snapshot. Nodes deleted since,
+    // and params the model doesn't have, keep the values the build gave them.
+    for (auto& node : result.graph->getAllNodes())
+    {
+        auto paramsTree = model_.getParamsTree (node->nodeId);
+        if (! paramsTree.isValid())
+            continue;
+
+        auto& params = node->getParams();
+        for (int i = 0; i < static_cast<int> (params.size()); ++i)
+            if (auto* value = paramsTree.getPropertyPointer (juce::Identifier (params[static_cast<size_t> (i)].name)))
+                result.graph->publishParam (node->nodeId, i, *value);
+    }
 
-    std::vector<juce::String> sorted;
-    sorted.reserve (nodeIds.size());
+    graphs_.publish (std::move (result.graph));
+}
+
+bool GraphCompiler::topologicalSort (const GraphSnapshot& snapshot, std::vector<uint32_t>& order)
+{
+    const auto numNodes = static_cast<uint32_t> (snapshot.nodes.size());
 
-    while (! queue.empty())
+    // Handles already follow the model's maintained order
+    if (snapshot.isSorted)
     {
-        auto id = queue.front();
-        queue.pop();
-        sorted.push_back (juce::String (id));
+        order.resize (numNodes);
+        std::iota (order.begin(), order.end(), 0u);
+        return true;
+    }
 
-        for (auto& neighbor : adj[id])
-            if (--inDegree[neighbor] == 0)
-                queue.push (neighbor);
+    // Kahn's algorithm over the CSR edges; nodes on a cycle never reach in-degree 0
+    std::vector<uint32_t> inDegree (numNodes, 0);
+    for (auto& edge : snapshot.edges)
+        ++inDegree[edge.dest];
+
+    order.clear();
+    order.reserve (numNodes);
+    for (uint32_t n = 0; n < numNodes; ++n)
+        if (inDegree[n] == 0)
+            order.push_back (n);
+
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        auto n = order[i];
+        for (auto e = snapshot.edgeOffsets[n]; e < snapshot.edgeOffsets[n + 1]; ++e)
+            if (--inDegree[snapshot.edges[e].dest] == 0)
+                order.push_back (snapshot.edges[e].dest);
     }
 
-    return sorted;
+    return order.size() == numNodes;
 }
 
-std::unique_ptr<RuntimeGraph> GraphCompiler::buildRuntimeGraph()
+std::unique_ptr<RuntimeGraph> GraphCompiler::buildRuntimeGraph (const GraphSnapshot& snapshot, uint32_t generation,
+                                                                BuildResult& result)
 {
-    auto nodeIds = model_.getAllNodeIds();
-    auto connections = model_.getAllConnections();
+    auto cancelled = [&] { return buildGeneration_.load() != generation; };
 
-    // Cycle detection
-    if (hasCycle (nodeIds, connections))
+    std::vector<uint32_t> order;
+    if (! topologicalSort (snapshot, order))
     {
-        hasError_ = true;
-        errorMessage_ = "Cycle detected in graph!";
+        result.errorMessage = "Cycle detected in graph!";
         return nullptr;
     }
 
-    hasError_ = false;
-    errorMessage_ = {};
+    auto graph = std::make_unique<RuntimeGraph>();
+    graph->sampleRate_ = snapshot.sampleRate;
 
-    auto sortedIds = topologicalSort (nodeIds, connections);
+    // Live instances can only be carried over while the audio format is unchanged
+    const bool canReuse = preparedSampleRate_ == snapshot.sampleRate
+                       && preparedBlockSize_ == snapshot.blockSize;
 
-    auto graph = std::make_unique<RuntimeGraph>();
+    // Per-handle state of this build
+    const auto numNodes = snapshot.nodes.size();
+    BuildState build;
+    build.nodeOf.assign (numNodes, nullptr);
+    build.firstSlotOf.assign (numNodes, 0);
+    build.inputs.resize (numNodes);
+    auto& nodeOf = build.nodeOf;
+    auto& firstSlotOf = build.firstSlotOf;
+    auto& inputs = build.inputs;
 
-    // Instantiate nodes
-    std::unordered_map<std::string, NodeBase*> nodeMap;
-    for (auto& id : sortedIds)
+    // Instantiate nodes, moving unchanged instances over from the previous graph
+    std::unordered_map<juce::String, LiveNode> liveNodes;
+    liveNodes.reserve (numNodes);
+    std::vector<uint32_t> freshNodes;
+    int numParamSlots = 0;
+    for (auto h : order)
     {
-        auto typeId = model_.getNodeTypeId (id);
-        auto node = NodeRegistry::instance().createNode (typeId);
-        if (! node) continue;
+        if (cancelled())
+            return nullptr;
 
-        node->nodeId = id;
+        auto& entry = snapshot.nodes[h];
 
-        // Apply params from model
-        auto paramsTree = model_.getParamsTree (id);
-        node->setParamTree (paramsTree);
+        std::shared_ptr<NodeBase> node;
+        if (canReuse)
+        {
+            auto it = liveNodes_.find (entry.id);
+            if (it != liveNodes_.end()
+                && it->second.node->getTypeId() == entry.typeId
+                && it->second.paramsTree == entry.paramsTree
+                && it->second.prepareKey == makePrepareKey (*it->second.node, entry.params))
+                node = it->second.node;
+        }
 
-        // Set default param values if not already in tree
-        for (auto& param : node->getParams())
+        if (! node)
         {
-            if (! paramsTree.hasProperty (juce::Identifier (param.name)))
-                paramsTree.setProperty (juce::Identifier (param.name), param.defaultValue, nullptr);
+            node = NodeRegistry::instance().createNode (entry.typeId);
+            if (! node) continue;
+
+            node->nodeId = entry.id;
+            freshNodes.push_back (h);
         }
 
-        nodeMap[id.toStdString()] = node.get();
+        // Give the node a contiguous slot range in this graph's param store
+        firstSlotOf[h] = numParamSlots;
+        numParamSlots += static_cast<int> (node->getParams().size());
+
+        nodeOf[h] = node.get();
+        liveNodes[entry.id] = { node, entry.paramsTree, makePrepareKey (*node, entry.params) };
         graph->nodes_.push_back (std::move (node));
     }
 
-    // Resolve connections
-    for (auto& conn : connections)
+    // Fill the param store from the snapshot, falling back to (and recording) defaults
+    graph->params_.allocate (numParamSlots);
+    for (auto h : order)
+    {
+        auto* node = nodeOf[h];
+        if (node == nullptr) continue;
+
+        auto& values = snapshot.nodes[h].params;
+        auto& params = node->getParams();
+        for (int i = 0; i < static_cast<int> (params.size()); ++i)
+        {
+            auto& param = params[static_cast<size_t> (i)];
+            juce::Identifier name (param.name);
+
+            if (! values.contains (name))
+                result.defaults.push_back ({ node->nodeId, name, param.defaultValue });
+
+            graph->params_.storeVar (firstSlotOf[h] + i, values.contains (name) ? values[name] : param.defaultValue);
+        }
+    }
+
+    // Fresh nodes aren't visible to any other thread yet, so they can be bound and prepared here
+    for (auto h : freshNodes)
     {
-        auto srcIt = nodeMap.find (conn.sourceNode.toStdString());
-        auto dstIt = nodeMap.find (conn.destNode.toStdString());
-        if (srcIt == nodeMap.end() || dstIt == nodeMap.end()) continue;
+        nodeOf[h]->bindParams (&graph->params_, firstSlotOf[h]);
+        nodeOf[h]->prepareToPlay (snapshot.sampleRate, snapshot.blockSize);
 
-        dstIt->second->setInputConnection (conn.destPort, srcIt->second, conn.sourcePort);
+        if (cancelled())
+            return nullptr;
     }
 
+    // Resolve connections to the handles they read, by dest port
+    for (auto h : order)
+        if (auto* node = nodeOf[h])
+            inputs[h].resize (static_cast<size_t> (node->getNumInputs()));
+
+    for (auto& edge : snapshot.edges)
+    {
+        if (nodeOf[edge.source] == nullptr || nodeOf[edge.dest] == nullptr) continue;
+
+        auto& destInputs = inputs[edge.dest];
+        if (edge.destPort >= 0 && edge.destPort < static_cast<int> (destInputs.size()))
+            destInputs[static_cast<size_t> (edge.destPort)] = { edge.source, edge.sourcePort };
+    }
+
+    // Pure duplicates hand their consumers to the first equivalent instance and drop
+    // out like dead nodes, keeping their ids and instances for the editor
+    auto canonicalOf = mergeDuplicates (snapshot, order, build);
+    std::vector<bool> merged (numNodes, false);
+    for (auto h : order)
+        if (canonicalOf[h] != h)
+            merged[h] = merged[canonicalOf[h]] = true;
+
+    // The GUI finds nodes and their param slots by id
+    graph->nodeSlots_.reserve (numNodes);
+    for (auto h : order)
+        if (auto* node = nodeOf[h])
+            graph->nodeSlots_[snapshot.nodes[h].id] = { node, firstSlotOf[h], static_cast<int> (node->getParams().size()),
+                                                        merged[h] };
+
+    // Unconnected Audio/Buffer inputs of analysis readers take the first exported
+    // output of their type, in dependency order
+    auto findAnalysisOutput = [&] (PortType type) -> Input
+    {
+        for (auto h : order)
+        {
+            auto* node = nodeOf[h];
+            if (node == nullptr || canonicalOf[h] != h || ! node->exportsAnalysis())
+                continue;
+
+            for (auto& port : node->getOutputs())
+                if (port.type == type)
+                    return { h, port.index };
+        }
+        return {};
+    };
+
+    const auto analysisAudio = findAnalysisOutput (PortType::Audio);
+    const auto analysisBuffer = findAnalysisOutput (PortType::Buffer);
+
+    for (auto h : order)
+    {
+        auto* node = nodeOf[h];
+        if (node == nullptr || ! node->readsAnalysis())
+            continue;
+
+        for (auto& port : node->getInputs())
+        {
+            auto& input = inputs[h][static_cast<size_t> (port.index)];
+            if (input.source != Input::none)
+                continue;
+
+            if (port.type == PortType::Audio)
+                input = analysisAudio;
+            else if (port.type == PortType::Buffer)
+                input = analysisBuffer;
+        }
+    }
+
+    // Only nodes that feed a sink run; the rest stay instantiated (and bound) so
+    // reconnecting them doesn't need a fresh instance
+    auto live = findLiveNodes (build, canonicalOf);
+
     // Build process orders — partition into audio and visual
-    for (auto& id : sortedIds)
+    for (auto h : order)
     {
-        auto it = nodeMap.find (id.toStdString());
-        if (it == nodeMap.end()) continue;
+        auto* node = nodeOf[h];
+        if (node == nullptr || ! live[h]) continue;
 
-        auto* node = it->second;
         if (node->isVisualNode())
-            graph->visualProcessOrder_.push_back (node);
+            build.visualOrder.push_back (h);
         else
-            graph->audioProcessOrder_.push_back (node);
+            build.audioOrder.push_back (h);
     }
 
-    // Mark disconnected nodes as bypassed
-    std::unordered_set<std::string> connectedNodes;
-    for (auto& conn : connections)
+    fuseControlChains (*graph, build);
+    auto slotOf = scheduleLevels (*graph, build, snapshot.blockSize);
+    auto outputStorage = layoutBuffers (*graph, build, slotOf, snapshot.blockSize);
+
+    for (auto h : build.visualOrder)
+        graph->visualProcessOrder_.push_back (nodeOf[h]);
+    for (auto h : build.audioOrder)
+        graph->audioProcessOrder_.push_back (nodeOf[h]);
+
+    for (auto h : order)
     {
-        connectedNodes.insert (conn.sourceNode.toStdString());
-        connectedNodes.insert (conn.destNode.toStdString());
+        auto* node = nodeOf[h];
+        if (node == nullptr) continue;
+
+        // Dead nodes aren't in either process order; flag them for anyone inspecting the node
+        bool bypassed = ! live[h];
+
+        std::vector<NodeBase::InputConnection> connections (inputs[h].size());
+        for (size_t i = 0; i < connections.size(); ++i)
+            if (auto& input = inputs[h][i]; input.source != Input::none)
+                connections[i] = { nodeOf[input.source], input.outputIndex };
+
+        // Outputs read on the GL thread are fed across by the audio thread: Signal
+        // outputs through a rate bridge, Audio and Buffer outputs through a channel
+        // sized to the port
+        if (node->isVisualNode() && ! bypassed)
+        {
+            for (auto& conn : connections)
+            {
+                auto* source = conn.sourceNode;
+                if (source == nullptr || source->isVisualNode()
+                    || ! juce::isPositiveAndBelow (conn.sourceOutputIndex, source->getNumOutputs()))
+                    continue;
+
+                auto& outputs = source->getOutputs();
+                auto type = outputs[static_cast<size_t> (conn.sourceOutputIndex)].type;
+
+                if (type == PortType::Signal)
+                {
+                    auto& bridge = graph->signalBridges_.emplace_back (std::make_unique<SignalBridge>());
+                    graph->bridgeFeeds_.push_back ({ source, conn.sourceOutputIndex, bridge.get() });
+                    conn.bridge = bridge.get();
+                }
+                else if (type == PortType::Audio || type == PortType::Buffer)
+                {
+                    auto localIndex = static_cast<int> (std::count_if (outputs.begin(), outputs.begin() + conn.sourceOutputIndex,
+                                                                       [type] (auto& port) { return port.type == type; }));
+                    auto capacity = type == PortType::Audio ? snapshot.blockSize : source->getBufferOutputSize (localIndex);
+
+                    auto& channel = graph->bufferChannels_.emplace_back (std::make_unique<BufferChannel> (capacity));
+                    graph->channelFeeds_.push_back ({ source, type, localIndex, channel.get() });
+                    conn.channel = channel.get();
+                }
+            }
+        }
+
+        auto& bindings = node->isVisualNode() ? graph->visualBindings_ : graph->audioBindings_;
+        bindings.push_back ({ node, std::move (connections), bypassed, firstSlotOf[h],
+                              std::move (outputStorage[h]) });
     }
-    for (auto& [id, node] : nodeMap)
+
+    graph->buildVisualSteps();
+
+    if (cancelled())
+        return nullptr;
+
+    // Committed: the next build reuses these instances
+    result.releasedLiveNodes = std::exchange (liveNodes_, std::move (liveNodes));
+    preparedSampleRate_ = snapshot.sampleRate;
+    preparedBlockSize_ = snapshot.blockSize;
+
+    return graph;
+}
+
+std::vector<uint32_t> GraphCompiler::mergeDuplicates (const GraphSnapshot& snapshot, const std::vector<uint32_t>& order,
+                                                      BuildState& build)
+{
+    std::vector<uint32_t> canonicalOf (build.nodeOf.size());
+    std::iota (canonicalOf.begin(), canonicalOf.end(), 0u);
+
+    // Pure nodes are equivalent if they have the same type, resolved params (defaults
+    // included) and input sources
+    auto paramValue = [&] (uint32_t h, const NodeParam& param) -> const juce::var&
+    {
+        auto* value = snapshot.nodes[h].params.getVarPointer (juce::Identifier (param.name));
+        return value != nullptr ? *value : param.defaultValue;
+    };
+
+    auto hashOf = [&] (uint32_t h)
+    {
+        auto hash = build.nodeOf[h]->getTypeId().hash();
+        auto combine = [&hash] (size_t value) { hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+
+        for (auto& param : build.nodeOf[h]->getParams())
+            combine (paramValue (h, param).toString().hash());
+        for (auto& input : build.inputs[h])
+            combine ((static_cast<size_t> (input.source) << 8) ^ static_cast<size_t> (input.outputIndex));
+        return hash;
+    };
+
+    auto equivalent = [&] (uint32_t a, uint32_t b)
     {
-        // AudioInput is never bypassed (it's a source)
-        if (node->getTypeId() == "AudioInput" || node->getTypeId() == "OutputCanvas")
+        if (build.nodeOf[a]->getTypeId() != build.nodeOf[b]->getTypeId() || build.inputs[a] != build.inputs[b])
+            return false;
+
+        for (auto& param : build.nodeOf[a]->getParams())
+            if (paramValue (a, param).toString() != paramValue (b, param).toString())
+                return false;
+        return true;
+    };
+
+    std::unordered_multimap<size_t, uint32_t> byHash;
+
+    // In dependency order, so a node's sources are already resolved to the instance
+    // that runs, and duplicated chains collapse from the top down
+    for (auto h : order)
+    {
+        auto* node = build.nodeOf[h];
+        if (node == nullptr)
+            continue;
+
+        for (auto& input : build.inputs[h])
+            if (input.source != Input::none)
+                input.source = canonicalOf[input.source];
+
+        if (! node->isPure() || node->isSink())
             continue;
-        if (connectedNodes.find (id) == connectedNodes.end())
-            node->setBypassed (true);
+
+        const auto hash = hashOf (h);
+        auto [first, last] = byHash.equal_range (hash);
+        auto match = std::find_if (first, last, [&] (auto& candidate) { return equivalent (candidate.second, h); });
+
+        if (match != last)
+            canonicalOf[h] = match->second;
+        else
+            byHash.emplace (hash, h);
     }
 
-    return graph;
+    return canonicalOf;
+}
+
+std::vector<bool> GraphCompiler::findLiveNodes (const BuildState& build, const std::vector<uint32_t>& canonicalOf)
+{
+    const auto numNodes = static_cast<uint32_t> (build.nodeOf.size());
+    std::vector<bool> live (numNodes, false);
+    std::vector<uint32_t> pending;
+
+    for (uint32_t root = 0; root < numNodes; ++root)
+    {
+        auto* node = build.nodeOf[root];
+        if (node == nullptr || canonicalOf[root] != root || ! node->isSink() || live[root])
+            continue;
+
+        live[root] = true;
+        pending.push_back (root);
+        while (! pending.empty())
+        {
+            auto h = pending.back();
+            pending.pop_back();
+
+            for (auto& input : build.inputs[h])
+            {
+                if (input.source != Input::none && ! live[input.source])
+                {
+                    live[input.source] = true;
+                    pending.push_back (input.source);
+                }
+            }
+        }
+    }
+
+    return live;
+}
+
+void GraphCompiler::fuseControlChains (RuntimeGraph& graph, BuildState& build)
+{
+    auto& order = build.audioOrder;
+    const auto numNodes = build.nodeOf.size();
+
+    std::vector<int> position (numNodes, -1);   // -1 outside the audio order
+    for (int i = 0; i < static_cast<int> (order.size()); ++i)
+        position[order[static_cast<size_t> (i)]] = i;
+
+    auto isScheduled = [&] (const Input& input) { return input.source != Input::none && position[input.source] >= 0; };
+
+    // A fused chain runs as one step, so it must be convex: no path may leave it
+    // through another node and come back in. Count the non-fusable nodes on the
+    // deepest path to each node; merging only neighbours with equal counts rules
+    // such paths out, and keeps the contracted graph acyclic.
+    std::vector<bool> fusable (numNodes, false);
+    std::vector<int> barrierDepth (numNodes, 0);
+    std::vector<uint32_t> parent (numNodes);
+    std::iota (parent.begin(), parent.end(), 0u);
+
+    auto findRoot = [&parent] (uint32_t h)
+    {
+        while (parent[h] != h)
+            h = parent[h] = parent[parent[h]];
+        return h;
+    };
+
+    for (auto h : order)
+    {
+        fusable[h] = ControlProgram::canFuse (*build.nodeOf[h]);
+
+        int depth = 0;
+        for (auto& input : build.inputs[h])
+            if (isScheduled (input))
+                depth = juce::jmax (depth, barrierDepth[input.source] + (fusable[input.source] ? 0 : 1));
+        barrierDepth[h] = depth;
+
+        if (! fusable[h])
+            continue;
+
+        for (auto& input : build.inputs[h])
+            if (isScheduled (input) && fusable[input.source] && barrierDepth[input.source] == depth)
+                parent[findRoot (h)] = findRoot (input.source);
+    }
+
+    // Chains of a single node gain nothing; leave them as plain steps
+    std::vector<std::vector<uint32_t>> chains (numNodes);   // by root, members in order
+    for (auto h : order)
+        if (fusable[h])
+            chains[findRoot (h)].push_back (h);
+
+    std::vector<uint32_t> unitOf (numNodes);   // node → representative of its step
+    for (auto h : order)
+    {
+        auto root = findRoot (h);
+        unitOf[h] = (fusable[h] && chains[root].size() > 1) ? root : h;
+    }
+
+    // Re-sort the contracted graph (Kahn's, ties broken by original position), its
+    // edges as CSR adjacency grouped by source unit
+    std::vector<std::pair<uint32_t, uint32_t>> unitEdges;
+    for (auto h : order)
+        for (auto& input : build.inputs[h])
+            if (isScheduled (input) && unitOf[input.source] != unitOf[h])
+                unitEdges.emplace_back (unitOf[input.source], unitOf[h]);
+
+    std::sort (unitEdges.begin(), unitEdges.end());
+    unitEdges.erase (std::unique (unitEdges.begin(), unitEdges.end()), unitEdges.end());
+
+    std::vector<uint32_t> successorOffsets (numNodes + 1, 0);
+    std::vector<int> inDegree (numNodes, 0);
+    for (auto& [from, to] : unitEdges)
+    {
+        ++successorOffsets[from + 1];
+        ++inDegree[to];
+    }
+    std::partial_sum (successorOffsets.begin(), successorOffsets.end(), successorOffsets.begin());
+
+    auto later = [&] (uint32_t a, uint32_t b) { return position[a] > position[b]; };
+    std::priority_queue<uint32_t, std::vector<uint32_t>, decltype (later)> ready (later);
+    for (auto h : order)
+        if (unitOf[h] == h && inDegree[h] == 0)
+            ready.push (h);
+
+    std::vector<uint32_t> newOrder;
+    newOrder.reserve (order.size());
+
+    // Registers of the members of the program being built, -1 for any other node
+    std::vector<int> registerOf (numNodes, -1);
+
+    while (! ready.empty())
+    {
+        auto unit = ready.top();
+        ready.pop();
+
+        auto& chain = chains[unit];
+        if (chain.size() > 1)
+        {
+            auto program = std::make_unique<ControlProgram>();
+
+            struct External { uint32_t source; int outputIndex; int reg; };
+            std::vector<External> externals;
+
+            for (auto member : chain)
+            {
+                std::vector<int> inputRegisters;
+                for (auto& input : build.inputs[member])
+                {
+                    if (input.source == Input::none)
+                    {
+                        inputRegisters.push_back (ControlProgram::kZeroRegister);
+                    }
+                    else if (registerOf[input.source] >= 0)
+                    {
+                        inputRegisters.push_back (registerOf[input.source]);
+                    }
+                    else
+                    {
+                        auto ext = std::find_if (externals.begin(), externals.end(), [&] (const External& e)
+                        {
+                            return e.source == input.source && e.outputIndex == input.outputIndex;
+                        });
+
+                        if (ext == externals.end())
+                            ext = externals.insert (externals.end(), { input.source, input.outputIndex,
+                                                                       program->addExternalInput (build.nodeOf[input.source],
+                                                                                                  input.outputIndex) });
+                        inputRegisters.push_back (ext->reg);
+                    }
+                }
+
+                registerOf[member] = program->addNode (*build.nodeOf[member], inputRegisters, &graph.params_,
+                                                       build.firstSlotOf[member]);
+                newOrder.push_back (member);
+            }
+
+            for (auto member : chain)
+                registerOf[member] = -1;
+
+            graph.audioSteps_.push_back ({ nullptr, program.get() });
+            graph.controlPrograms_.push_back (std::move (program));
+            build.stepMembers.push_back (chain);
+        }
+        else
+        {
+            graph.audioSteps_.push_back ({ build.nodeOf[unit], nullptr });
+            build.stepMembers.push_back ({ unit });
+            newOrder.push_back (unit);
+        }
+
+        for (auto e = successorOffsets[unit]; e < successorOffsets[unit + 1]; ++e)
+            if (--inDegree[unitEdges[e].second] == 0)
+                ready.push (unitEdges[e].second);
+    }
+
+    jassert (newOrder.size() == order.size());
+    order = std::move (newOrder);
+}
+
+std::vector<int> GraphCompiler::scheduleLevels (RuntimeGraph& graph, BuildState& build, int blockSize)
+{
+    auto& steps = graph.audioSteps_;
+
+    // A step's level is one past the deepest step it reads from; steps sharing a
+    // level are independent. Reads inside a fused program don't count.
+    std::vector<int> levelOf (build.nodeOf.size(), -1);
+    std::vector<int> stepLevel;
+    std::vector<double> levelWork, levelCritical;
+
+    for (auto& members : build.stepMembers)
+    {
+        int level = 0;
+        double cost = 0.0;
+        for (auto member : members)
+        {
+            for (auto& input : build.inputs[member])
+                if (input.source != Input::none && levelOf[input.source] >= 0)
+                    level = juce::jmax (level, levelOf[input.source] + 1);
+
+            cost += build.nodeOf[member]->estimateCost (blockSize);
+        }
+
+        for (auto member : members)
+            levelOf[member] = level;
+
+        stepLevel.push_back (level);
+        if (level >= static_cast<int> (levelWork.size()))
+        {
+            levelWork.resize (static_cast<size_t> (level) + 1, 0.0);
+            levelCritical.resize (static_cast<size_t> (level) + 1, 0.0);
+        }
+        levelWork[static_cast<size_t> (level)] += cost;
+        levelCritical[static_cast<size_t> (level)] = juce::jmax (levelCritical[static_cast<size_t> (level)], cost);
+    }
+
+    // With enough workers each level takes as long as its most expensive step
+    double saving = 0.0;
+    for (size_t l = 0; l < levelWork.size(); ++l)
+        saving += levelWork[l] - levelCritical[l];
+
+    if (saving < kMinParallelWork)
+    {
+        // Serial: ports are scheduled by position in the order
+        std::vector<int> positionOf (build.nodeOf.size(), -1);
+        for (int i = 0; i < static_cast<int> (build.audioOrder.size()); ++i)
+            positionOf[build.audioOrder[static_cast<size_t> (i)]] = i;
+        return positionOf;
+    }
+
+    // Regroup the steps level by level (stable, so each level keeps topological order)
+    std::vector<size_t> byLevel (steps.size());
+    std::iota (byLevel.begin(), byLevel.end(), size_t (0));
+    std::stable_sort (byLevel.begin(), byLevel.end(),
+                      [&] (size_t a, size_t b) { return stepLevel[a] < stepLevel[b]; });
+
+    std::vector<RuntimeGraph::AudioStep> newSteps;
+    std::vector<std::vector<uint32_t>> newMembers;
+    std::vector<uint32_t> newOrder;
+    newSteps.reserve (steps.size());
+    newMembers.reserve (steps.size());
+    newOrder.reserve (build.audioOrder.size());
+
+    for (auto i : byLevel)
+    {
+        auto level = stepLevel[i];
+        if (graph.levels_.empty() || static_cast<int> (graph.levels_.size()) - 1 < level)
+            graph.levels_.push_back ({ static_cast<int> (newSteps.size()), 0 });
+        ++graph.levels_.back().numSteps;
+
+        newSteps.push_back (steps[i]);
+        newOrder.insert (newOrder.end(), build.stepMembers[i].begin(), build.stepMembers[i].end());
+        newMembers.push_back (std::move (build.stepMembers[i]));
+    }
+
+    steps = std::move (newSteps);
+    build.stepMembers = std::move (newMembers);
+    build.audioOrder = std::move (newOrder);
+
+    return levelOf;
+}
+
+std::vector<RuntimeGraph::OutputStorage> GraphCompiler::layoutBuffers (RuntimeGraph& graph, const BuildState& build,
+                                                                       const std::vector<int>& slotOf, int blockSize)
+{
+    // Audio ports only need to survive from the step that writes them to the last
+    // audio step that reads them, so ports with disjoint lifetimes share storage,
+    // like registers. Buffer ports carry state between blocks, and ports read outside
+    // the audio step sequence (AudioInput, which the engine fills and reads back, or
+    // anything a visual node reads on the GL thread) get dedicated storage.
+    //
+    // Lifetimes are measured in schedule slots (slotOf): positions in the order when
+    // the graph runs serially, levels when it runs in parallel. Steps in one level
+    // run at the same time, so a port can only reuse a range freed by an earlier level.
+    struct PortLifetime
+    {
+        uint32_t node = 0;
+        int localIndex = 0;     // index among the node's outputs of the same type
+        bool isBuffer = false;
+        size_t numFloats = 0;   // requested size
+        size_t reserved = 0;    // aligned size of the arena range it occupies
+        int firstStep = 0;
+        int lastStep = 0;
+        bool dedicated = false;
+        size_t offset = 0;
+    };
+
+    blockSize = juce::jmax (1, blockSize);
+    const auto numNodes = static_cast<uint32_t> (build.nodeOf.size());
+
+    // Every node's outputs as a CSR range: the port of output o of node h is
+    // portOfOutput[outputOffsets[h] + o], or -1 if it has no storage
+    std::vector<size_t> outputOffsets (numNodes + 1, 0);
+    for (uint32_t h = 0; h < numNodes; ++h)
+        outputOffsets[h + 1] = outputOffsets[h] + (build.nodeOf[h] != nullptr ? static_cast<size_t> (build.nodeOf[h]->getNumOutputs()) : 0);
+    std::vector<int> portOfOutput (outputOffsets[numNodes], -1);
+
+    std::vector<PortLifetime> ports;
+    std::vector<RuntimeGraph::OutputStorage> storage (numNodes);
+    std::vector<bool> collected (numNodes, false);
+
+    auto collectPorts = [&] (uint32_t h, int step, bool dedicated)
+    {
+        collected[h] = true;
+
+        auto* node = build.nodeOf[h];
+        auto& result = storage[h];
+        auto& outputs = node->getOutputs();
+        for (int o = 0; o < static_cast<int> (outputs.size()); ++o)
+        {
+            PortLifetime port;
+            port.node = h;
+            port.firstStep = port.lastStep = step;
+
+            if (outputs[static_cast<size_t> (o)].type == PortType::Audio)
+            {
+                port.localIndex = static_cast<int> (result.audio.size());
+                port.numFloats = static_cast<size_t> (blockSize);
+                port.dedicated = dedicated;
+                result.audio.push_back (nullptr);
+            }
+            else if (outputs[static_cast<size_t> (o)].type == PortType::Buffer)
+            {
+                port.localIndex = static_cast<int> (result.buffers.size());
+                port.isBuffer = true;
+                port.numFloats = static_cast<size_t> (juce::jmax (0, node->getBufferOutputSize (port.localIndex)));
+                port.dedicated = true;
+                result.buffers.emplace_back();
+            }
+            else
+            {
+                continue;
+            }
+
+            port.reserved = BufferArena::alignSize (port.numFloats);
+            portOfOutput[outputOffsets[h] + static_cast<size_t> (o)] = static_cast<int> (ports.size());
+            ports.push_back (port);
+        }
+    };
+
+    for (auto h : build.visualOrder)
+        collectPorts (h, -1, true);
+
+    // Nodes left out of the process orders keep storage of their own, so their
+    // Buffer state survives until they're reconnected
+    for (uint32_t h = 0; h < numNodes; ++h)
+        if (build.nodeOf[h] != nullptr && ! collected[h] && slotOf[h] < 0)
+            collectPorts (h, -1, true);
+
+    for (auto h : build.audioOrder)
+        collectPorts (h, slotOf[h], build.nodeOf[h]->getTypeId() == "AudioInput");
+
+    // Extend each port's lifetime to its last reader
+    for (uint32_t consumer = 0; consumer < numNodes; ++consumer)
+    {
+        const auto step = slotOf[consumer];
+        for (auto& input : build.inputs[consumer])
+        {
+            if (input.source == Input::none || input.outputIndex < 0
+                || outputOffsets[input.source] + static_cast<size_t> (input.outputIndex) >= outputOffsets[input.source + 1])
+                continue;
+
+            auto index = portOfOutput[outputOffsets[input.source] + static_cast<size_t> (input.outputIndex)];
+            if (index < 0)
+                continue;
+
+            auto& port = ports[static_cast<size_t> (index)];
+            if (step < 0)
+                port.dedicated = true;
+            else
+                port.lastStep = juce::jmax (port.lastStep, step);
+        }
+    }
+
+    // Assign offsets in step order, recycling ranges whose last reader has already run
+    size_t top = 0;
+    std::multimap<size_t, size_t> freeRanges;   // reserved size → offset
+    std::vector<size_t> active;
+
+    for (size_t i = 0; i < ports.size(); ++i)
+    {
+        auto& port = ports[i];
+        if (port.dedicated)
+        {
+            port.offset = top;
+            top += port.reserved;
+            continue;
+        }
+
+        for (auto it = active.begin(); it != active.end();)
+        {
+            auto& other = ports[*it];
+            if (other.lastStep < port.firstStep)
+            {
+                freeRanges.emplace (other.reserved, other.offset);
+                it = active.erase (it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        auto range = freeRanges.lower_bound (port.reserved);
+        if (range != freeRanges.end())
+        {
+            port.offset = range->second;
+            port.reserved = range->first;
+            freeRanges.erase (range);
+        }
+        else
+        {
+            port.offset = top;
+            top += port.reserved;
+        }
+
+        active.push_back (i);
+    }
+
+    graph.arena_.allocate (top);
+    graph.blockSize_ = blockSize;
+
+    auto* base = graph.arena_.data();
+    for (auto& port : ports)
+    {
+        auto& result = storage[port.node];
+        if (port.isBuffer)
+            result.buffers[static_cast<size_t> (port.localIndex)] = { base + port.offset, port.numFloats };
+        else
+            result.audio[static_cast<size_t> (port.localIndex)] = base + port.offset;
+    }
+
+    return storage;
+}
+
+juce::String GraphCompiler::makePrepareKey (const NodeBase& node, const juce::NamedValueSet& params)
+{
+    juce::String key;
+    for (auto& param : node.getParams())
+    {
+        if (! param.requiresPrepare)
+            continue;
+
+        juce::Identifier name (param.name);
+        key << param.name << '=' << (params.contains (name) ? params[name] : param.defaultValue).toString() << ';';
+    }
+    return key;
 }
 
 } // namespace pf
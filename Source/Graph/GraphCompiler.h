@@ -1,56 +1,177 @@
 #pragma once
 #include "Graph/GraphModel.h"
+#include "Graph/GraphReclaimer.h"
 #include "Graph/RuntimeGraph.h"
 #include "Nodes/NodeRegistry.h"
 #include <atomic>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace pf
 {
 
 /**
- * Listens to GraphModel changes. On change:
- * 1. Validates graph (cycle check)
- * 2. Topological sort
- * 3. Builds new RuntimeGraph with pre-resolved connections
- * 4. Publishes via atomic pointer for audio thread
+ * Listens to structural GraphModel changes. On change, snapshots the model on the
+ * message thread and hands the snapshot to a background build job, which:
+ * 1. Takes the model's maintained topological order (a full sort and cycle
+ *    check run only if the model holds a cycle from a loaded patch)
+ * 2. Builds new RuntimeGraph with pre-resolved connections, reusing the live
+ *    instance of every node whose id, type and prepare-time params are unchanged,
+ *    runs one instance for pure nodes that duplicate each other, leaves nodes
+ *    that feed no sink out of the process orders, fuses chains of
+ *    scalar control nodes into ControlPrograms, groups the audio steps into
+ *    parallel levels when that pays off, and lays out all Audio/Buffer port
+ *    storage in one arena
+ * 3. Hands it back to the message thread, which publishes it through a
+ *    GraphReclaimer that frees superseded graphs once neither the audio nor the
+ *    GL thread still holds them
+ *
+ * Builds run one at a time. A newer edit cancels the build in progress at its
+ * next checkpoint, and results of superseded builds are dropped unpublished.
+ *
+ * Each node's params are resolved to a slot range in the graph's ParamStore.
+ * Param edits don't recompile: they are published into those slots, except for
+ * params flagged requiresPrepare. Layout changes are ignored.
  */
 class GraphCompiler : public GraphModel::Listener,
-                       private juce::Timer
+                       private juce::Timer,
+                       private juce::AsyncUpdater
 {
 public:
     explicit GraphCompiler (GraphModel& model);
     ~GraphCompiler() override;
 
     void graphChanged() override;
+    void nodeParamChanged (const juce::String& nodeId, const juce::Identifier& param) override;
 
-    /** Force recompile now (e.g. on initial load). */
+    /** Start a build now (e.g. on initial load), cancelling any build in progress.
+        The graph is published asynchronously when the build completes. */
     void compile();
 
-    /** Audio thread calls this to check for a new graph. Returns nullptr if no new graph. */
-    RuntimeGraph* consumeNewGraph()
-    {
-        return pendingGraph_.exchange (nullptr, std::memory_order_acquire);
-    }
+    /** Build and publish on the calling thread, waiting out any build in progress.
+        For tools that have no message loop to adopt results; returns false on error. */
+    bool compileNow();
+
+    /** True while a structural edit is waiting out the recompile debounce. */
+    bool isCompilePending() const { return compilePending_; }
+
+    /** Source of compiled graphs for the audio and GL threads. */
+    GraphReclaimer& getGraphs() { return graphs_; }
 
-    /** Get the last successfully compiled graph (for read-only access on GUI/GL thread). */
-    RuntimeGraph* getLatestGraph() const { return latestGraph_; }
+    /** Get the last successfully compiled graph (for read-only access on the GUI thread). */
+    RuntimeGraph* getLatestGraph() const { return graphs_.getLatest(); }
+
+    /** Frees superseded graphs the audio and GL threads have moved off. Call periodically. */
+    void collectRetiredGraphs() { graphs_.collect(); }
 
     bool hasError() const { return hasError_; }
     juce::String getErrorMessage() const { return errorMessage_; }
 
 private:
-    std::unique_ptr<RuntimeGraph> buildRuntimeGraph();
-    static bool hasCycle (const std::vector<juce::String>& nodeIds,
-                          const std::vector<Connection>& connections);
-    static std::vector<juce::String> topologicalSort (const std::vector<juce::String>& nodeIds,
-                                                       const std::vector<Connection>& connections);
+    /** A node instance owned by the latest graph, kept for reuse by the next compile. */
+    struct LiveNode
+    {
+        std::shared_ptr<NodeBase> node;
+        juce::ValueTree paramsTree;
+        juce::String prepareKey;
+    };
+
+    /** Everything a build reads from the model, copied on the message thread. Nodes
+        are addressed by dense handles (their topological position in the model)
+        rather than ids. */
+    struct GraphSnapshot
+    {
+        struct NodeEntry
+        {
+            juce::String id;
+            juce::String typeId;
+            juce::ValueTree paramsTree;   // the model's tree, only compared for identity by the build
+            juce::NamedValueSet params;   // its values when the snapshot was taken
+        };
+
+        struct Edge
+        {
+            uint32_t source = 0;
+            int sourcePort = 0;
+            uint32_t dest = 0;
+            int destPort = 0;
+        };
+
+        std::vector<NodeEntry> nodes;        // indexed by handle
+        std::vector<Edge> edges;             // grouped by source handle
+        std::vector<uint32_t> edgeOffsets;   // CSR: edges of node n are [edgeOffsets[n], edgeOffsets[n + 1])
+        bool isSorted = false;               // handles are a valid topological order
+        double sampleRate = 44100.0;
+        int blockSize = 512;
+    };
+
+    /** What a build job hands back to the message thread. */
+    struct BuildResult
+    {
+        uint32_t generation = 0;
+        std::unique_ptr<RuntimeGraph> graph;   // null if cancelled or invalid
+        juce::String errorMessage;
+
+        // Defaults of params missing from the model, written back when published
+        struct DefaultParam { juce::String nodeId; juce::Identifier name; juce::var value; };
+        std::vector<DefaultParam> defaults;
+
+        // Released on the message thread, since they hold model ValueTrees
+        std::shared_ptr<const GraphSnapshot> snapshot;
+        std::unordered_map<juce::String, LiveNode> releasedLiveNodes;
+    };
+
+    /** A node input resolved to the handle of the node it reads. */
+    struct Input
+    {
+        static constexpr uint32_t none = ~uint32_t (0);
+
+        uint32_t source = none;
+        int outputIndex = 0;
+
+        bool operator== (const Input&) const = default;
+    };
+
+    /** Per-handle state of one build, shared by its passes. */
+    struct BuildState
+    {
+        std::vector<NodeBase*> nodeOf;                    // null if the type couldn't be created
+        std::vector<int> firstSlotOf;                     // first param slot in the graph's store
+        std::vector<std::vector<Input>> inputs;           // each node's inputs, by port
+        std::vector<uint32_t> visualOrder;                // live visual nodes, in dependency order
+        std::vector<uint32_t> audioOrder;                 // live audio nodes, in schedule order
+        std::vector<std::vector<uint32_t>> stepMembers;   // nodes run by each of the graph's audio steps
+    };
+
+    std::shared_ptr<const GraphSnapshot> takeSnapshot() const;
+    void runBuild (std::shared_ptr<const GraphSnapshot> snapshot, uint32_t generation);
+    void adoptResult (BuildResult& result);
+    void handleAsyncUpdate() override;
+
+    std::unique_ptr<RuntimeGraph> buildRuntimeGraph (const GraphSnapshot& snapshot, uint32_t generation,
+                                                     BuildResult& result);
+    /** Points the inputs of pure duplicates' consumers at the first equivalent node.
+        Returns the handle that runs in place of each handle (itself if it isn't merged). */
+    static std::vector<uint32_t> mergeDuplicates (const GraphSnapshot& snapshot, const std::vector<uint32_t>& order,
+                                                  BuildState& build);
+    static std::vector<bool> findLiveNodes (const BuildState& build, const std::vector<uint32_t>& canonicalOf);
+    static void fuseControlChains (RuntimeGraph& graph, BuildState& build);
+    /** Returns each node's schedule slot (see layoutBuffers), or -1 outside the audio schedule. */
+    static std::vector<int> scheduleLevels (RuntimeGraph& graph, BuildState& build, int blockSize);
+    static std::vector<RuntimeGraph::OutputStorage> layoutBuffers (RuntimeGraph& graph, const BuildState& build,
+                                                                   const std::vector<int>& slotOf, int blockSize);
+
+    /** Work (see NodeBase::estimateCost) that parallel levels must take off the
+        critical path per block before waking the worker pool is worth it. */
+    static constexpr double kMinParallelWork = 16384.0;
+    static juce::String makePrepareKey (const NodeBase& node, const juce::NamedValueSet& params);
+    /** Fills order with node handles in dependency order: the handles themselves when
+        the snapshot is sorted, otherwise via Kahn's algorithm. Returns false on a cycle. */
+    static bool topologicalSort (const GraphSnapshot& snapshot, std::vector<uint32_t>& order);
 
     GraphModel& model_;
-    std::atomic<RuntimeGraph*> pendingGraph_ { nullptr };
-    RuntimeGraph* latestGraph_ = nullptr;
-    std::vector<std::unique_ptr<RuntimeGraph>> compiledGraphs_;
+    GraphReclaimer graphs_;
 
     double currentSampleRate_ = 44100.0;
     int currentBlockSize_ = 512;
@@ -60,6 +181,21 @@ private:
     bool hasError_ = false;
     juce::String errorMessage_;
     bool compilePending_ = false;
+    bool writingDefaults_ = false;
+
+    // Latest requested build; a job whose generation is behind stops at its next checkpoint
+    std::atomic<uint32_t> buildGeneration_ { 0 };
+
+    // Build thread only: instances of the last completed build, reused by the next one
+    std::unordered_map<juce::String, LiveNode> liveNodes_;   // by node id
+    double preparedSampleRate_ = 0.0;
+    int preparedBlockSize_ = 0;
+
+    juce::CriticalSection resultLock_;
+    std::vector<std::unique_ptr<BuildResult>> finishedBuilds_;
+
+    // Declared last so its thread is stopped before anything a job touches goes away
+    juce::ThreadPool buildPool_ { 1 };
 
 public:
     void setSampleRateAndBlockSize (double sr, int bs)
@@ -48,23 +48,25 @@ void GraphModel::removeNode (const juce::String& nodeId)
 
 bool GraphModel::addConnection (const Connection& conn)
 {
-    // Check for duplicate
+    // Reject duplicates, and inputs that are already connected
     for (auto& existing : getAllConnections())
-        if (existing == conn) return false;
-
-    // Check destination port isn't already connected
-    auto allConns = getAllConnections();
-    for (auto& existing : allConns)
-        if (existing.destNode == conn.destNode && existing.destPort == conn.destPort)
+        if (existing == conn || (existing.destNode == conn.destNode && existing.destPort == conn.destPort))
             return false;
 
+    // Finds cycles by searching only the nodes between the two ends in the order
+    auto& order = getTopologicalOrder();
+    if (order.isAcyclic() && ! topoOrder_.addEdge (conn.sourceNode, conn.destNode))
+        return false;
+
     juce::ValueTree c (IDs::CONNECTION);
     c.setProperty (IDs::sourceNode, conn.sourceNode, nullptr);
     c.setProperty (IDs::sourcePort, conn.sourcePort, nullptr);
     c.setProperty (IDs::destNode, conn.destNode, nullptr);
     c.setProperty (IDs::destPort, conn.destPort, nullptr);
 
+    connectionInserted_ = order.isAcyclic();
     graphTree_.getChildWithName (IDs::CONNECTIONS).addChild (c, -1, &undoManager_);
+    connectionInserted_ = false;
     return true;
 }
 
@@ -104,14 +106,44 @@ void GraphModel::setNodePosition (const juce::String& nodeId, float x, float y)
 
 juce::ValueTree GraphModel::getNodeTree (const juce::String& nodeId) const
 {
-    auto nodesTree = graphTree_.getChildWithName (IDs::NODES);
-    for (int i = 0; i < nodesTree.getNumChildren(); ++i)
+    auto index = getNodeIndex (nodeId);
+    return index >= 0 ? graphTree_.getChildWithName (IDs::NODES).getChild (index) : juce::ValueTree {};
+}
+
+int GraphModel::getNodeIndex (const juce::String& nodeId) const
+{
+    auto it = nodeIndex_.find (nodeId);
+    return it != nodeIndex_.end() ? it->second : -1;
+}
+
+bool GraphModel::isAcyclic() const
+{
+    return getTopologicalOrder().isAcyclic();
+}
+
+std::vector<juce::String> GraphModel::getNodeIdsInTopologicalOrder() const
+{
+    return getTopologicalOrder().getNodeIds();
+}
+
+int GraphModel::getTopologicalIndex (const juce::String& nodeId) const
+{
+    return getTopologicalOrder().getPosition (nodeId);
+}
+
+const TopologicalOrder& GraphModel::getTopologicalOrder() const
+{
+    if (topoOrderDirty_)
     {
-        auto node = nodesTree.getChild (i);
-        if (node[IDs::id] == nodeId)
-            return node;
+        std::vector<TopologicalOrder::Edge> edges;
+        for (auto& conn : getAllConnections())
+            edges.emplace_back (conn.sourceNode, conn.destNode);
+
+        topoOrder_.rebuild (getAllNodeIds(), edges);
+        topoOrderDirty_ = false;
     }
-    return {};
+
+    return topoOrder_;
 }
 
 juce::ValueTree GraphModel::getParamsTree (const juce::String& nodeId) const
@@ -207,6 +239,7 @@ bool GraphModel::loadFromJSON (const juce::String& json)
     if (! parsed.isObject()) return false;
 
     clear();
+    topoOrderDirty_ = true;   // sorted once when first needed, not edge by edge
 
     auto* root = parsed.getDynamicObject();
     if (! root) return false;
@@ -284,14 +317,82 @@ void GraphModel::clear()
     graphTree_.addChild (juce::ValueTree (IDs::CONNECTIONS), -1, nullptr);
     graphTree_.addListener (this);
     nextNodeId_ = 1;
+    nodeIndex_.clear();
+    topoOrder_.rebuild ({}, {});
+    topoOrderDirty_ = false;
     undoManager_.clearUndoHistory();
     notifyListeners();
 }
 
 //==============================================================================
-void GraphModel::valueTreeChildAdded (juce::ValueTree&, juce::ValueTree&) { notifyListeners(); }
-void GraphModel::valueTreeChildRemoved (juce::ValueTree&, juce::ValueTree&, int) { notifyListeners(); }
-void GraphModel::valueTreePropertyChanged (juce::ValueTree&, const juce::Identifier&) { notifyListeners(); }
+void GraphModel::valueTreeChildAdded (juce::ValueTree& parent, juce::ValueTree& child)
+{
+    if (parent.hasType (IDs::NODES))
+    {
+        // Nodes are normally appended; anything inserted before others shifts them along
+        auto index = parent.indexOf (child);
+        for (int i = index + 1; i < parent.getNumChildren(); ++i)
+            ++nodeIndex_[parent.getChild (i)[IDs::id].toString()];
+        nodeIndex_[child[IDs::id].toString()] = index;
+
+        if (! topoOrderDirty_)
+            topoOrder_.addNode (child[IDs::id].toString());
+    }
+    else if (parent.hasType (IDs::CONNECTIONS) && ! topoOrderDirty_ && ! connectionInserted_)
+    {
+        // Undo/redo: the edge was valid when it was first made, but if it no longer
+        // is, fall back to a full sort so the cycle is reported
+        if (! topoOrder_.isAcyclic() || ! topoOrder_.addEdge (child[IDs::sourceNode].toString(),
+                                                              child[IDs::destNode].toString()))
+            topoOrderDirty_ = true;
+    }
+
+    notifyListeners();
+}
+
+void GraphModel::valueTreeChildRemoved (juce::ValueTree& parent, juce::ValueTree& child, int index)
+{
+    if (parent.hasType (IDs::NODES))
+    {
+        nodeIndex_.erase (child[IDs::id].toString());
+        for (int i = index; i < parent.getNumChildren(); ++i)
+            --nodeIndex_[parent.getChild (i)[IDs::id].toString()];
+
+        if (! topoOrderDirty_)
+            topoOrder_.removeNode (child[IDs::id].toString());
+
+        // Removing a node may have broken a cycle
+        if (! topoOrder_.isAcyclic())
+            topoOrderDirty_ = true;
+    }
+    else if (parent.hasType (IDs::CONNECTIONS) && ! topoOrderDirty_)
+    {
+        topoOrder_.removeEdge (child[IDs::sourceNode].toString(), child[IDs::destNode].toString());
+
+        if (! topoOrder_.isAcyclic())
+            topoOrderDirty_ = true;
+    }
+
+    notifyListeners();
+}
+
+void GraphModel::valueTreePropertyChanged (juce::ValueTree& tree, const juce::Identifier& property)
+{
+    if (tree.hasType (IDs::PARAMS))
+    {
+        auto nodeId = tree.getParent()[IDs::id].toString();
+        listeners_.call ([&] (Listener& l) { l.nodeParamChanged (nodeId, property); });
+    }
+    else if (tree.hasType (IDs::NODE) && (property == IDs::x || property == IDs::y))
+    {
+        auto nodeId = tree[IDs::id].toString();
+        listeners_.call ([&] (Listener& l) { l.nodeLayoutChanged (nodeId); });
+    }
+    else
+    {
+        notifyListeners();
+    }
+}
 
 void GraphModel::notifyListeners()
 {
@@ -2,6 +2,8 @@
 #include <juce_data_structures/juce_data_structures.h>
 #include "Graph/PortTypes.h"
 #include "Graph/Connection.h"
+#include "Graph/TopologicalOrder.h"
+#include <unordered_map>
 
 namespace pf
 {
@@ -39,6 +41,8 @@ public:
     // Graph mutations (all undoable)
     juce::String addNode (const juce::String& typeId, float x, float y);
     void removeNode (const juce::String& nodeId);
+    /** Refuses duplicates, inputs that are already connected and edges that would
+        create a cycle. */
     bool addConnection (const Connection& conn);
     void removeConnection (const Connection& conn);
     void setNodeParam (const juce::String& nodeId, const juce::String& paramName, const juce::var& value);
@@ -47,11 +51,25 @@ public:
     //==============================================================================
     // Accessors
     juce::ValueTree getNodeTree (const juce::String& nodeId) const;
+
+    /** Position of a node among the Nodes children, or -1. Stable until the next
+        structural edit, so the compiler uses it as a dense node handle. O(1). */
+    int getNodeIndex (const juce::String& nodeId) const;
+
     juce::ValueTree getParamsTree (const juce::String& nodeId) const;
     std::vector<juce::String> getAllNodeIds() const;
     std::vector<Connection> getAllConnections() const;
     juce::String getNodeTypeId (const juce::String& nodeId) const;
 
+    /** False only if the graph was loaded or restored with a cycle in it. */
+    bool isAcyclic() const;
+
+    /** Node ids in dependency order (sources first), maintained incrementally. */
+    std::vector<juce::String> getNodeIdsInTopologicalOrder() const;
+
+    /** Position of a node in getNodeIdsInTopologicalOrder(), or -1. O(1). */
+    int getTopologicalIndex (const juce::String& nodeId) const;
+
     //==============================================================================
     // Serialization
     juce::String toJSON() const;
@@ -64,10 +82,16 @@ public:
 
     //==============================================================================
     // Listener support
+    //
+    // Changes are classified so listeners only do the work a change needs:
+    // structural edits (nodes/connections added or removed, graph replaced) go
+    // through graphChanged(), param edits and node moves have their own callbacks.
     struct Listener
     {
         virtual ~Listener() = default;
         virtual void graphChanged() = 0;
+        virtual void nodeParamChanged (const juce::String& /*nodeId*/, const juce::Identifier& /*param*/) {}
+        virtual void nodeLayoutChanged (const juce::String& /*nodeId*/) {}
     };
 
     void addListener (Listener* l)    { listeners_.add (l); }
@@ -80,11 +104,21 @@ private:
     void valueTreeChildRemoved (juce::ValueTree&, juce::ValueTree&, int) override;
     void valueTreePropertyChanged (juce::ValueTree&, const juce::Identifier&) override;
     void notifyListeners();
+    const TopologicalOrder& getTopologicalOrder() const;
 
     juce::ValueTree graphTree_;
     juce::UndoManager undoManager_;
     juce::ListenerList<Listener> listeners_;
     int nextNodeId_ = 1;
+
+    // id → index side table, kept in step with the Nodes children
+    std::unordered_map<juce::String, int> nodeIndex_;
+
+    // Kept in step with every structural edit; rebuilt from scratch lazily after a
+    // load, or once a cycle has been let in
+    mutable TopologicalOrder topoOrder_;
+    mutable bool topoOrderDirty_ = true;
+    bool connectionInserted_ = false;   // addConnection() already updated topoOrder_
 };
 
 } // namespace pf
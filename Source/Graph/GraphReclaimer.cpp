@@ -0,0 +1,89 @@
+#include "Graph/GraphReclaimer.h"
+#include <algorithm>
+
+namespace pf
+{
+
+GraphReclaimer::GraphReclaimer()
+{
+    for (auto& hazard : hazards_)
+        hazard.store (nullptr, std::memory_order_relaxed);
+}
+
+GraphReclaimer::~GraphReclaimer()
+{
+    // Readers must have stopped (and released) before the owner goes away
+   #if JUCE_DEBUG
+    for (auto& hazard : hazards_)
+        jassert (hazard.load() == nullptr || hazard.load() == latest_.get());
+   #endif
+
+    published_.store (nullptr);
+}
+
+void GraphReclaimer::publish (std::unique_ptr<RuntimeGraph> graph)
+{
+    published_.store (graph.get());
+
+    if (latest_ != nullptr)
+        retired_.push_back (std::move (latest_));
+
+    latest_ = std::move (graph);
+    collect();
+}
+
+int GraphReclaimer::collect()
+{
+    // A reader announces before validating against published_, and every store and
+    // load here is seq_cst: if no slot shows a retired graph now, no reader can pick
+    // it up later because published_ already points elsewhere.
+    auto isAnnounced = [this] (const RuntimeGraph* graph)
+    {
+        for (auto& hazard : hazards_)
+            if (hazard.load() == graph)
+                return true;
+        return false;
+    };
+
+    const auto before = retired_.size();
+    retired_.erase (std::remove_if (retired_.begin(), retired_.end(),
+                                    [&] (const std::unique_ptr<RuntimeGraph>& graph)
+                                    {
+                                        return ! isAnnounced (graph.get());
+                                    }),
+                    retired_.end());
+
+    return static_cast<int> (before - retired_.size());
+}
+
+RuntimeGraph* GraphReclaimer::acquire (Reader reader)
+{
+    auto& hazard = hazards_[static_cast<size_t> (reader) * 2];
+    auto& previous = hazards_[static_cast<size_t> (reader) * 2 + 1];
+    auto* graph = published_.load();
+
+    // Keep the graph we're leaving protected for one more cycle
+    auto* held = hazard.load();
+    previous.store (held != graph ? held : nullptr);
+
+    for (;;)
+    {
+        hazard.store (graph);
+
+        // Re-check: if a publish slipped in before the announcement, the graph may
+        // already be retired and unprotected
+        auto* current = published_.load();
+        if (current == graph)
+            return graph;
+
+        graph = current;
+    }
+}
+
+void GraphReclaimer::release (Reader reader)
+{
+    hazards_[static_cast<size_t> (reader) * 2].store (nullptr);
+    hazards_[static_cast<size_t> (reader) * 2 + 1].store (nullptr);
+}
+
+} // namespace pf
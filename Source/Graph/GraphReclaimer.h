@@ -0,0 +1,78 @@
+#pragma once
+#include "Graph/RuntimeGraph.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace pf
+{
+
+/**
+ * Owns every compiled RuntimeGraph and frees superseded ones as soon as no
+ * reader thread can still be using them.
+ *
+ * Each reader (audio thread, GL thread) announces the graph it holds in its own
+ * hazard slot before touching it, and validates that the graph is still the
+ * published one. The message thread retires the previous graph on publish and
+ * deletes retired graphs that no slot announces. Readers never block.
+ *
+ * A reader switching graphs keeps its previous graph announced until its next
+ * acquire(): node state (e.g. output storage) is moved over from the old graph
+ * while binding the new one, so the old one must outlive that step.
+ */
+class GraphReclaimer
+{
+public:
+    enum class Reader { Audio, Visual };
+    static constexpr int kNumReaders = 2;
+
+    GraphReclaimer();
+    ~GraphReclaimer();
+
+    //==============================================================================
+    // Message thread
+
+    /** Makes a graph current, retiring the previous one. */
+    void publish (std::unique_ptr<RuntimeGraph> graph);
+
+    /** Frees retired graphs that no reader announces. Returns how many were freed. */
+    int collect();
+
+    /** The most recently published graph (message thread only). */
+    RuntimeGraph* getLatest() const { return latest_.get(); }
+
+    /** Visits the latest graph and every retired graph still alive. */
+    template <typename Fn>
+    void forEachGraph (Fn&& fn) const
+    {
+        if (latest_ != nullptr)
+            fn (*latest_);
+
+        for (auto& graph : retired_)
+            fn (*graph);
+    }
+
+    //==============================================================================
+    // Reader threads (lock-free, wait-free in the absence of concurrent publishes)
+
+    /** Announces and returns the current graph. The graph stays valid for this reader
+        until its next acquire() or release(), and the graph it held before stays
+        valid until the acquire() after that. */
+    RuntimeGraph* acquire (Reader reader);
+
+    /** Drops this reader's announcement (e.g. when the device stops or the GL context closes). */
+    void release (Reader reader);
+
+private:
+    std::atomic<RuntimeGraph*> published_ { nullptr };
+    // Two slots per reader: [reader * 2] = held graph, [reader * 2 + 1] = previous graph
+    std::array<std::atomic<RuntimeGraph*>, kNumReaders * 2> hazards_;
+
+    std::unique_ptr<RuntimeGraph> latest_;
+    std::vector<std::unique_ptr<RuntimeGraph>> retired_;
+
+    JUCE_DECLARE_NON_COPYABLE (GraphReclaimer)
+};
+
+} // namespace pf
@@ -0,0 +1,95 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace pf
+{
+
+/**
+ * Recent processing times of one node, for profiling.
+ *
+ * The thread that runs the node records one sample per processBlock() or
+ * renderFrame() into a fixed ring, with relaxed atomic stores only, so this can
+ * stay on in release builds. Any thread can compute min/avg/p99 over the window;
+ * a sample overwritten while being read only skews that one reading.
+ */
+class NodeTimings
+{
+public:
+    static constexpr int kWindow = 256;
+
+    /** Budget visual nodes are measured against: one frame at 60 fps. */
+    static constexpr float kFrameBudgetMicros = 1.0e6f / 60.f;
+
+    struct Stats
+    {
+        float minMicros = 0.f;
+        float avgMicros = 0.f;
+        float p99Micros = 0.f;
+        float budgetMicros = 0.f;   // the block or frame duration the samples ran in
+        int numSamples = 0;
+        uint32_t numRecorded = 0;   // total ever recorded; unchanged means the node is idle
+
+        /** Average share of the block/frame budget, 0 if unknown. */
+        float getLoad() const { return budgetMicros > 0.f ? avgMicros / budgetMicros : 0.f; }
+    };
+
+    //==============================================================================
+    // Processing thread
+
+    void record (float micros, float budgetMicros)
+    {
+        auto index = count_.load (std::memory_order_relaxed);
+        samples_[index % kWindow].store (micros, std::memory_order_relaxed);
+        budget_.store (budgetMicros, std::memory_order_relaxed);
+        count_.store (index + 1, std::memory_order_release);
+    }
+
+    /** Converts a Time::getHighResolutionTicks() interval to microseconds. */
+    static float ticksToMicros (juce::int64 ticks)
+    {
+        static const double microsPerTick = 1.0e6 / static_cast<double> (juce::Time::getHighResolutionTicksPerSecond());
+        return static_cast<float> (static_cast<double> (ticks) * microsPerTick);
+    }
+
+    //==============================================================================
+    // Any thread
+
+    Stats getStats() const
+    {
+        Stats stats;
+        const auto count = count_.load (std::memory_order_acquire);
+        stats.numRecorded = count;
+        stats.numSamples = static_cast<int> (std::min<uint32_t> (count, kWindow));
+        stats.budgetMicros = budget_.load (std::memory_order_relaxed);
+        if (stats.numSamples == 0)
+            return stats;
+
+        std::array<float, kWindow> window;
+        double sum = 0.0;
+        for (int i = 0; i < stats.numSamples; ++i)
+        {
+            window[static_cast<size_t> (i)] = samples_[static_cast<size_t> (i)].load (std::memory_order_relaxed);
+            sum += window[static_cast<size_t> (i)];
+        }
+
+        auto end = window.begin() + stats.numSamples;
+        auto p99 = window.begin() + (stats.numSamples * 99) / 100;
+        std::nth_element (window.begin(), p99, end);
+
+        stats.p99Micros = *p99;
+        stats.minMicros = *std::min_element (window.begin(), end);
+        stats.avgMicros = static_cast<float> (sum / stats.numSamples);
+        return stats;
+    }
+
+private:
+    std::array<std::atomic<float>, kWindow> samples_ {};
+    std::atomic<float> budget_ { 0.f };
+    std::atomic<uint32_t> count_ { 0 };
+};
+
+} // namespace pf
@@ -0,0 +1,101 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace pf
+{
+
+/**
+ * Flat per-graph parameter storage, one slot per NodeParam.
+ *
+ * GraphCompiler assigns every node a contiguous range of slots and fills them from
+ * the model; the GUI publishes later edits into the same slots. The audio and GL
+ * threads read numeric params with a single relaxed load, so no locks, Identifier
+ * lookups or ValueTree access happen on the realtime paths.
+ *
+ * String params (file paths, shader source) also keep their text in a parallel
+ * slot guarded by a SpinLock. Only GL-thread nodes read those.
+ *
+ * Every store bumps the slot's version, so a reader can tell that a node's params
+ * were written without comparing their values.
+ */
+class ParamStore
+{
+public:
+    /** Message thread, before the store is shared with any other thread. */
+    void allocate (int numSlots)
+    {
+        numSlots_ = numSlots;
+        values_ = std::make_unique<std::atomic<float>[]> (static_cast<size_t> (numSlots));
+        versions_ = std::make_unique<std::atomic<uint32_t>[]> (static_cast<size_t> (numSlots));
+        strings_.assign (static_cast<size_t> (numSlots), {});
+
+        for (int i = 0; i < numSlots; ++i)
+        {
+            values_[i].store (0.f, std::memory_order_relaxed);
+            versions_[i].store (0, std::memory_order_relaxed);
+        }
+    }
+
+    int getNumSlots() const { return numSlots_; }
+
+    float load (int slot) const
+    {
+        jassert (juce::isPositiveAndBelow (slot, numSlots_));
+        return values_[slot].load (std::memory_order_relaxed);
+    }
+
+    void store (int slot, float value)
+    {
+        jassert (juce::isPositiveAndBelow (slot, numSlots_));
+        values_[slot].store (value, std::memory_order_relaxed);
+        versions_[slot].fetch_add (1, std::memory_order_release);
+    }
+
+    /** Changes whenever any slot in [firstSlot, firstSlot + numSlots) is stored to. */
+    uint64_t getVersion (int firstSlot, int numSlots) const
+    {
+        uint64_t version = 0;
+        for (int i = 0; i < numSlots; ++i)
+            version += versions_[firstSlot + i].load (std::memory_order_acquire);
+        return version;
+    }
+
+    juce::String loadString (int slot) const
+    {
+        jassert (juce::isPositiveAndBelow (slot, numSlots_));
+        const juce::SpinLock::ScopedLockType lock (stringLock_);
+        return strings_[static_cast<size_t> (slot)];
+    }
+
+    void storeString (int slot, const juce::String& value)
+    {
+        jassert (juce::isPositiveAndBelow (slot, numSlots_));
+        {
+            const juce::SpinLock::ScopedLockType lock (stringLock_);
+            strings_[static_cast<size_t> (slot)] = value;
+        }
+        versions_[slot].fetch_add (1, std::memory_order_release);
+    }
+
+    /** Writes a model value into a slot, keeping the text for string-typed params. */
+    void storeVar (int slot, const juce::var& value)
+    {
+        if (value.isString())
+            storeString (slot, value.toString());
+
+        store (slot, static_cast<float> (value));
+    }
+
+private:
+    std::unique_ptr<std::atomic<float>[]> values_;
+    std::unique_ptr<std::atomic<uint32_t>[]> versions_;
+    std::vector<juce::String> strings_;
+    mutable juce::SpinLock stringLock_;
+    int numSlots_ = 0;
+};
+
+} // namespace pf
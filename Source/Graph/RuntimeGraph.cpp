@@ -1,38 +1,269 @@
 #include "Graph/RuntimeGraph.h"
+#include "Audio/AudioWorkerPool.h"
+#include "Rendering/GPUTimer.h"
+#include <bit>
 
 namespace pf
 {
 
-void RuntimeGraph::processAudioBlock (int numSamples)
+void RuntimeGraph::processAudioBlock (int numSamples, AudioWorkerPool* pool)
 {
-    for (auto* node : audioProcessOrder_)
+    if (pool == nullptr || pool->getNumWorkers() == 0 || levels_.empty())
     {
-        if (! node->isBypassed())
-            node->processBlock (numSamples);
+        for (auto& step : audioSteps_)
+            runAudioStep (step, numSamples);
     }
+    else
+    {
+        struct LevelJob
+        {
+            RuntimeGraph* graph;
+            const AudioStep* steps;
+            int numSamples;
+        };
+
+        for (auto& level : levels_)
+        {
+            LevelJob job { this, audioSteps_.data() + level.firstStep, numSamples };
+            pool->parallelFor (level.numSteps,
+                               [] (void* context, int index)
+                               {
+                                   auto& j = *static_cast<LevelJob*> (context);
+                                   j.graph->runAudioStep (j.steps[index], j.numSamples);
+                               },
+                               &job);
+        }
+    }
+
+    for (auto& feed : bridgeFeeds_)
+        feed.bridge->push (feed.source->getSignalOutputValue (feed.outputIndex));
+
+    for (auto& feed : channelFeeds_)
+    {
+        if (feed.type == PortType::Audio)
+        {
+            feed.channel->push (feed.source->getAudioOutputBuffer (feed.localIndex), numSamples);
+        }
+        else
+        {
+            auto data = feed.source->getBufferOutputData (feed.localIndex);
+            feed.channel->push (data.data(), static_cast<int> (data.size()));
+        }
+    }
+}
+
+void RuntimeGraph::runAudioStep (const AudioStep& step, int numSamples)
+{
+    const auto budget = static_cast<float> (numSamples * 1.0e6 / sampleRate_);
+
+    if (step.program != nullptr)
+    {
+        auto start = juce::Time::getHighResolutionTicks();
+        step.program->run();
+        auto elapsed = NodeTimings::ticksToMicros (juce::Time::getHighResolutionTicks() - start);
+
+        // Members run as one program; share its time out evenly
+        auto& members = step.program->getMembers();
+        for (auto* member : members)
+            member->getTimings().record (elapsed / static_cast<float> (members.size()), budget);
+    }
+    else if (! step.node->isBypassed())
+    {
+        auto start = juce::Time::getHighResolutionTicks();
+        step.node->processBlock (numSamples);
+        step.node->getTimings().record (NodeTimings::ticksToMicros (juce::Time::getHighResolutionTicks() - start),
+                                        budget);
+    }
+}
+
+void RuntimeGraph::processVisualFrame (juce::OpenGLContext& gl, double frameSeconds, GPUTimer* gpuTimer)
+{
+    for (auto& bridge : signalBridges_)
+        bridge->latch();
+
+    for (auto& channel : bufferChannels_)
+        channel->latch();
+
+    for (auto& step : visualSteps_)
+    {
+        if (step.node->isBypassed() || ! needsRender (step))
+            continue;
+
+        if (gpuTimer != nullptr)
+            gpuTimer->beginNode (*step.node);
+
+        step.node->setFrameSeconds (static_cast<float> (frameSeconds));
+
+        auto start = juce::Time::getHighResolutionTicks();
+        step.node->renderFrame (gl);
+        step.node->getTimings().record (NodeTimings::ticksToMicros (juce::Time::getHighResolutionTicks() - start),
+                                        NodeTimings::kFrameBudgetMicros);
+
+        if (gpuTimer != nullptr)
+            gpuTimer->endNode();
+        step.rendered = true;
+        ++step.renderCount;
+    }
+}
+
+bool RuntimeGraph::needsRender (VisualStep& step)
+{
+    bool dirty = ! step.rendered || step.node->isTimeDependent();
+
+    auto paramVersion = params_.getVersion (step.firstParamSlot, step.numParams);
+    dirty |= paramVersion != step.paramVersion;
+    step.paramVersion = paramVersion;
+
+    // Every input is read so the next frame compares against current state
+    for (auto& input : step.inputs)
+    {
+        uint64_t seen = 0;
+        if (input.sourceStep >= 0)
+            seen = visualSteps_[static_cast<size_t> (input.sourceStep)].renderCount;
+        else if (auto* channel = step.node->getConnectedBufferChannel (input.index))
+            seen = channel->getSequence();
+        else
+            seen = std::bit_cast<uint32_t> (step.node->getConnectedVisualValue (input.index));
+
+        dirty |= seen != input.seen;
+        input.seen = seen;
+    }
+
+    return dirty;
 }
 
-void RuntimeGraph::processVisualFrame (juce::OpenGLContext& gl)
+void RuntimeGraph::buildVisualSteps()
 {
+    std::unordered_map<const NodeBase*, int> stepOf;
     for (auto* node : visualProcessOrder_)
+        stepOf[node] = static_cast<int> (stepOf.size());
+
+    visualSteps_.assign (visualProcessOrder_.size(), {});
+    for (auto& binding : visualBindings_)
     {
-        if (! node->isBypassed())
-            node->renderFrame (gl);
+        auto it = stepOf.find (binding.node);
+        if (it == stepOf.end())
+            continue; // dead
+
+        auto& step = visualSteps_[static_cast<size_t> (it->second)];
+        step.node = binding.node;
+        step.firstParamSlot = binding.firstParamSlot;
+        step.numParams = static_cast<int> (binding.node->getParams().size());
+
+        for (int i = 0; i < static_cast<int> (binding.inputs.size()); ++i)
+        {
+            auto* source = binding.inputs[static_cast<size_t> (i)].sourceNode;
+            if (source == nullptr)
+                continue;
+
+            auto sourceStep = stepOf.find (source);
+            step.inputs.push_back ({ i, sourceStep != stepOf.end() ? sourceStep->second : -1 });
+        }
     }
 }
 
-void RuntimeGraph::prepareToPlay (double sampleRate, int blockSize)
+void RuntimeGraph::bindAudioNodes()
 {
-    for (auto& node : nodes_)
-        node->prepareToPlay (sampleRate, blockSize);
+    applyBindings (audioBindings_);
 }
 
-NodeBase* RuntimeGraph::findNode (const juce::String& nodeId) const
+void RuntimeGraph::bindVisualNodes (const RuntimeGraph* previous)
+{
+    applyBindings (visualBindings_);
+
+    // Until the audio thread pushes into the new bridges and channels, they hold what
+    // the old ones last latched for the same output rather than 0 or an empty block
+    if (previous != nullptr)
+    {
+        for (auto& feed : bridgeFeeds_)
+        {
+            for (auto& old : previous->bridgeFeeds_)
+            {
+                if (old.outputIndex == feed.outputIndex && old.source->nodeId == feed.source->nodeId)
+                {
+                    feed.bridge->seed (old.bridge->getFrame().last);
+                    break;
+                }
+            }
+        }
+
+        for (auto& feed : channelFeeds_)
+        {
+            for (auto& old : previous->channelFeeds_)
+            {
+                if (old.type == feed.type && old.localIndex == feed.localIndex
+                    && old.source->nodeId == feed.source->nodeId)
+                {
+                    feed.channel->seed (old.channel->getData());
+                    break;
+                }
+            }
+        }
+    }
+
+    // Whatever the nodes last drew may have been for another graph
+    for (auto& step : visualSteps_)
+        step.rendered = false;
+}
+
+void RuntimeGraph::applyBindings (const std::vector<NodeBinding>& bindings)
 {
-    for (auto& node : nodes_)
-        if (node->nodeId == nodeId)
-            return node.get();
+    for (auto& binding : bindings)
+    {
+        for (int i = 0; i < static_cast<int> (binding.inputs.size()); ++i)
+        {
+            auto& conn = binding.inputs[static_cast<size_t> (i)];
+            binding.node->setInputConnection (i, conn.sourceNode, conn.sourceOutputIndex, conn.bridge, conn.channel);
+        }
+
+        binding.node->bindParams (&params_, binding.firstParamSlot);
+        binding.node->bindOutputs (binding.outputs.audio, binding.outputs.buffers);
+        binding.node->setBypassed (binding.bypassed);
+    }
+}
+
+void RuntimeGraph::publishParam (const juce::String& nodeId, int paramIndex, const juce::var& value)
+{
+    auto* slots = findNodeSlots (nodeId);
+    if (slots != nullptr && paramIndex >= 0 && paramIndex < slots->numParams)
+        params_.storeVar (slots->firstParamSlot + paramIndex, value);
+}
+
+const NodeParam* RuntimeGraph::publishParam (const juce::String& nodeId, const juce::String& paramName,
+                                             const juce::var& value)
+{
+    auto* slots = findNodeSlots (nodeId);
+    if (slots == nullptr)
+        return nullptr;
+
+    auto& params = slots->node->getParams();
+    for (int i = 0; i < slots->numParams; ++i)
+    {
+        if (params[static_cast<size_t> (i)].name == paramName)
+        {
+            params_.storeVar (slots->firstParamSlot + i, value);
+            return &params[static_cast<size_t> (i)];
+        }
+    }
     return nullptr;
 }
 
+NodeTimings::Stats RuntimeGraph::getNodeTimings (const juce::String& nodeId) const
+{
+    auto* node = findNode (nodeId);
+    return node != nullptr ? node->getTimings().getStats() : NodeTimings::Stats {};
+}
+
+const RuntimeGraph::NodeSlots* RuntimeGraph::findNodeSlots (const juce::String& nodeId) const
+{
+    auto it = nodeSlots_.find (nodeId);
+    return it != nodeSlots_.end() ? &it->second : nullptr;
+}
+
+NodeBase* RuntimeGraph::findNode (const juce::String& nodeId) const
+{
+    auto* slots = findNodeSlots (nodeId);
+    return slots != nullptr ? slots->node : nullptr;
+}
+
 } // namespace pf
@@ -1,43 +1,218 @@
 #pragma once
 #include "Nodes/NodeBase.h"
 #include "Graph/Connection.h"
+#include "Graph/ParamStore.h"
+#include "Graph/BufferArena.h"
+#include "Graph/ControlProgram.h"
+#include "Graph/SignalBridge.h"
+#include "Graph/BufferChannel.h"
+#include <cstdint>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace pf
 {
 
+class AudioWorkerPool;
+class GPUTimer;
+
 /**
  * Immutable compiled execution plan, consumed by AudioEngine and VisualCanvas.
  * Built by GraphCompiler, published via atomic pointer swap.
+ *
+ * Node instances are shared with the previous graph when the compiler could reuse
+ * them, so their wiring is not written at build time. Each graph instead carries a
+ * binding per node which the owning thread applies when it adopts the graph.
+ *
+ * Param values live in the graph's ParamStore, and Audio/Buffer port data in its
+ * BufferArena; nodes are bound to both along with their inputs.
+ *
+ * When the compiler estimates that independent branches carry enough work, the
+ * audio steps are grouped into dependency levels: steps within a level don't read
+ * each other's outputs and run concurrently on an AudioWorkerPool.
+ *
+ * Signal outputs read by visual nodes cross threads through SignalBridges, and
+ * Audio and Buffer outputs through BufferChannels, one per edge: the audio side
+ * pushes after each block, the visual side latches once per frame.
+ *
+ * Each node's processBlock()/renderFrame() wall time is recorded into its
+ * NodeTimings ring (a fused program's time is split among its members). With a
+ * GPUTimer, visual nodes also get the GPU time of their renderFrame().
+ *
+ * Visual nodes re-render only when needed: each tracks its param versions, the
+ * render count of the visual nodes it reads and the values of its other inputs.
+ *
+ * Pure nodes that duplicate one another (same type, params and inputs) run once:
+ * consumers of the duplicates are wired to the instance that runs, and the
+ * duplicates stay in the graph, unscheduled, under their own ids.
  */
 class RuntimeGraph
 {
 public:
     RuntimeGraph() = default;
 
-    /** Process all audio/control-rate nodes in topological order. */
-    void processAudioBlock (int numSamples);
+    /** Process all audio/control-rate nodes in topological order, running fused
+        chains of scalar nodes as one ControlProgram each. With a pool, and if the
+        graph was scheduled for it, the steps of each level run in parallel. */
+    void processAudioBlock (int numSamples, AudioWorkerPool* pool = nullptr);
+
+    /** Latch the signal bridges and buffer channels, then process all visual nodes in topological order,
+        skipping those that aren't time-dependent while their params and inputs are
+        unchanged (their last output stands). Animated nodes advance by frameSeconds.
+        With a timer, every node rendered is bracketed by a GPU time query. */
+    void processVisualFrame (juce::OpenGLContext& gl, double frameSeconds, GPUTimer* gpuTimer = nullptr);
+
+    /** Audio thread: wire the audio nodes for this graph. Call once when adopting it. */
+    void bindAudioNodes();
+
+    /** GL thread: wire the visual nodes for this graph. Call once when adopting it,
+        passing the graph this thread rendered before (still valid, see GraphReclaimer)
+        so the new bridges and channels start from what the old ones latched. */
+    void bindVisualNodes (const RuntimeGraph* previous = nullptr);
 
-    /** Process all visual nodes in topological order. */
-    void processVisualFrame (juce::OpenGLContext& gl);
+    /** GUI thread: write an edited param value into this graph's slot for it.
+        Does nothing if the node isn't part of this graph. */
+    void publishParam (const juce::String& nodeId, int paramIndex, const juce::var& value);
 
-    /** Prepare all nodes for playback. */
-    void prepareToPlay (double sampleRate, int blockSize);
+    /** GUI thread: as above, finding the param by name on this graph's instance of
+        the node, which after a preset load may not be the type the id has now.
+        Returns the param written, or nullptr if this graph has no such param. */
+    const NodeParam* publishParam (const juce::String& nodeId, const juce::String& paramName, const juce::var& value);
+
+    /** A node of this graph and the contiguous range of its params in the store. */
+    struct NodeSlots
+    {
+        NodeBase* node = nullptr;
+        int firstParamSlot = 0;
+        int numParams = 0;
+        bool merged = false;   // takes part in a merge of pure duplicates, as the instance
+                               // that runs or as one whose consumers it took over
+    };
+
+    /** The node with this id and its param slots, or nullptr if it isn't part of
+        this graph. A hash lookup, cheap enough for every param edit. */
+    const NodeSlots* findNodeSlots (const juce::String& nodeId) const;
 
     //==============================================================================
     // Accessors used by AudioEngine / VisualCanvas
     NodeBase* findNode (const juce::String& nodeId) const;
     const std::vector<NodeBase*>& getAudioProcessOrder() const  { return audioProcessOrder_; }
     const std::vector<NodeBase*>& getVisualProcessOrder() const { return visualProcessOrder_; }
-    const std::vector<std::unique_ptr<NodeBase>>& getAllNodes() const { return nodes_; }
+    const std::vector<std::shared_ptr<NodeBase>>& getAllNodes() const { return nodes_; }
+
+    /** Largest number of samples processAudioBlock() accepts (the Audio port size). */
+    int getBlockSize() const { return blockSize_; }
+
+    /** Total floats backing every Audio and Buffer port. */
+    size_t getArenaSize() const { return arena_.size(); }
+
+    /** Processing-time stats of a node (see NodeTimings), or empty stats if it isn't
+        part of this graph. Recorded on every block/frame the node runs. */
+    NodeTimings::Stats getNodeTimings (const juce::String& nodeId) const;
+
+    /** Whether the compiler scheduled the audio steps for parallel execution. */
+    bool isParallel() const { return ! levels_.empty(); }
 
 private:
     friend class GraphCompiler;
 
-    std::vector<std::unique_ptr<NodeBase>> nodes_;
+    /** Arena storage for one node's outputs, indexed like NodeBase's per-type storage. */
+    struct OutputStorage
+    {
+        std::vector<float*> audio;
+        std::vector<std::span<float>> buffers;
+    };
+
+    struct NodeBinding
+    {
+        NodeBase* node = nullptr;
+        std::vector<NodeBase::InputConnection> inputs;
+        bool bypassed = false;
+        int firstParamSlot = 0;
+        OutputStorage outputs;
+    };
+
+    /** One entry of the audio schedule: either a node or a fused program. */
+    struct AudioStep
+    {
+        NodeBase* node = nullptr;
+        ControlProgram* program = nullptr;
+    };
+
+    /** A run of consecutive audioSteps_ that don't depend on each other. */
+    struct Level
+    {
+        int firstStep = 0;
+        int numSteps = 0;
+    };
+
+    /** A Signal output pushed into a bridge after every audio block. */
+    struct BridgeFeed
+    {
+        NodeBase* source = nullptr;
+        int outputIndex = 0;
+        SignalBridge* bridge = nullptr;
+    };
+
+    /** An Audio or Buffer output copied into a channel after every audio block. */
+    struct ChannelFeed
+    {
+        NodeBase* source = nullptr;
+        PortType type = PortType::Buffer;
+        int localIndex = 0;   // among the source's outputs of that type
+        BufferChannel* channel = nullptr;
+    };
+
+    /** Change tracking for one visual node (GL thread only). */
+    struct VisualStep
+    {
+        struct Input
+        {
+            int index = 0;
+            int sourceStep = -1;    // the visual node it reads, or -1 to compare values/blocks
+            uint64_t seen = 0;      // render count or value bits last read
+        };
+
+        NodeBase* node = nullptr;
+        int firstParamSlot = 0;
+        int numParams = 0;
+        std::vector<Input> inputs;  // connected inputs only
+        uint64_t paramVersion = 0;
+        uint64_t renderCount = 0;
+        bool rendered = false;
+    };
+
+    /** Called by the compiler once the visual bindings are final. */
+    void buildVisualSteps();
+    bool needsRender (VisualStep& step);
+
+    void applyBindings (const std::vector<NodeBinding>& bindings);
+    void runAudioStep (const AudioStep& step, int numSamples);
+
+    std::vector<std::shared_ptr<NodeBase>> nodes_;
     std::vector<NodeBase*> audioProcessOrder_;
     std::vector<NodeBase*> visualProcessOrder_;
+    std::vector<NodeBinding> audioBindings_;
+    std::vector<NodeBinding> visualBindings_;
+    std::vector<VisualStep> visualSteps_;
+
+    std::vector<AudioStep> audioSteps_;
+    std::vector<std::unique_ptr<ControlProgram>> controlPrograms_;
+    std::vector<Level> levels_;   // empty: run audioSteps_ serially
+
+    std::vector<std::unique_ptr<SignalBridge>> signalBridges_;
+    std::vector<BridgeFeed> bridgeFeeds_;
+
+    std::vector<std::unique_ptr<BufferChannel>> bufferChannels_;
+    std::vector<ChannelFeed> channelFeeds_;
+
+    ParamStore params_;
+    std::unordered_map<juce::String, NodeSlots> nodeSlots_;  // nodeId → instance and param slots
+
+    BufferArena arena_;
+    int blockSize_ = 0;
+    double sampleRate_ = 44100.0;
 };
 
 } // namespace pf
@@ -0,0 +1,119 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+namespace pf
+{
+
+/**
+ * Carries one Signal output from the audio thread to a visual node on the GL thread.
+ *
+ * The audio thread pushes the output's value after every processed block into a
+ * ring of entries; each entry is guarded by its own sequence number, so neither
+ * side ever blocks. Once per frame the GL thread latches every entry written since
+ * the previous frame into a Frame (last, peak), so a transient that lasted a single
+ * block between two frames still shows up in the peak.
+ *
+ * GraphCompiler inserts one bridge per Signal→Visual edge; the bridge has exactly
+ * one writer and one reader.
+ */
+class SignalBridge
+{
+public:
+    static constexpr int kCapacity = 64;   // ~4 frames of 256-sample blocks at 48 kHz
+
+    /** Statistics over the blocks pushed between two latches. */
+    struct Frame
+    {
+        float last = 0.f;
+        float peak = 0.f;     // value with the largest magnitude (sign kept)
+        int numBlocks = 0;    // 0 if the audio thread pushed nothing this frame
+    };
+
+    //==============================================================================
+    // Audio thread
+
+    void push (float value)
+    {
+        auto index = writeCount_.load (std::memory_order_relaxed);
+        auto& entry = entries_[static_cast<size_t> (index % kCapacity)];
+
+        entry.sequence.store (kWriting, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+        entry.value.store (value, std::memory_order_relaxed);
+        entry.sequence.store (index, std::memory_order_release);
+
+        writeCount_.store (index + 1, std::memory_order_release);
+    }
+
+    //==============================================================================
+    // GL thread
+
+    /** Folds everything pushed since the last latch into the current Frame. With
+        nothing new, the frame holds the last value. */
+    void latch()
+    {
+        const auto written = writeCount_.load (std::memory_order_acquire);
+        auto first = juce::jmax (readCount_, written > uint64_t (kCapacity) ? written - uint64_t (kCapacity) : uint64_t (0));
+
+        Frame next;
+        next.last = next.peak = frame_.last;
+
+        for (auto index = first; index < written; ++index)
+        {
+            float value = 0.f;
+            if (! read (index, value))
+                continue;   // overwritten while we were behind
+
+            if (next.numBlocks == 0 || std::abs (value) > std::abs (next.peak))
+                next.peak = value;
+
+            next.last = value;
+            ++next.numBlocks;
+        }
+
+        readCount_ = written;
+        frame_ = next;
+    }
+
+    const Frame& getFrame() const { return frame_; }
+
+    /** Starts the frame at a value the audio thread hasn't pushed yet: the one the
+        bridge this replaces, in the previous graph, last latched. */
+    void seed (float value)
+    {
+        frame_.last = frame_.peak = value;
+    }
+
+private:
+    static constexpr uint64_t kWriting = ~uint64_t (0);
+
+    struct Entry
+    {
+        std::atomic<uint64_t> sequence { kWriting };
+        std::atomic<float> value { 0.f };
+    };
+
+    bool read (uint64_t index, float& value) const
+    {
+        auto& entry = entries_[static_cast<size_t> (index % kCapacity)];
+        if (entry.sequence.load (std::memory_order_acquire) != index)
+            return false;
+
+        value = entry.value.load (std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_acquire);
+        return entry.sequence.load (std::memory_order_relaxed) == index;
+    }
+
+    std::array<Entry, kCapacity> entries_;
+    std::atomic<uint64_t> writeCount_ { 0 };
+
+    // GL thread only
+    uint64_t readCount_ = 0;
+    Frame frame_;
+};
+
+} // namespace pf
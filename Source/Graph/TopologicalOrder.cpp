@@ -0,0 +1,242 @@
+#include "Graph/TopologicalOrder.h"
+#include <algorithm>
+
+namespace pf
+{
+
+bool TopologicalOrder::rebuild (const std::vector<juce::String>& nodeIds, const std::vector<Edge>& edges)
+{
+    vertices_.clear();
+    freeVertices_.clear();
+    vertexOf_.clear();
+    order_.clear();
+
+    vertices_.reserve (nodeIds.size());
+    vertexOf_.reserve (nodeIds.size());
+    for (auto& id : nodeIds)
+        allocateVertex (id);
+
+    for (auto& [source, dest] : edges)
+    {
+        auto from = findVertex (source);
+        auto to = findVertex (dest);
+        if (from < 0 || to < 0)
+            continue;
+
+        vertices_[static_cast<size_t> (from)].outputs.push_back (to);
+        vertices_[static_cast<size_t> (to)].inputs.push_back (from);
+    }
+
+    // Kahn's algorithm; vertices on a cycle never reach in-degree 0
+    std::vector<int> inDegree (vertices_.size());
+    for (size_t v = 0; v < vertices_.size(); ++v)
+        inDegree[v] = static_cast<int> (vertices_[v].inputs.size());
+
+    order_.reserve (vertices_.size());
+    for (int v = 0; v < static_cast<int> (vertices_.size()); ++v)
+        if (inDegree[static_cast<size_t> (v)] == 0)
+            order_.push_back (v);
+
+    for (size_t i = 0; i < order_.size(); ++i)
+        for (auto next : vertices_[static_cast<size_t> (order_[i])].outputs)
+            if (--inDegree[static_cast<size_t> (next)] == 0)
+                order_.push_back (next);
+
+    acyclic_ = order_.size() == vertices_.size();
+
+    // Still give every node a position, so handles stay dense
+    if (! acyclic_)
+        for (int v = 0; v < static_cast<int> (vertices_.size()); ++v)
+            if (inDegree[static_cast<size_t> (v)] > 0)
+                order_.push_back (v);
+
+    for (int position = 0; position < static_cast<int> (order_.size()); ++position)
+        vertices_[static_cast<size_t> (order_[static_cast<size_t> (position)])].position = position;
+
+    return acyclic_;
+}
+
+void TopologicalOrder::addNode (const juce::String& nodeId)
+{
+    if (findVertex (nodeId) < 0)
+        allocateVertex (nodeId);
+}
+
+void TopologicalOrder::removeNode (const juce::String& nodeId)
+{
+    auto v = findVertex (nodeId);
+    if (v < 0)
+        return;
+
+    auto& vertex = vertices_[static_cast<size_t> (v)];
+    auto eraseOne = [] (std::vector<int>& list, int value)
+    {
+        auto it = std::find (list.begin(), list.end(), value);
+        if (it != list.end())
+            list.erase (it);
+    };
+
+    for (auto next : vertex.outputs)
+        eraseOne (vertices_[static_cast<size_t> (next)].inputs, v);
+    for (auto previous : vertex.inputs)
+        eraseOne (vertices_[static_cast<size_t> (previous)].outputs, v);
+
+    // Close the gap so positions stay dense
+    order_.erase (order_.begin() + vertex.position);
+    for (auto position = static_cast<size_t> (vertex.position); position < order_.size(); ++position)
+        vertices_[static_cast<size_t> (order_[position])].position = static_cast<int> (position);
+
+    vertexOf_.erase (nodeId);
+    vertex = Vertex {};
+    freeVertices_.push_back (v);
+}
+
+bool TopologicalOrder::addEdge (const juce::String& source, const juce::String& dest)
+{
+    auto from = findVertex (source);
+    auto to = findVertex (dest);
+    if (from < 0 || to < 0)
+        return false;
+
+    if (from == to)
+        return false;
+
+    const auto lower = vertices_[static_cast<size_t> (to)].position;
+    const auto upper = vertices_[static_cast<size_t> (from)].position;
+
+    // Pointing backwards: only nodes positioned between the two ends can be affected
+    if (acyclic_ && lower < upper)
+    {
+        std::vector<int> forward, backward;
+        if (! search (to, true, lower, upper, from, forward))
+            return false;
+
+        search (from, false, lower, upper, -1, backward);
+
+        auto byPosition = [this] (int a, int b)
+        {
+            return vertices_[static_cast<size_t> (a)].position < vertices_[static_cast<size_t> (b)].position;
+        };
+        std::sort (forward.begin(), forward.end(), byPosition);
+        std::sort (backward.begin(), backward.end(), byPosition);
+
+        // Reuse the positions both sets occupy: everything that leads to source,
+        // then everything dest leads to, each keeping its relative order
+        std::vector<int> positions;
+        positions.reserve (forward.size() + backward.size());
+        for (auto v : backward) positions.push_back (vertices_[static_cast<size_t> (v)].position);
+        for (auto v : forward)  positions.push_back (vertices_[static_cast<size_t> (v)].position);
+        std::sort (positions.begin(), positions.end());
+
+        size_t next = 0;
+        for (auto* set : { &backward, &forward })
+        {
+            for (auto v : *set)
+            {
+                auto position = positions[next++];
+                vertices_[static_cast<size_t> (v)].position = position;
+                order_[static_cast<size_t> (position)] = v;
+            }
+        }
+    }
+
+    vertices_[static_cast<size_t> (from)].outputs.push_back (to);
+    vertices_[static_cast<size_t> (to)].inputs.push_back (from);
+    return true;
+}
+
+void TopologicalOrder::removeEdge (const juce::String& source, const juce::String& dest)
+{
+    auto from = findVertex (source);
+    auto to = findVertex (dest);
+    if (from < 0 || to < 0)
+        return;
+
+    auto& outputs = vertices_[static_cast<size_t> (from)].outputs;
+    auto& inputs = vertices_[static_cast<size_t> (to)].inputs;
+
+    auto out = std::find (outputs.begin(), outputs.end(), to);
+    auto in = std::find (inputs.begin(), inputs.end(), from);
+    if (out != outputs.end() && in != inputs.end())
+    {
+        outputs.erase (out);
+        inputs.erase (in);
+    }
+}
+
+int TopologicalOrder::getPosition (const juce::String& nodeId) const
+{
+    auto v = findVertex (nodeId);
+    return v >= 0 ? vertices_[static_cast<size_t> (v)].position : -1;
+}
+
+std::vector<juce::String> TopologicalOrder::getNodeIds() const
+{
+    std::vector<juce::String> ids;
+    ids.reserve (order_.size());
+    for (auto v : order_)
+        ids.push_back (vertices_[static_cast<size_t> (v)].id);
+    return ids;
+}
+
+//==============================================================================
+int TopologicalOrder::findVertex (const juce::String& nodeId) const
+{
+    auto it = vertexOf_.find (nodeId);
+    return it != vertexOf_.end() ? it->second : -1;
+}
+
+int TopologicalOrder::allocateVertex (const juce::String& nodeId)
+{
+    int v;
+    if (! freeVertices_.empty())
+    {
+        v = freeVertices_.back();
+        freeVertices_.pop_back();
+    }
+    else
+    {
+        v = static_cast<int> (vertices_.size());
+        vertices_.emplace_back();
+    }
+
+    auto& vertex = vertices_[static_cast<size_t> (v)];
+    vertex.id = nodeId;
+    vertex.position = static_cast<int> (order_.size());
+    order_.push_back (v);
+    vertexOf_[nodeId] = v;
+    return v;
+}
+
+bool TopologicalOrder::search (int start, bool forward, int lower, int upper, int stop,
+                               std::vector<int>& found)
+{
+    const auto mark = ++visitMark_;
+    std::vector<int> stack { start };
+    vertices_[static_cast<size_t> (start)].visited = mark;
+
+    while (! stack.empty())
+    {
+        auto v = stack.back();
+        stack.pop_back();
+        found.push_back (v);
+
+        auto& vertex = vertices_[static_cast<size_t> (v)];
+        for (auto next : forward ? vertex.outputs : vertex.inputs)
+        {
+            if (next == stop)
+                return false;
+
+            auto& neighbour = vertices_[static_cast<size_t> (next)];
+            if (neighbour.visited != mark && neighbour.position >= lower && neighbour.position <= upper)
+            {
+                neighbour.visited = mark;
+                stack.push_back (next);
+            }
+        }
+    }
+
+    return true;
+}
+
+} // namespace pf
@@ -0,0 +1,77 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace pf
+{
+
+/**
+ * A topological order of the patch's nodes, kept up to date edge by edge.
+ *
+ * Inserting an edge uses the Pearce–Kelly algorithm: if the edge already points
+ * forward in the order nothing moves, otherwise only the nodes whose positions lie
+ * between its endpoints are searched and reordered. An edge that would close a
+ * cycle is found by the same search and refused. Nodes are appended at the end;
+ * removing a node or an edge never invalidates the order.
+ *
+ * Positions are dense (0..N-1), so they double as node handles for a compile.
+ * Parallel edges between the same two nodes (different ports) are counted.
+ */
+class TopologicalOrder
+{
+public:
+    using Edge = std::pair<juce::String, juce::String>;   // source, dest
+
+    /** Replaces everything with these nodes and edges, sorted from scratch.
+        Returns false if the edges contain a cycle; the order is then arbitrary
+        and isAcyclic() stays false until the next rebuild. */
+    bool rebuild (const std::vector<juce::String>& nodeIds, const std::vector<Edge>& edges);
+
+    void addNode (const juce::String& nodeId);
+    void removeNode (const juce::String& nodeId);
+
+    /** Inserts source → dest, reordering the affected range if needed. Returns false
+        and changes nothing if the edge would create a cycle. While the order is
+        already cyclic the edge is recorded as is. */
+    bool addEdge (const juce::String& source, const juce::String& dest);
+    void removeEdge (const juce::String& source, const juce::String& dest);
+
+    bool isAcyclic() const { return acyclic_; }
+
+    /** The node's position in the order, or -1. */
+    int getPosition (const juce::String& nodeId) const;
+
+    /** Node ids in dependency order (sources first). */
+    std::vector<juce::String> getNodeIds() const;
+
+    int getNumNodes() const { return static_cast<int> (order_.size()); }
+
+private:
+    struct Vertex
+    {
+        juce::String id;
+        int position = -1;            // -1 while the slot is free
+        std::vector<int> outputs;     // vertex indices, one entry per edge
+        std::vector<int> inputs;
+        uint32_t visited = 0;
+    };
+
+    int findVertex (const juce::String& nodeId) const;
+    int allocateVertex (const juce::String& nodeId);
+
+    /** Collects vertices reachable from start along outputs (forward) or inputs,
+        staying within positions [lower, upper]. Returns false if it reaches stop. */
+    bool search (int start, bool forward, int lower, int upper, int stop, std::vector<int>& found);
+
+    std::vector<Vertex> vertices_;
+    std::vector<int> freeVertices_;
+    std::unordered_map<juce::String, int> vertexOf_;
+    std::vector<int> order_;          // vertex index at each position
+    uint32_t visitMark_ = 0;
+    bool acyclic_ = true;
+};
+
+} // namespace pf
@@ -205,19 +205,21 @@ MainComponent::MainComponent()
     layoutManager_.setItemLayout (2, 150, -1.0, -0.30);   // visual canvas: 30%
     layoutManager_.setItemLayout (3, 180, 300, 220);       // inspector: fixed
 
+    // Audio and GL threads pick up compiled graphs directly from the compiler
+    audioEngine_.setGraphSource (&graphCompiler_.getGraphs());
+    visualCanvas_.setGraphSource (&graphCompiler_.getGraphs());
+
     // Audio setup
     audioEngine_.initialise();
     cachedAudioSampleRate_ = audioEngine_.getSampleRate();
     cachedAudioBlockSize_ = audioEngine_.getBlockSize();
     graphCompiler_.setSampleRateAndBlockSize (cachedAudioSampleRate_, cachedAudioBlockSize_);
 
-    // Wire up analysis FIFO to visual canvas
-    visualCanvas_.setAnalysisFIFO (&audioEngine_.getAnalysisFIFO());
-
     // Initial compile
     graphCompiler_.compile();
 
-    // Timer to push compiled graphs to audio engine + visual canvas
+    // Timer to track audio format changes, free graphs the audio/GL threads have left
+    // and refresh the node profiling badges
     startTimerHz (30);
 
     refreshPresets (false);
@@ -293,6 +295,7 @@ juce::PopupMenu MainComponent::getMenuForIndex (int menuIndex, const juce::Strin
         menu.addItem (6, "Save As Preset...");
         menu.addItem (7, "Update Selected Preset", selectedPresetFile_ != juce::File {});
         menu.addSeparator();
+        menu.addItem (9, audioEngine_.isRecording() ? "Stop Recording Session" : "Record Session...");
         menu.addItem (4, "Audio Settings...");
     }
     else if (menuIndex == 1) // Edit
@@ -303,6 +306,8 @@ juce::PopupMenu MainComponent::getMenuForIndex (int menuIndex, const juce::Strin
     else if (menuIndex == 2) // View
     {
         menu.addItem (20, "Zoom to Fit");
+        menu.addSeparator();
+        menu.addItem (21, "Profile GPU Time", true, visualCanvas_.isGpuTimingEnabled());
     }
 
     return menu;
@@ -321,10 +326,12 @@ void MainComponent::menuItemSelected (int menuItemID, int /*topLevelMenuIndex*/)
 #endif
         case 6:  saveCurrentAsPreset(); break;
         case 7:  updateSelectedPreset(); break;
+        case 9:  toggleSessionRecording(); break;
         case 4:  showAudioSettings(); break;
         case 10: graphModel_.getUndoManager().undo(); break;
         case 11: graphModel_.getUndoManager().redo(); break;
         case 20: nodeEditor_.zoomToFit(); break;
+        case 21: visualCanvas_.setGpuTimingEnabled (! visualCanvas_.isGpuTimingEnabled()); break;
         default: break;
     }
 }
@@ -345,12 +352,14 @@ void MainComponent::timerCallback()
         graphCompiler_.compile();
     }
 
-    // Push compiled graph to audio engine and visual canvas
-    auto* graph = graphCompiler_.getLatestGraph();
-    if (graph)
+    graphCompiler_.collectRetiredGraphs();
+
+    // Node profiling badges, ~4 Hz
+    if (--timingsRefreshCountdown_ <= 0)
     {
-        audioEngine_.setNewGraph (graph);
-        visualCanvas_.setRuntimeGraph (graph);
+        timingsRefreshCountdown_ = 8;
+        if (auto* graph = graphCompiler_.getLatestGraph())
+            nodeEditor_.showNodeTimings (*graph);
     }
 }
 
@@ -394,6 +403,29 @@ void MainComponent::loadFromFile()
         });
 }
 
+void MainComponent::toggleSessionRecording()
+{
+    if (audioEngine_.isRecording())
+    {
+        audioEngine_.stopRecording();
+        return;
+    }
+
+    auto chooser = std::make_shared<juce::FileChooser> ("Record Session", juce::File {}, "*.pftrace");
+    chooser->launchAsync (juce::FileBrowserComponent::saveMode | juce::FileBrowserComponent::canSelectFiles,
+        [this, chooser] (const juce::FileChooser& fc)
+        {
+            auto file = fc.getResult();
+            if (file != juce::File {})
+            {
+                auto error = audioEngine_.startRecording (file.withFileExtension ("pftrace"), graphModel_);
+                if (error.isNotEmpty())
+                    juce::AlertWindow::showMessageBoxAsync (juce::MessageBoxIconType::WarningIcon,
+                                                            "Record Session", error);
+            }
+        });
+}
+
 void MainComponent::showAudioSettings()
 {
     auto* selector = new juce::AudioDeviceSelectorComponent (
@@ -44,6 +44,7 @@ private:
 
     void saveToFile();
     void loadFromFile();
+    void toggleSessionRecording();
     void showAudioSettings();
     void refreshPresets (bool preserveSelection);
     void loadPresetFile (const juce::File& file);
@@ -88,6 +89,7 @@ private:
     int presetRowHeight_ = 30;
     double cachedAudioSampleRate_ = 0.0;
     int cachedAudioBlockSize_ = 0;
+    int timingsRefreshCountdown_ = 0;
 };
 
 } // namespace pf
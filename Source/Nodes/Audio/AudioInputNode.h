@@ -16,30 +16,10 @@ public:
     juce::String getTypeId()      const override { return "AudioInput"; }
     juce::String getDisplayName() const override { return "Audio Input"; }
     juce::String getCategory()    const override { return "Audio"; }
+    bool exportsAnalysis()        const override { return true; }
 
-    void prepareToPlay (double sampleRate, int blockSize) override
-    {
-        NodeBase::prepareToPlay (sampleRate, blockSize);
-        resizeAudioBuffer (0, blockSize);
-        resizeAudioBuffer (1, blockSize);
-        currentBufferSize_ = blockSize;
-    }
-
-    // AudioEngine writes directly to our output buffers
+    // AudioEngine writes directly to our output buffers, at most one block at a time
     void processBlock (int /*numSamples*/) override {}
-
-    void ensureOutputBufferSize (int numSamples)
-    {
-        if (numSamples <= currentBufferSize_)
-            return;
-
-        resizeAudioBuffer (0, numSamples);
-        resizeAudioBuffer (1, numSamples);
-        currentBufferSize_ = numSamples;
-    }
-
-private:
-    int currentBufferSize_ = 0;
 };
 
 } // namespace pf
@@ -1,5 +1,7 @@
 #pragma once
 #include "Nodes/NodeBase.h"
+#include "Nodes/Audio/SpectralLayout.h"
+#include <array>
 
 namespace pf
 {
@@ -24,6 +26,7 @@ public:
     juce::String getTypeId()      const override { return "BandSplitter"; }
     juce::String getDisplayName() const override { return "Band Splitter"; }
     juce::String getCategory()    const override { return "Audio"; }
+    bool isPure()                 const override { return true; }
 
     void prepareToPlay (double sampleRate, int blockSize) override
     {
@@ -39,33 +42,36 @@ public:
             return;
         }
 
-        int numBins = static_cast<int> (mags.size());
-        float binHz = static_cast<float> (sampleRate_) / static_cast<float> (numBins * 2);
+        std::array<float, 4> crossovers { getParamAsFloat (Param::crossover1), getParamAsFloat (Param::crossover2),
+                                          getParamAsFloat (Param::crossover3), getParamAsFloat (Param::crossover4) };
 
-        float c1 = getParamAsFloat ("crossover1", 60.f);
-        float c2 = getParamAsFloat ("crossover2", 250.f);
-        float c3 = getParamAsFloat ("crossover3", 2000.f);
-        float c4 = getParamAsFloat ("crossover4", 6000.f);
-
-        int bin1 = juce::jlimit (0, numBins, static_cast<int> (c1 / binHz));
-        int bin2 = juce::jlimit (0, numBins, static_cast<int> (c2 / binHz));
-        int bin3 = juce::jlimit (0, numBins, static_cast<int> (c3 / binHz));
-        int bin4 = juce::jlimit (0, numBins, static_cast<int> (c4 / binHz));
-
-        auto avgRange = [&] (int start, int end) -> float
+        if (layout_.update (static_cast<int> (mags.size()), sampleRate_) || crossovers != edgeCrossovers_)
         {
-            if (start >= end) return 0.f;
-            float sum = 0.f;
-            for (int i = start; i < end; ++i) sum += mags[i];
-            return sum / static_cast<float> (end - start);
-        };
+            edges_.front() = 0;
+            for (size_t i = 0; i < crossovers.size(); ++i)
+                edges_[i + 1] = layout_.getBinForFrequency (crossovers[i]);
+            edges_.back() = layout_.getNumBins();
+            edgeCrossovers_ = crossovers;
+        }
 
-        setSignalOutputValue (0, avgRange (0, bin1));
-        setSignalOutputValue (1, avgRange (bin1, bin2));
-        setSignalOutputValue (2, avgRange (bin2, bin3));
-        setSignalOutputValue (3, avgRange (bin3, bin4));
-        setSignalOutputValue (4, avgRange (bin4, numBins));
+        for (size_t band = 0; band < 5; ++band)
+        {
+            int start = edges_[band];
+            int end = edges_[band + 1];
+            float average = start < end ? sumBins (mags.data() + start, end - start) / static_cast<float> (end - start) : 0.f;
+            setSignalOutputValue (static_cast<int> (band), average);
+        }
     }
+
+private:
+    struct Param
+    {
+        enum Index : int { crossover1, crossover2, crossover3, crossover4 };
+    };
+
+    SpectralLayout layout_;
+    std::array<float, 4> edgeCrossovers_ {};
+    std::array<int, 6> edges_ {};   // first bin of each band, then numBins
 };
 
 } // namespace pf
@@ -27,6 +27,7 @@ public:
     juce::String getTypeId()      const override { return "BeatDetector"; }
     juce::String getDisplayName() const override { return "Beat Detector"; }
     juce::String getCategory()    const override { return "Audio"; }
+    bool isPure()                 const override { return true; }
 
     void prepareToPlay (double sampleRate, int blockSize) override
     {
@@ -57,8 +58,8 @@ public:
         }
 
         int numBins = static_cast<int> (mags.size());
-        float sensitivity = getParamAsFloat ("sensitivity", 1.5f);
-        int mode = getParamAsInt ("mode", 0);
+        float sensitivity = getParamAsFloat (Param::sensitivity);
+        int mode = getParamAsInt (Param::mode);
 
         totalTime_ += static_cast<double> (numSamples) / sampleRate_;
 
@@ -106,7 +107,7 @@ public:
         }
 
         // Beat detection: onset exceeds threshold
-        bool beatDetected = (onset > sensitivity) && (totalTime_ - lastBeatTime_ > 60.0 / getParamAsFloat ("maxBPM", 200.0f));
+        bool beatDetected = (onset > sensitivity) && (totalTime_ - lastBeatTime_ > 60.0 / getParamAsFloat (Param::maxBPM));
 
         if (beatDetected)
         {
@@ -135,8 +136,8 @@ public:
                     std::sort (intervals.begin(), intervals.begin() + numIntervals);
                     float median = intervals[numIntervals / 2];
                     float bpm = 60.0f / median;
-                    float minBPM = getParamAsFloat ("minBPM", 60.0f);
-                    float maxBPM = getParamAsFloat ("maxBPM", 200.0f);
+                    float minBPM = getParamAsFloat (Param::minBPM);
+                    float maxBPM = getParamAsFloat (Param::maxBPM);
                     currentBPM_ = juce::jlimit (minBPM, maxBPM, bpm);
                 }
             }
@@ -158,6 +159,11 @@ public:
     }
 
 private:
+    struct Param
+    {
+        enum Index : int { sensitivity, minBPM, maxBPM, mode };
+    };
+
     static constexpr int kHistorySize = 43;
     static constexpr int kMaxBeats = 32;
 
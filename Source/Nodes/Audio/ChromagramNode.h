@@ -1,6 +1,6 @@
 #pragma once
 #include "Nodes/NodeBase.h"
-#include <cmath>
+#include "Nodes/Audio/SpectralLayout.h"
 #include <array>
 
 namespace pf
@@ -17,16 +17,20 @@ public:
 
         addParam ("tuning",    440.0f, 420.0f, 460.0f, "Tuning", "A4 reference frequency", "Hz", "Analysis");
         addParam ("smoothing", 0.8f, 0.0f, 0.99f, "Smoothing", "Chroma smoothing", "", "Analysis");
+
+        // One run per semitone from 20 Hz to 8 kHz at most
+        pitchRuns_.reserve (128);
     }
 
     juce::String getTypeId()      const override { return "Chromagram"; }
     juce::String getDisplayName() const override { return "Chromagram"; }
     juce::String getCategory()    const override { return "Audio"; }
+    bool isPure()                 const override { return true; }
 
     void prepareToPlay (double sampleRate, int blockSize) override
     {
         NodeBase::prepareToPlay (sampleRate, blockSize);
-        resizeBufferOutput (0, 12);
+        setBufferOutputSize (0, 12);
         smoothedChroma_.fill (0.0f);
     }
 
@@ -39,25 +43,19 @@ public:
             return;
         }
 
-        int numBins = static_cast<int> (mags.size());
-        float tuning = getParamAsFloat ("tuning", 440.0f);
-        float smoothing = getParamAsFloat ("smoothing", 0.8f);
-        float binHz = static_cast<float> (sampleRate_) / static_cast<float> (numBins * 2);
-
-        std::array<float, 12> chroma {};
+        float tuning = getParamAsFloat (Param::tuning);
+        float smoothing = getParamAsFloat (Param::smoothing);
 
-        for (int i = 1; i < numBins; ++i)
+        if (layout_.update (static_cast<int> (mags.size()), sampleRate_) || tuning != pitchRunsTuning_)
         {
-            float freq = static_cast<float> (i) * binHz;
-            if (freq < 20.0f || freq > 8000.0f) continue;
+            layout_.mapPitchClasses (tuning, 20.0f, 8000.0f, pitchRuns_);
+            pitchRunsTuning_ = tuning;
+        }
 
-            // Map frequency to pitch class (0-11)
-            float midiNote = 12.0f * std::log2 (freq / tuning) + 69.0f;
-            int pitchClass = static_cast<int> (std::round (midiNote)) % 12;
-            if (pitchClass < 0) pitchClass += 12;
+        std::array<float, 12> chroma {};
 
-            chroma[pitchClass] += mags[i];
-        }
+        for (auto& run : pitchRuns_)
+            chroma[static_cast<size_t> (run.pitchClass)] += sumBins (mags.data() + run.begin, run.end - run.begin);
 
         // Normalize
         float maxChroma = *std::max_element (chroma.begin(), chroma.end());
@@ -70,13 +68,13 @@ public:
         int dominantNote = 0;
         float maxVal = 0.0f;
 
-        auto& bufOut = getBufferOutputVec (0);
-        if (bufOut.size() != 12) bufOut.resize (12, 0.0f);
+        auto bufOut = getBufferOutput (0);
 
         for (int i = 0; i < 12; ++i)
         {
             smoothedChroma_[i] = smoothedChroma_[i] * smoothing + chroma[i] * (1.0f - smoothing);
-            bufOut[i] = smoothedChroma_[i];
+            if (static_cast<size_t> (i) < bufOut.size())
+                bufOut[static_cast<size_t> (i)] = smoothedChroma_[i];
 
             if (smoothedChroma_[i] > maxVal)
             {
@@ -89,7 +87,16 @@ public:
     }
 
 private:
+    struct Param
+    {
+        enum Index : int { tuning, smoothing };
+    };
+
     std::array<float, 12> smoothedChroma_ {};
+
+    SpectralLayout layout_;
+    std::vector<SpectralLayout::PitchClassRun> pitchRuns_;
+    float pitchRunsTuning_ = 0.0f;
 };
 
 } // namespace pf
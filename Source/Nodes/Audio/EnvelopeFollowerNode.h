@@ -20,6 +20,7 @@ public:
     juce::String getTypeId()      const override { return "EnvelopeFollower"; }
     juce::String getDisplayName() const override { return "Envelope Follower"; }
     juce::String getCategory()    const override { return "Audio"; }
+    bool isPure()                 const override { return true; }
 
     void prepareToPlay (double sampleRate, int blockSize) override
     {
@@ -52,10 +53,15 @@ public:
     }
 
 private:
+    struct Param
+    {
+        enum Index : int { attackMs, releaseMs };
+    };
+
     void updateCoefficients()
     {
-        float atk = getParamAsFloat ("attackMs",  10.f);
-        float rel = getParamAsFloat ("releaseMs", 100.f);
+        float atk = getParamAsFloat (Param::attackMs);
+        float rel = getParamAsFloat (Param::releaseMs);
         attackCoeff_  = std::exp (-1.0f / (static_cast<float> (sampleRate_) * atk * 0.001f));
         releaseCoeff_ = std::exp (-1.0f / (static_cast<float> (sampleRate_) * rel * 0.001f));
     }
@@ -8,12 +8,11 @@ void FFTAnalyzerNode::prepareToPlay (double sampleRate, int blockSize)
 {
     NodeBase::prepareToPlay (sampleRate, blockSize);
 
-    int order = getParamAsInt ("fftOrder", 11);
+    int order = getParamAsInt (Param::fftOrder);
     rebuildFFT (order);
 
     // Output buffer: fftSize/2 magnitude bins
-    resizeBufferOutput (0, fftSize_ / 2);
-    writePos_ = 0;
+    setBufferOutputSize (0, fftSize_ / 2);
 }
 
 void FFTAnalyzerNode::rebuildFFT (int order)
@@ -21,7 +20,7 @@ void FFTAnalyzerNode::rebuildFFT (int order)
     order = juce::jlimit (9, kMaxFFTOrder, order);
     fftOrder_ = order;
     fftSize_  = 1 << order;
-    fft_ = std::make_unique<juce::dsp::FFT> (order);
+    fft_ = FFTEngine::create (order);
 
     // Build Hann window (default)
     for (int i = 0; i < fftSize_; ++i)
@@ -30,15 +29,49 @@ void FFTAnalyzerNode::rebuildFFT (int order)
         windowBuffer_[i] = 0.5f - 0.5f * std::cos (juce::MathConstants<float>::twoPi * t);
     }
 
-    ringBuffer_.fill (0.f);
-    fftData_.fill (0.f);
+    history_.fill (0.f);
+    frame_.fill (0.f);
     writePos_ = 0;
+    samplesSinceFrame_ = 0;
 }
 
-void FFTAnalyzerNode::applyWindow()
+void FFTAnalyzerNode::pushSamples (const float* inL, const float* inR, int start, int count)
 {
-    for (int i = 0; i < fftSize_; ++i)
-        fftData_[i] *= windowBuffer_[i];
+    for (int i = start; i < start + count; ++i)
+    {
+        float sample = 0.0f;
+        if (inL && inR)
+            sample = 0.5f * (inL[i] + inR[i]);
+        else
+            sample = (inL != nullptr) ? inL[i] : inR[i];
+
+        history_[static_cast<size_t> (writePos_)] = sample;
+        history_[static_cast<size_t> (writePos_ + fftSize_)] = sample;
+        if (++writePos_ >= fftSize_)
+            writePos_ = 0;
+    }
+}
+
+void FFTAnalyzerNode::transformFrame (std::span<float> mags)
+{
+    // The latest fftSize_ samples, oldest first, windowed straight out of the history
+    juce::FloatVectorOperations::multiply (frame_.data(), history_.data() + writePos_,
+                                           windowBuffer_.data(), fftSize_);
+
+    fft_->computeMagnitudes (frame_.data(), mags.data());
+
+    // Scale magnitudes in place
+    const int numBins = fftSize_ / 2;
+    float invSize = 1.0f / static_cast<float> (fftSize_);
+    float energy = 0.f;
+    for (int i = 0; i < numBins; ++i)
+    {
+        float mag = mags[static_cast<size_t> (i)] * invSize;
+        mags[static_cast<size_t> (i)] = mag;
+        energy += mag;
+    }
+
+    setSignalOutputValue (0, energy);
 }
 
 void FFTAnalyzerNode::processBlock (int numSamples)
@@ -48,56 +81,27 @@ void FFTAnalyzerNode::processBlock (int numSamples)
     if (! inL && ! inR)
         return;
 
-    auto mags = getBufferOutputVec (0);
-    int numBins = fftSize_ / 2;
+    auto mags = getBufferOutput (0);
+    if (static_cast<int> (mags.size()) < fftSize_ / 2)
+        return;
 
-    if (static_cast<int> (mags.size()) != numBins)
-        resizeBufferOutput (0, numBins);
+    const int hop = getHopSize();
+    const int untilFrame = juce::jmax (0, hop - samplesSinceFrame_);
 
-    for (int i = 0; i < numSamples; ++i)
+    if (untilFrame > numSamples)
     {
-        float sample = 0.0f;
-        if (inL && inR)
-            sample = 0.5f * (inL[i] + inR[i]);
-        else
-            sample = (inL != nullptr) ? inL[i] : inR[i];
-
-        ringBuffer_[writePos_] = sample;
-        if (++writePos_ >= fftSize_)
-        {
-            writePos_ = 0;
-            frameReady_ = true;
-        }
+        pushSamples (inL, inR, 0, numSamples);
+        samplesSinceFrame_ += numSamples;
+        return;
     }
 
-    if (frameReady_)
-    {
-        frameReady_ = false;
-
-        // Copy ring buffer to fftData (handle wrap-around)
-        for (int i = 0; i < fftSize_; ++i)
-            fftData_[i] = ringBuffer_[(writePos_ + i) % fftSize_];
-
-        // Zero the imaginary part
-        for (int i = fftSize_; i < fftSize_ * 2; ++i)
-            fftData_[i] = 0.f;
-
-        applyWindow();
-        fft_->performFrequencyOnlyForwardTransform (fftData_.data());
-
-        // Scale and write magnitudes
-        float invSize = 1.0f / static_cast<float> (fftSize_);
-        float energy = 0.f;
-        auto& magVec = getBufferOutputVec (0);
-        for (int i = 0; i < numBins; ++i)
-        {
-            float mag = fftData_[i] * invSize;
-            magVec[i] = mag;
-            energy += mag;
-        }
-
-        setSignalOutputValue (0, energy);
-    }
+    // Only the last hop ending in this block is transformed: the outputs hold a
+    // single frame, so any earlier one would be overwritten before it's read
+    const int lastFrame = untilFrame + ((numSamples - untilFrame) / hop) * hop;
+    pushSamples (inL, inR, 0, lastFrame);
+    transformFrame (mags);
+    pushSamples (inL, inR, lastFrame, numSamples - lastFrame);
+    samplesSinceFrame_ = numSamples - lastFrame;
 }
 
 } // namespace pf
@@ -1,11 +1,17 @@
 #pragma once
 #include "Nodes/NodeBase.h"
-#include <juce_dsp/juce_dsp.h>
+#include "Audio/FFTEngine.h"
 #include <array>
 
 namespace pf
 {
 
+/**
+ * Short-time spectrum of the (mono-mixed) input. A new frame is transformed every
+ * hop, set by the overlap between consecutive windows, so larger FFTs still update
+ * at block rate. The outputs hold one frame, so when several hops end within a
+ * block only the last of them is transformed.
+ */
 class FFTAnalyzerNode : public NodeBase
 {
 public:
@@ -22,28 +28,51 @@ public:
                    "", juce::StringArray { "512", "1024", "2048", "4096", "8192" });
         addParam  ("windowType", 0, 0, 2, "Window", "Windowing function applied before FFT", "",
                    "", juce::StringArray { "Hann", "Hamming", "Blackman" });
+        addParam  ("overlap",    2, 0, 3, "Overlap", "Share of each window repeated in the next; more overlap means more frames per second",
+                   "", "", juce::StringArray { "0%", "50%", "75%", "87.5%" });
+        setParamRequiresPrepare ("fftOrder");
     }
 
     juce::String getTypeId()      const override { return "FFTAnalyzer"; }
     juce::String getDisplayName() const override { return "FFT Analyzer"; }
     juce::String getCategory()    const override { return "Audio"; }
+    bool exportsAnalysis()        const override { return true; }
+    bool isPure()                 const override { return true; }
 
     void prepareToPlay (double sampleRate, int blockSize) override;
     void processBlock (int numSamples) override;
 
+    /** History writes plus at most one transform per block, fewer when the hop is
+        longer than the block. */
+    double estimateCost (int numSamples) const override
+    {
+        const auto framesPerBlock = juce::jmin (1.0, static_cast<double> (numSamples) / getHopSize());
+        return NodeBase::estimateCost (numSamples) + 5.0 * fftOrder_ * fftSize_ * framesPerBlock;
+    }
+
 private:
+    struct Param
+    {
+        enum Index : int { fftOrder, windowType, overlap };
+    };
+
+    int getHopSize() const { return fftSize_ >> juce::jlimit (0, 3, getParamAsInt (Param::overlap)); }
+
     void rebuildFFT (int order);
-    void applyWindow();
+    void pushSamples (const float* inL, const float* inR, int start, int count);
+    void transformFrame (std::span<float> mags);
 
-    std::unique_ptr<juce::dsp::FFT> fft_;
+    std::unique_ptr<FFTEngine> fft_;
     int fftOrder_ = 11;
     int fftSize_  = 2048;
 
-    std::array<float, kMaxFFTSize>     ringBuffer_ {};
-    std::array<float, kMaxFFTSize * 2> fftData_ {};
+    // Every sample is written twice, fftSize_ apart, so the latest window is always
+    // the contiguous run history_[writePos_, writePos_ + fftSize_)
+    std::array<float, kMaxFFTSize * 2> history_ {};
+    std::array<float, kMaxFFTSize>     frame_ {};
     std::array<float, kMaxFFTSize>     windowBuffer_ {};
     int writePos_ = 0;
-    bool frameReady_ = false;
+    int samplesSinceFrame_ = 0;
 };
 
 } // namespace pf
@@ -19,12 +19,6 @@ public:
     juce::String getDisplayName() const override { return "Gain"; }
     juce::String getCategory()    const override { return "Audio"; }
 
-    void prepareToPlay (double sampleRate, int blockSize) override
-    {
-        NodeBase::prepareToPlay (sampleRate, blockSize);
-        resizeAudioBuffer (0, blockSize);
-    }
-
     void processBlock (int numSamples) override
     {
         auto* in  = getConnectedAudioBuffer (0);
@@ -33,7 +27,7 @@ public:
 
         float gainVal = isInputConnected (1)
                       ? getConnectedSignalValue (1)
-                      : getParamAsFloat ("gain", 1.0f);
+                      : getParamAsFloat (Param::gain);
 
         if (in)
         {
@@ -45,6 +39,12 @@ public:
             std::fill_n (out, numSamples, 0.f);
         }
     }
+
+private:
+    struct Param
+    {
+        enum Index : int { gain };
+    };
 };
 
 } // namespace pf
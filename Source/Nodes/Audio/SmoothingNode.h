@@ -26,12 +26,25 @@ public:
 
     void processBlock (int /*numSamples*/) override
     {
-        float in = getConnectedSignalValue (0);
-        float smooth = getParamAsFloat ("smoothing", 0.9f);
-        currentValue_ = currentValue_ * smooth + in * (1.f - smooth);
-        setSignalOutputValue (0, currentValue_);
+        setSignalOutputValue (0, step (currentValue_, getConnectedSignalValue (0),
+                                       getParamAsFloat (Param::smoothing)));
     }
 
+    /** One-pole lag; advances `state` and returns the new value. */
+    static float step (float& state, float in, float smooth)
+    {
+        state = state * smooth + in * (1.f - smooth);
+        return state;
+    }
+
+    /** The lag state, so a fused ControlProgram can advance it in place. */
+    float& getState() { return currentValue_; }
+
+    struct Param
+    {
+        enum Index : int { smoothing };
+    };
+
 private:
     float currentValue_ = 0.f;
 };
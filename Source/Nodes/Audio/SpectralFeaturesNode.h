@@ -1,5 +1,6 @@
 #pragma once
 #include "Nodes/NodeBase.h"
+#include "Nodes/Audio/SpectralLayout.h"
 #include <cmath>
 
 namespace pf
@@ -23,6 +24,7 @@ public:
     juce::String getTypeId()      const override { return "SpectralFeatures"; }
     juce::String getDisplayName() const override { return "Spectral Features"; }
     juce::String getCategory()    const override { return "Audio"; }
+    bool isPure()                 const override { return true; }
 
     void prepareToPlay (double sampleRate, int blockSize) override
     {
@@ -44,18 +46,14 @@ public:
         }
 
         int numBins = static_cast<int> (mags.size());
-        float smoothing = getParamAsFloat ("smoothing", 0.8f);
-        float rolloffPct = getParamAsFloat ("rolloffPercent", 0.85f);
+        float smoothing = getParamAsFloat (Param::smoothing);
+        float rolloffPct = getParamAsFloat (Param::rolloffPercent);
 
-        // Spectral centroid: weighted mean frequency
-        float totalEnergy = 0.0f;
-        float weightedSum = 0.0f;
-        for (int i = 0; i < numBins; ++i)
-        {
-            totalEnergy += mags[i];
-            weightedSum += mags[i] * static_cast<float> (i);
-        }
-        float centroid = totalEnergy > 0.0001f ? weightedSum / (totalEnergy * numBins) : 0.0f;
+        // Spectral centroid: weighted mean frequency, as a fraction of Nyquist
+        layout_.update (numBins, sampleRate_);
+        float totalEnergy = sumBins (mags.data(), numBins);
+        float weightedSum = dotBins (mags.data(), layout_.getNormalisedFrequencies().data(), numBins);
+        float centroid = totalEnergy > 0.0001f ? weightedSum / totalEnergy : 0.0f;
 
         // Spectral flux: half-wave rectified difference
         if (prevMags_.size() != static_cast<size_t> (numBins))
@@ -112,6 +110,12 @@ public:
     }
 
 private:
+    struct Param
+    {
+        enum Index : int { rolloffPercent, smoothing };
+    };
+
+    SpectralLayout layout_;
     std::vector<float> prevMags_;
     float smoothedCentroid_ = 0.0f;
     float smoothedFlux_ = 0.0f;
@@ -0,0 +1,90 @@
+#include "Nodes/Audio/SpectralLayout.h"
+#include <array>
+#include <cmath>
+
+namespace pf
+{
+
+bool SpectralLayout::update (int numBins, double sampleRate)
+{
+    if (numBins == numBins_ && sampleRate == sampleRate_)
+        return false;
+
+    numBins_ = juce::jmax (0, numBins);
+    sampleRate_ = sampleRate;
+    binHz_ = numBins_ > 0 ? static_cast<float> (sampleRate) / static_cast<float> (numBins_ * 2) : 0.0f;
+
+    normalisedFrequencies_.resize (static_cast<size_t> (numBins_));
+    for (int i = 0; i < numBins_; ++i)
+        normalisedFrequencies_[static_cast<size_t> (i)] = static_cast<float> (i) / static_cast<float> (numBins_);
+
+    return true;
+}
+
+int SpectralLayout::getBinForFrequency (float hz) const
+{
+    if (binHz_ <= 0.0f)
+        return 0;
+
+    return juce::jlimit (0, numBins_, static_cast<int> (hz / binHz_));
+}
+
+void SpectralLayout::mapPitchClasses (float tuning, float minHz, float maxHz, std::vector<PitchClassRun>& runs) const
+{
+    runs.clear();
+
+    for (int i = juce::jmax (1, getBinForFrequency (minHz)); i < numBins_; ++i)
+    {
+        float freq = static_cast<float> (i) * binHz_;
+        if (freq < minHz) continue;
+        if (freq > maxHz) break;
+
+        // Map frequency to pitch class (0-11)
+        float midiNote = 12.0f * std::log2 (freq / tuning) + 69.0f;
+        int pitchClass = static_cast<int> (std::round (midiNote)) % 12;
+        if (pitchClass < 0) pitchClass += 12;
+
+        if (! runs.empty() && runs.back().end == i && runs.back().pitchClass == pitchClass)
+            ++runs.back().end;
+        else
+            runs.push_back ({ i, i + 1, pitchClass });
+    }
+}
+
+//==============================================================================
+// Eight partial sums rather than one accumulator: the compiler may not reorder
+// float additions itself, but can run independent lanes in one vector register
+
+float sumBins (const float* data, int count)
+{
+    std::array<float, 8> lanes {};
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+        for (int lane = 0; lane < 8; ++lane)
+            lanes[static_cast<size_t> (lane)] += data[i + lane];
+
+    float sum = 0.0f;
+    for (; i < count; ++i)
+        sum += data[i];
+    for (auto lane : lanes)
+        sum += lane;
+    return sum;
+}
+
+float dotBins (const float* a, const float* b, int count)
+{
+    std::array<float, 8> lanes {};
+    int i = 0;
+    for (; i + 8 <= count; i += 8)
+        for (int lane = 0; lane < 8; ++lane)
+            lanes[static_cast<size_t> (lane)] += a[i + lane] * b[i + lane];
+
+    float sum = 0.0f;
+    for (; i < count; ++i)
+        sum += a[i] * b[i];
+    for (auto lane : lanes)
+        sum += lane;
+    return sum;
+}
+
+} // namespace pf
@@ -0,0 +1,63 @@
+#pragma once
+#include <juce_core/juce_core.h>
+#include <span>
+#include <vector>
+
+namespace pf
+{
+
+/**
+ * What a magnitude spectrum's bins mean, for the nodes that read one: a spectrum
+ * of numBins bins spans 0 Hz to the Nyquist frequency of the rate it was analysed
+ * at, so bin i is centred on i * binHz.
+ *
+ * Nodes keep one per Buffer input and call update() every block. It only rebuilds
+ * its tables when the bin count or sample rate changes (i.e. after a graph change
+ * or a new device format), and only allocates when the bin count grows; the
+ * tables derived from it together with params (pitch classes, band edges) are
+ * rebuilt by the node when update() returns true or those params change. Per-bin
+ * work then comes down to sums over contiguous bin ranges, which
+ * sumBins()/dotBins() run in independent lanes the compiler can vectorise.
+ */
+class SpectralLayout
+{
+public:
+    /** Brings the layout in line with a spectrum of numBins bins analysed at
+        sampleRate. Returns true if it changed. */
+    bool update (int numBins, double sampleRate);
+
+    int getNumBins() const { return numBins_; }
+    float getBinHz() const { return binHz_; }
+
+    /** The last bin centred at or below hz (hz / binHz rounded down), in [0, numBins]. */
+    int getBinForFrequency (float hz) const;
+
+    /** i / numBins for every bin i: its frequency as a fraction of Nyquist. */
+    std::span<const float> getNormalisedFrequencies() const { return normalisedFrequencies_; }
+
+    /** Consecutive bins that round to the same equal-tempered pitch class. */
+    struct PitchClassRun
+    {
+        int begin, end;   // bins [begin, end)
+        int pitchClass;   // 0 = C
+    };
+
+    /** Fills runs with the pitch classes of the bins centred in [minHz, maxHz],
+        A4 being tuning Hz. Doesn't allocate if runs has room for one run per
+        semitone in the range. */
+    void mapPitchClasses (float tuning, float minHz, float maxHz, std::vector<PitchClassRun>& runs) const;
+
+private:
+    int numBins_ = 0;
+    double sampleRate_ = 0.0;
+    float binHz_ = 0.0f;
+    std::vector<float> normalisedFrequencies_;
+};
+
+/** Sum of data[0, count). */
+float sumBins (const float* data, int count);
+
+/** Sum of a[i] * b[i] over [0, count). */
+float dotBins (const float* a, const float* b, int count);
+
+} // namespace pf
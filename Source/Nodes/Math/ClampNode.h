@@ -22,10 +22,15 @@ public:
     void processBlock (int /*numSamples*/) override
     {
         float in = getConnectedSignalValue (0);
-        float lo = getParamAsFloat ("min", 0.f);
-        float hi = getParamAsFloat ("max", 1.f);
+        float lo = getParamAsFloat (Param::min);
+        float hi = getParamAsFloat (Param::max);
         setSignalOutputValue (0, juce::jlimit (lo, hi, in));
     }
+
+    struct Param
+    {
+        enum Index : int { min, max };
+    };
 };
 
 } // namespace pf
@@ -23,17 +23,25 @@ public:
 
     void processBlock (int /*numSamples*/) override
     {
-        float in     = getConnectedSignalValue (0);
-        float inMin  = getParamAsFloat ("inMin", 0.f);
-        float inMax  = getParamAsFloat ("inMax", 1.f);
-        float outMin = getParamAsFloat ("outMin", 0.f);
-        float outMax = getParamAsFloat ("outMax", 1.f);
+        setSignalOutputValue (0, map (getConnectedSignalValue (0),
+                                      getParamAsFloat (Param::inMin),
+                                      getParamAsFloat (Param::inMax),
+                                      getParamAsFloat (Param::outMin),
+                                      getParamAsFloat (Param::outMax)));
+    }
 
+    static float map (float in, float inMin, float inMax, float outMin, float outMax)
+    {
         float range = inMax - inMin;
         float t = (range != 0.f) ? (in - inMin) / range : 0.f;
         t = juce::jlimit (0.f, 1.f, t);
-        setSignalOutputValue (0, outMin + t * (outMax - outMin));
+        return outMin + t * (outMax - outMin);
     }
+
+    struct Param
+    {
+        enum Index : int { inMin, inMax, outMin, outMax };
+    };
 };
 
 } // namespace pf
@@ -3,6 +3,12 @@
 #include <juce_data_structures/juce_data_structures.h>
 #include <juce_opengl/juce_opengl.h>
 #include "Graph/PortTypes.h"
+#include "Graph/ParamStore.h"
+#include "Graph/SignalBridge.h"
+#include "Graph/BufferChannel.h"
+#include "Graph/NodeTimings.h"
+#include "Rendering/GLResourceRegistry.h"
+#include <algorithm>
 #include <span>
 #include <vector>
 
@@ -29,12 +35,16 @@ struct NodeParam
     juce::String      suffix;        // Unit suffix: "ms", "Hz", "x", "px"
     juce::String      group;         // Section header: "Timing", "Transform"
     juce::StringArray enumLabels;    // For int params: {"Heat","Rainbow","Grayscale"}
+    // Changing this param only takes effect through a fresh prepareToPlay()
+    bool              requiresPrepare = false;
 };
 
 class NodeBase
 {
 public:
-    virtual ~NodeBase() = default;
+    /** GPU objects the node allocated through GLResourceRegistry are queued for
+        release on the GL thread; nodes may be destroyed on any thread. */
+    virtual ~NodeBase() { GLResourceRegistry::instance().releaseOwner (this); }
 
     virtual juce::String getTypeId() const = 0;
     virtual juce::String getDisplayName() const = 0;
@@ -63,15 +73,65 @@ public:
     /** Frame-rate visual processing (GL thread). */
     virtual void renderFrame (juce::OpenGLContext& /*gl*/) {}
 
+    /** Seconds the next renderFrame() advances animation by: the measured frame
+        interval live, 1/fps offline. Set by RuntimeGraph before each call. */
+    void setFrameSeconds (float seconds) { frameSeconds_ = seconds; }
+    float getFrameSeconds() const { return frameSeconds_; }
+
     /** Whether this node runs on the GL thread. */
     virtual bool isVisualNode() const { return false; }
 
+    /** Visual nodes: whether renderFrame() must run every frame even with unchanged
+        params and inputs (animation, feedback, analysis). When false, the runtime
+        skips the node while nothing upstream changes and its last output stands. */
+    virtual bool isTimeDependent() const { return true; }
+
+    /** Whether the node's result leaves the graph (e.g. to the screen). The compiler
+        only schedules nodes that feed a sink. */
+    virtual bool isSink() const { return false; }
+
+    /** Whether the node's Audio and Buffer outputs stand in for unconnected inputs of
+        nodes that readsAnalysis(). */
+    virtual bool exportsAnalysis() const { return false; }
+
+    /** Whether the node's unconnected Audio and Buffer inputs are wired by the compiler
+        to the first node that exportsAnalysis() an output of that type (the device
+        input, the spectrum), so it reacts to audio without explicit edges. */
+    virtual bool readsAnalysis() const { return false; }
+
+    /** Whether the outputs depend only on the type, params and inputs, so two such
+        instances always agree and the compiler may run one for both. */
+    virtual bool isPure() const { return false; }
+
+    /** Rough work per processBlock() call, in float operations. The compiler only
+        runs independent branches in parallel when they carry enough of it.
+        The default assumes one pass over each Audio and Buffer port. */
+    virtual double estimateCost (int numSamples) const
+    {
+        double cost = 1.0;
+        for (auto& port : inputs_)
+            if (port.type == PortType::Audio)
+                cost += numSamples;
+
+        int bufferIndex = 0;
+        for (auto& port : outputs_)
+        {
+            if (port.type == PortType::Audio)
+                cost += numSamples;
+            else if (port.type == PortType::Buffer)
+                cost += getBufferOutputSize (bufferIndex++);
+        }
+        return cost;
+    }
+
     //==============================================================================
-    // Output data storage — nodes write to these during processBlock/renderFrame
+    // Output data storage — nodes write to these during processBlock/renderFrame.
+    // Audio and Buffer outputs live in the RuntimeGraph's arena and are bound by the
+    // compiler; an Audio output holds one block (the prepared block size).
     float* getAudioOutputBuffer (int outputIndex)
     {
-        if (outputIndex < static_cast<int> (audioOutputBuffers_.size()))
-            return audioOutputBuffers_[outputIndex].data();
+        if (outputIndex < static_cast<int> (audioOutputs_.size()))
+            return audioOutputs_[outputIndex];
         return nullptr;
     }
 
@@ -90,12 +150,38 @@ public:
 
     std::span<const float> getBufferOutputData (int outputIndex) const
     {
-        if (outputIndex < static_cast<int> (bufferOutputData_.size()))
-            return { bufferOutputData_[outputIndex].data(),
-                     bufferOutputData_[outputIndex].size() };
+        if (outputIndex < static_cast<int> (bufferOutputs_.size()))
+            return bufferOutputs_[outputIndex];
         return {};
     }
 
+    /** Number of floats a Buffer output needs, as declared in prepareToPlay(). */
+    int getBufferOutputSize (int outputIndex) const
+    {
+        if (outputIndex < static_cast<int> (bufferOutputSizes_.size()))
+            return bufferOutputSizes_[outputIndex];
+        return 0;
+    }
+
+    /** Points the Audio/Buffer outputs (in port-type order) at new arena storage.
+        Buffer contents are carried over, since they hold state between blocks. */
+    void bindOutputs (const std::vector<float*>& audioOutputs,
+                      const std::vector<std::span<float>>& bufferOutputs)
+    {
+        for (size_t i = 0; i < audioOutputs_.size() && i < audioOutputs.size(); ++i)
+            audioOutputs_[i] = audioOutputs[i];
+
+        for (size_t i = 0; i < bufferOutputs_.size() && i < bufferOutputs.size(); ++i)
+        {
+            auto& current = bufferOutputs_[i];
+            auto next = bufferOutputs[i];
+            if (current.data() != next.data() && ! current.empty())
+                std::copy_n (current.data(), std::min (current.size(), next.size()), next.data());
+
+            current = next;
+        }
+    }
+
     float getVisualOutputValue (int outputIndex) const
     {
         if (outputIndex < static_cast<int> (visualOutputValues_.size()))
@@ -128,12 +214,15 @@ public:
     {
         NodeBase* sourceNode = nullptr;
         int       sourceOutputIndex = 0;
+        const SignalBridge* bridge = nullptr;    // set for Signal outputs read on the GL thread
+        const BufferChannel* channel = nullptr;  // set for Audio/Buffer outputs read on the GL thread
     };
 
-    void setInputConnection (int inputIndex, NodeBase* source, int sourceOutputIdx)
+    void setInputConnection (int inputIndex, NodeBase* source, int sourceOutputIdx,
+                             const SignalBridge* bridge = nullptr, const BufferChannel* channel = nullptr)
     {
         if (inputIndex < static_cast<int> (inputConnections_.size()))
-            inputConnections_[inputIndex] = { source, sourceOutputIdx };
+            inputConnections_[inputIndex] = { source, sourceOutputIdx, bridge, channel };
     }
 
     // Reading connected input values
@@ -155,16 +244,44 @@ public:
         return conn.sourceNode ? conn.sourceNode->getBufferOutputData (conn.sourceOutputIndex) : std::span<const float>{};
     }
 
+    /** Signal inputs from audio nodes read the last block latched for this frame. */
     float getConnectedVisualValue (int inputIndex) const
     {
         auto& conn = inputConnections_[inputIndex];
         if (! conn.sourceNode) return 0.f;
+        if (conn.bridge) return conn.bridge->getFrame().last;
         auto srcType = conn.sourceNode->getOutputs()[conn.sourceOutputIndex].type;
         if (srcType == PortType::Signal)
             return conn.sourceNode->getSignalOutputValue (conn.sourceOutputIndex);
         return conn.sourceNode->getVisualOutputValue (conn.sourceOutputIndex);
     }
 
+    /** For trigger and beat inputs: as getConnectedVisualValue(), but Signal inputs
+        from audio nodes read the largest value latched for this frame, so a pulse
+        shorter than a frame isn't missed. */
+    float getConnectedVisualPeak (int inputIndex) const
+    {
+        auto& conn = inputConnections_[inputIndex];
+        if (conn.sourceNode && conn.bridge) return conn.bridge->getFrame().peak;
+        return getConnectedVisualValue (inputIndex);
+    }
+
+    /** Audio and Buffer inputs of visual nodes: the newest block or buffer the audio
+        thread published through the edge's channel, or empty if there is none. */
+    std::span<const float> getConnectedChannelData (int inputIndex) const
+    {
+        auto* channel = getConnectedBufferChannel (inputIndex);
+        return channel != nullptr ? channel->getData() : std::span<const float> {};
+    }
+
+    const BufferChannel* getConnectedBufferChannel (int inputIndex) const
+    {
+        if (inputIndex < 0 || inputIndex >= static_cast<int> (inputConnections_.size()))
+            return nullptr;
+
+        return inputConnections_[inputIndex].channel;
+    }
+
     juce::uint32 getConnectedTexture (int inputIndex) const
     {
         auto& conn = inputConnections_[inputIndex];
@@ -194,36 +311,35 @@ public:
     }
 
     //==============================================================================
-    // Parameters (read from ValueTree, written by GUI)
-    void setParamTree (juce::ValueTree paramTree) { paramTree_ = paramTree; }
-
-    juce::var getParam (const juce::String& name) const
+    // Parameters (resolved to ParamStore slots by GraphCompiler, written by GUI)
+    //
+    // Nodes read params by index — the order in which they were added — so a read
+    // on the audio/GL thread is a single atomic load.
+    void bindParams (const ParamStore* store, int firstSlot)
     {
-        return paramTree_.getProperty (juce::Identifier (name));
+        paramStore_ = store;
+        firstParamSlot_ = firstSlot;
     }
 
-    float getParamAsFloat (const juce::String& name, float fallback = 0.f) const
+    float getParamAsFloat (int index) const
     {
-        auto val = paramTree_.getProperty (juce::Identifier (name));
-        return val.isVoid() ? fallback : static_cast<float> (val);
+        if (paramStore_ != nullptr)
+            return paramStore_->load (firstParamSlot_ + index);
+
+        return static_cast<float> (params_[static_cast<size_t> (index)].defaultValue);
     }
 
-    int getParamAsInt (const juce::String& name, int fallback = 0) const
+    int getParamAsInt (int index) const
     {
-        auto val = paramTree_.getProperty (juce::Identifier (name));
-        if (val.isVoid())
-            return fallback;
-
-        if (val.isInt() || val.isInt64() || val.isBool())
-            return static_cast<int> (val);
-
-        if (val.isDouble())
-            return juce::roundToInt (static_cast<double> (val));
+        return juce::roundToInt (getParamAsFloat (index));
+    }
 
-        if (val.isString())
-            return val.toString().getIntValue();
+    juce::String getParamAsString (int index) const
+    {
+        if (paramStore_ != nullptr)
+            return paramStore_->loadString (firstParamSlot_ + index);
 
-        return fallback;
+        return params_[static_cast<size_t> (index)].defaultValue.toString();
     }
 
     //==============================================================================
@@ -231,6 +347,14 @@ public:
     bool isBypassed() const { return bypassed_; }
     void setBypassed (bool b) { bypassed_ = b; }
 
+    /** Recent processBlock()/renderFrame() times, recorded by RuntimeGraph. */
+    NodeTimings& getTimings() { return timings_; }
+    const NodeTimings& getTimings() const { return timings_; }
+
+    /** Recent GPU times of renderFrame(), recorded by GPUTimer while it is enabled. */
+    NodeTimings& getGpuTimings() { return gpuTimings_; }
+    const NodeTimings& getGpuTimings() const { return gpuTimings_; }
+
     juce::String nodeId;  // unique instance ID
 
 protected:
@@ -248,13 +372,14 @@ protected:
         switch (type)
         {
             case PortType::Audio:
-                audioOutputBuffers_.emplace_back();
+                audioOutputs_.push_back (nullptr);
                 break;
             case PortType::Signal:
                 signalOutputValues_.push_back (0.f);
                 break;
             case PortType::Buffer:
-                bufferOutputData_.emplace_back();
+                bufferOutputs_.emplace_back();
+                bufferOutputSizes_.push_back (0);
                 break;
             case PortType::Visual:
                 visualOutputValues_.push_back (0.f);
@@ -283,23 +408,29 @@ protected:
                              displayName, description, suffix, group, std::move (enumLabels) });
     }
 
-    void resizeAudioBuffer (int outputLocalIndex, int numSamples)
+    /** Marks a param that is only read in prepareToPlay(), so the compiler re-prepares
+        (rather than reuses) this node when its value changes. */
+    void setParamRequiresPrepare (const juce::String& name)
     {
-        if (outputLocalIndex < static_cast<int> (audioOutputBuffers_.size()))
-            audioOutputBuffers_[outputLocalIndex].resize (static_cast<size_t> (numSamples), 0.f);
+        for (auto& param : params_)
+            if (param.name == name)
+                param.requiresPrepare = true;
     }
 
-    void resizeBufferOutput (int outputLocalIndex, int numFloats)
+    /** Declares how many floats a Buffer output needs. Call from prepareToPlay();
+        the compiler sizes the arena storage from it. */
+    void setBufferOutputSize (int outputLocalIndex, int numFloats)
     {
-        if (outputLocalIndex < static_cast<int> (bufferOutputData_.size()))
-            bufferOutputData_[outputLocalIndex].resize (static_cast<size_t> (numFloats), 0.f);
+        if (outputLocalIndex < static_cast<int> (bufferOutputSizes_.size()))
+            bufferOutputSizes_[outputLocalIndex] = numFloats;
     }
 
-    std::vector<float>& getAudioOutputBufferVec (int idx) { return audioOutputBuffers_[idx]; }
-    std::vector<float>& getBufferOutputVec (int idx)      { return bufferOutputData_[idx]; }
+    /** Writable view of a Buffer output. Empty until the node's graph is adopted. */
+    std::span<float> getBufferOutput (int idx) { return bufferOutputs_[idx]; }
 
     double sampleRate_ = 44100.0;
     int    blockSize_  = 512;
+    float  frameSeconds_ = 1.0f / 60.0f;
 
 private:
     std::vector<Port>      inputs_;
@@ -307,17 +438,22 @@ private:
     std::vector<NodeParam> params_;
 
     // Output storage — one entry per output port of each type
-    std::vector<std::vector<float>> audioOutputBuffers_;
-    std::vector<float>              signalOutputValues_;
-    std::vector<std::vector<float>> bufferOutputData_;
-    std::vector<float>              visualOutputValues_;
-    std::vector<juce::uint32>       textureOutputs_;
+    std::vector<float*>           audioOutputs_;
+    std::vector<float>            signalOutputValues_;
+    std::vector<std::span<float>> bufferOutputs_;
+    std::vector<int>              bufferOutputSizes_;
+    std::vector<float>            visualOutputValues_;
+    std::vector<juce::uint32>     textureOutputs_;
 
     // Resolved input connections
     std::vector<InputConnection> inputConnections_;
 
-    juce::ValueTree paramTree_;
+    const ParamStore* paramStore_ = nullptr;
+    int firstParamSlot_ = 0;
     bool bypassed_ = false;
+
+    NodeTimings timings_;
+    NodeTimings gpuTimings_;
 };
 
 } // namespace pf
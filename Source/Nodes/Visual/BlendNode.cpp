@@ -1,5 +1,7 @@
 #include "Nodes/Visual/BlendNode.h"
 #include <juce_opengl/juce_opengl.h>
+#include "Rendering/GLResourceRegistry.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
@@ -65,11 +67,11 @@ void BlendNode::ensureFBO (juce::OpenGLContext& gl, int width, int height)
 
     if (fbo_ != 0)
     {
-        gl.extensions.glDeleteFramebuffers (1, &fbo_);
-        juce::gl::glDeleteTextures (1, &fboTexture_);
+        GLResourceRegistry::instance().deleteFramebuffers (gl, this, 1, &fbo_);
+        GLResourceRegistry::instance().deleteTextures (this, 1, &fboTexture_);
     }
 
-    juce::gl::glGenTextures (1, &fboTexture_);
+    GLResourceRegistry::instance().genTextures (this, 1, &fboTexture_);
     juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D, fboTexture_);
     juce::gl::glTexImage2D (juce::gl::GL_TEXTURE_2D, 0, juce::gl::GL_RGBA8,
                             width, height, 0,
@@ -79,7 +81,7 @@ void BlendNode::ensureFBO (juce::OpenGLContext& gl, int width, int height)
     juce::gl::glTexParameteri (juce::gl::GL_TEXTURE_2D, juce::gl::GL_TEXTURE_WRAP_S, juce::gl::GL_CLAMP_TO_EDGE);
     juce::gl::glTexParameteri (juce::gl::GL_TEXTURE_2D, juce::gl::GL_TEXTURE_WRAP_T, juce::gl::GL_CLAMP_TO_EDGE);
 
-    gl.extensions.glGenFramebuffers (1, &fbo_);
+    GLResourceRegistry::instance().genFramebuffers (gl, this, 1, &fbo_);
     gl.extensions.glBindFramebuffer (juce::gl::GL_FRAMEBUFFER, fbo_);
     gl.extensions.glFramebufferTexture2D (juce::gl::GL_FRAMEBUFFER,
                                           juce::gl::GL_COLOR_ATTACHMENT0,
@@ -156,7 +158,7 @@ void BlendNode::compileShader (juce::OpenGLContext& gl)
         return;
     }
 
-    shaderProgram_ = gl.extensions.glCreateProgram();
+    shaderProgram_ = GLResourceRegistry::instance().createProgram (gl, this);
     gl.extensions.glAttachShader (shaderProgram_, vs);
     gl.extensions.glAttachShader (shaderProgram_, fs);
     gl.extensions.glLinkProgram (shaderProgram_);
@@ -170,7 +172,7 @@ void BlendNode::compileShader (juce::OpenGLContext& gl)
     if (! linked)
     {
         auto linkLog = getProgramInfoLog (gl, shaderProgram_);
-        gl.extensions.glDeleteProgram (shaderProgram_);
+        GLResourceRegistry::instance().deleteProgram (gl, this, shaderProgram_);
         shaderProgram_ = 0;
         shaderError_ = true;
         DBG ("BlendNode shader link error:\n" + linkLog);
@@ -187,7 +189,7 @@ void BlendNode::compileShader (juce::OpenGLContext& gl)
             -1.f,  1.f,
              1.f,  1.f
         };
-        gl.extensions.glGenBuffers (1, &quadVBO_);
+        GLResourceRegistry::instance().genBuffers (gl, this, 1, &quadVBO_);
         gl.extensions.glBindBuffer (juce::gl::GL_ARRAY_BUFFER, quadVBO_);
         gl.extensions.glBufferData (juce::gl::GL_ARRAY_BUFFER, sizeof (quadVerts), quadVerts, juce::gl::GL_STATIC_DRAW);
         gl.extensions.glBindBuffer (juce::gl::GL_ARRAY_BUFFER, 0);
@@ -199,7 +201,7 @@ void BlendNode::ensureFallbackTexture()
     if (fallbackTexture_ != 0)
         return;
 
-    juce::gl::glGenTextures (1, &fallbackTexture_);
+    GLResourceRegistry::instance().genTextures (this, 1, &fallbackTexture_);
     juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D, fallbackTexture_);
 
     const juce::uint8 blackPixel[4] = { 0, 0, 0, 255 };
@@ -215,8 +217,8 @@ void BlendNode::ensureFallbackTexture()
 
 void BlendNode::renderFrame (juce::OpenGLContext& gl)
 {
-    constexpr int width = 512;
-    constexpr int height = 512;
+    const int width = RenderConfig::getWidth();
+    const int height = RenderConfig::getHeight();
 
     ensureFBO (gl, width, height);
     compileShader (gl);
@@ -238,7 +240,7 @@ void BlendNode::renderFrame (juce::OpenGLContext& gl)
             return gl.extensions.glGetUniformLocation (shaderProgram_, name);
         };
 
-        auto mixValue = getParamAsFloat ("mix", 0.5f);
+        auto mixValue = getParamAsFloat (Param::mix);
         if (isInputConnected (2))
             mixValue += getConnectedVisualValue (2) - 0.5f;
         mixValue = juce::jlimit (0.0f, 1.0f, mixValue);
@@ -247,7 +249,7 @@ void BlendNode::renderFrame (juce::OpenGLContext& gl)
             gl.extensions.glUniform1f (mixLoc, mixValue);
 
         if (auto modeLoc = loc ("u_mode"); modeLoc >= 0)
-            gl.extensions.glUniform1i (modeLoc, getParamAsInt ("mode", 0));
+            gl.extensions.glUniform1i (modeLoc, getParamAsInt (Param::mode));
 
         juce::gl::glActiveTexture (juce::gl::GL_TEXTURE0);
         juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D,
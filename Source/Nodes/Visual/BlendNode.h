@@ -23,10 +23,16 @@ public:
     juce::String getDisplayName() const override { return "Blend"; }
     juce::String getCategory()    const override { return "Visual"; }
     bool isVisualNode()           const override { return true; }
+    bool isTimeDependent()        const override { return false; }
 
     void renderFrame (juce::OpenGLContext& gl) override;
 
 private:
+    struct Param
+    {
+        enum Index : int { mode, mix };
+    };
+
     void ensureFBO (juce::OpenGLContext& gl, int width, int height);
     void compileShader (juce::OpenGLContext& gl);
     void ensureFallbackTexture();
@@ -1,12 +1,13 @@
 #include "Nodes/Visual/BlurNode.h"
 #include "Rendering/ShaderUtils.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
 
 namespace
 {
-juce::uint32 compileBlurShader (juce::OpenGLContext& gl, const juce::String& fragBody)
+juce::uint32 compileBlurShader (juce::OpenGLContext& gl, const void* owner, const juce::String& fragBody)
 {
     auto vertSrc = ShaderUtils::getStandardVertexShader();
     auto fragSrc = ShaderUtils::getFragmentPreamble() + fragBody;
@@ -18,7 +19,7 @@ juce::uint32 compileBlurShader (juce::OpenGLContext& gl, const juce::String& fra
     auto fs = ShaderUtils::compileShaderStage (gl, juce::gl::GL_FRAGMENT_SHADER, fragSrc, errorLog);
     if (fs == 0) { gl.extensions.glDeleteShader (vs); DBG ("Blur FS error: " + errorLog); return 0; }
 
-    auto prog = ShaderUtils::linkProgram (gl, vs, fs, errorLog);
+    auto prog = ShaderUtils::linkProgram (gl, owner, vs, fs, errorLog);
     if (prog == 0) { DBG ("Blur link error: " + errorLog); }
     return prog;
 }
@@ -26,16 +27,16 @@ juce::uint32 compileBlurShader (juce::OpenGLContext& gl, const juce::String& fra
 
 void BlurNode::renderFrame (juce::OpenGLContext& gl)
 {
-    constexpr int width = 512, height = 512;
+    const int width = RenderConfig::getWidth(), height = RenderConfig::getHeight();
 
-    ShaderUtils::ensurePingPongFBOs (gl, fbos_, textures_, fboWidth_, fboHeight_, width, height);
-    ShaderUtils::ensureQuadVBO (gl, quadVBO_);
-    ShaderUtils::ensureFallbackTexture (fallbackTexture_);
+    ShaderUtils::ensurePingPongFBOs (gl, this, fbos_, textures_, fboWidth_, fboHeight_, width, height);
+    ShaderUtils::ensureQuadVBO (gl, this, quadVBO_);
+    ShaderUtils::ensureFallbackTexture (this, fallbackTexture_);
 
     if (! shadersCompiled_ && ! shaderError_)
     {
         // Gaussian (9-tap separable)
-        gaussianProgram_ = compileBlurShader (gl,
+        gaussianProgram_ = compileBlurShader (gl, this,
             "varying vec2 v_uv;\n"
             "uniform sampler2D u_texture;\n"
             "uniform vec2  u_dir;\n"
@@ -57,7 +58,7 @@ void BlurNode::renderFrame (juce::OpenGLContext& gl)
             "}\n");
 
         // Radial (zoom blur)
-        radialProgram_ = compileBlurShader (gl,
+        radialProgram_ = compileBlurShader (gl, this,
             "varying vec2 v_uv;\n"
             "uniform sampler2D u_texture;\n"
             "uniform float u_amount;\n"
@@ -76,7 +77,7 @@ void BlurNode::renderFrame (juce::OpenGLContext& gl)
             "}\n");
 
         // Directional (motion blur)
-        directionalProgram_ = compileBlurShader (gl,
+        directionalProgram_ = compileBlurShader (gl, this,
             "varying vec2 v_uv;\n"
             "uniform sampler2D u_texture;\n"
             "uniform vec2  u_dir;\n"
@@ -98,9 +99,9 @@ void BlurNode::renderFrame (juce::OpenGLContext& gl)
         shadersCompiled_ = true;
     }
 
-    int mode = getParamAsInt ("mode", 0);
-    float amount = getParamAsFloat ("amount", 1.0f);
-    int passes = getParamAsInt ("passes", 2);
+    int mode = getParamAsInt (Param::mode);
+    float amount = getParamAsFloat (Param::amount);
+    int passes = getParamAsInt (Param::passes);
 
     if (isInputConnected (1)) amount *= juce::jlimit (0.0f, 4.0f, getConnectedVisualValue (1) * 2.0f);
 
@@ -169,7 +170,7 @@ void BlurNode::renderFrame (juce::OpenGLContext& gl)
 
         if (auto l = loc ("u_amount"); l >= 0) gl.extensions.glUniform1f (l, amount);
         if (auto l = loc ("u_center"); l >= 0)
-            gl.extensions.glUniform2f (l, getParamAsFloat ("center_x", 0.5f), getParamAsFloat ("center_y", 0.5f));
+            gl.extensions.glUniform2f (l, getParamAsFloat (Param::center_x), getParamAsFloat (Param::center_y));
 
         juce::gl::glActiveTexture (juce::gl::GL_TEXTURE0);
         juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D, inputTex);
@@ -183,7 +184,7 @@ void BlurNode::renderFrame (juce::OpenGLContext& gl)
     }
     else // Directional
     {
-        float dirAngle = juce::degreesToRadians (getParamAsFloat ("directionDeg", 0.0f));
+        float dirAngle = juce::degreesToRadians (getParamAsFloat (Param::directionDeg));
         if (isInputConnected (2)) dirAngle += getConnectedVisualValue (2) * 6.283f;
 
         gl.extensions.glBindFramebuffer (juce::gl::GL_FRAMEBUFFER, fbos_[0]);
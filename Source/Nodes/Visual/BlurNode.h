@@ -27,10 +27,16 @@ public:
     juce::String getDisplayName() const override { return "Blur"; }
     juce::String getCategory()    const override { return "Visual"; }
     bool isVisualNode()           const override { return true; }
+    bool isTimeDependent()        const override { return false; }
 
     void renderFrame (juce::OpenGLContext& gl) override;
 
 private:
+    struct Param
+    {
+        enum Index : int { mode, amount, passes, directionDeg, center_x, center_y };
+    };
+
     juce::uint32 fbos_[2] = { 0, 0 };
     juce::uint32 textures_[2] = { 0, 0 };
     int fboWidth_ = 0, fboHeight_ = 0;
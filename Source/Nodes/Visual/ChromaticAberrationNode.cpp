@@ -1,16 +1,17 @@
 #include "Nodes/Visual/ChromaticAberrationNode.h"
 #include "Rendering/ShaderUtils.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
 
 void ChromaticAberrationNode::renderFrame (juce::OpenGLContext& gl)
 {
-    constexpr int width = 512, height = 512;
+    const int width = RenderConfig::getWidth(), height = RenderConfig::getHeight();
 
-    ShaderUtils::ensureFBO (gl, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
-    ShaderUtils::ensureQuadVBO (gl, quadVBO_);
-    ShaderUtils::ensureFallbackTexture (fallbackTexture_);
+    ShaderUtils::ensureFBO (gl, this, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
+    ShaderUtils::ensureQuadVBO (gl, this, quadVBO_);
+    ShaderUtils::ensureFallbackTexture (this, fallbackTexture_);
 
     if (! shaderCompiled_ && ! shaderError_)
     {
@@ -45,7 +46,7 @@ void ChromaticAberrationNode::renderFrame (juce::OpenGLContext& gl)
         auto fs = ShaderUtils::compileShaderStage (gl, juce::gl::GL_FRAGMENT_SHADER, fragSrc, errorLog);
         if (fs == 0) { gl.extensions.glDeleteShader (vs); shaderError_ = true; return; }
 
-        shaderProgram_ = ShaderUtils::linkProgram (gl, vs, fs, errorLog);
+        shaderProgram_ = ShaderUtils::linkProgram (gl, this, vs, fs, errorLog);
         if (shaderProgram_ == 0) { shaderError_ = true; return; }
 
         shaderCompiled_ = true;
@@ -67,15 +68,15 @@ void ChromaticAberrationNode::renderFrame (juce::OpenGLContext& gl)
             return gl.extensions.glGetUniformLocation (shaderProgram_, name);
         };
 
-        float amount = getParamAsFloat ("amount", 0.005f);
+        float amount = getParamAsFloat (Param::amount);
         if (isInputConnected (1))
             amount *= juce::jlimit (0.0f, 10.0f, getConnectedVisualValue (1) * 5.0f);
 
-        float angle = juce::degreesToRadians (getParamAsFloat ("angle", 0.0f));
+        float angle = juce::degreesToRadians (getParamAsFloat (Param::angle));
 
         if (auto l = loc ("u_amount"); l >= 0) gl.extensions.glUniform1f (l, amount);
         if (auto l = loc ("u_angle");  l >= 0) gl.extensions.glUniform1f (l, angle);
-        if (auto l = loc ("u_radial"); l >= 0) gl.extensions.glUniform1i (l, getParamAsInt ("radial", 0));
+        if (auto l = loc ("u_radial"); l >= 0) gl.extensions.glUniform1i (l, getParamAsInt (Param::radial));
 
         juce::gl::glActiveTexture (juce::gl::GL_TEXTURE0);
         juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D,
@@ -1,16 +1,17 @@
 #include "Nodes/Visual/ColorGradeNode.h"
 #include "Rendering/ShaderUtils.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
 
 void ColorGradeNode::renderFrame (juce::OpenGLContext& gl)
 {
-    constexpr int width = 512, height = 512;
+    const int width = RenderConfig::getWidth(), height = RenderConfig::getHeight();
 
-    ShaderUtils::ensureFBO (gl, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
-    ShaderUtils::ensureQuadVBO (gl, quadVBO_);
-    ShaderUtils::ensureFallbackTexture (fallbackTexture_);
+    ShaderUtils::ensureFBO (gl, this, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
+    ShaderUtils::ensureQuadVBO (gl, this, quadVBO_);
+    ShaderUtils::ensureFallbackTexture (this, fallbackTexture_);
 
     if (! shaderCompiled_ && ! shaderError_)
     {
@@ -70,7 +71,7 @@ void ColorGradeNode::renderFrame (juce::OpenGLContext& gl)
         auto fs = ShaderUtils::compileShaderStage (gl, juce::gl::GL_FRAGMENT_SHADER, fragSrc, errorLog);
         if (fs == 0) { gl.extensions.glDeleteShader (vs); shaderError_ = true; return; }
 
-        shaderProgram_ = ShaderUtils::linkProgram (gl, vs, fs, errorLog);
+        shaderProgram_ = ShaderUtils::linkProgram (gl, this, vs, fs, errorLog);
         if (shaderProgram_ == 0) { shaderError_ = true; return; }
 
         shaderCompiled_ = true;
@@ -92,9 +93,9 @@ void ColorGradeNode::renderFrame (juce::OpenGLContext& gl)
             return gl.extensions.glGetUniformLocation (shaderProgram_, name);
         };
 
-        float hueShift = getParamAsFloat ("hueShift", 0.0f);
-        float saturation = getParamAsFloat ("saturation", 1.0f);
-        float brightness = getParamAsFloat ("brightness", 1.0f);
+        float hueShift = getParamAsFloat (Param::hueShift);
+        float saturation = getParamAsFloat (Param::saturation);
+        float brightness = getParamAsFloat (Param::brightness);
 
         if (isInputConnected (1)) hueShift += getConnectedVisualValue (1) - 0.5f;
         if (isInputConnected (2)) saturation *= juce::jlimit (0.0f, 3.0f, getConnectedVisualValue (2) * 2.0f);
@@ -103,9 +104,9 @@ void ColorGradeNode::renderFrame (juce::OpenGLContext& gl)
         if (auto l = loc ("u_hueShift");   l >= 0) gl.extensions.glUniform1f (l, hueShift);
         if (auto l = loc ("u_saturation"); l >= 0) gl.extensions.glUniform1f (l, saturation);
         if (auto l = loc ("u_brightness"); l >= 0) gl.extensions.glUniform1f (l, brightness);
-        if (auto l = loc ("u_contrast");   l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat ("contrast", 1.0f));
-        if (auto l = loc ("u_gamma");      l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat ("gamma", 1.0f));
-        if (auto l = loc ("u_invert");     l >= 0) gl.extensions.glUniform1i (l, getParamAsInt ("invert", 0));
+        if (auto l = loc ("u_contrast");   l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat (Param::contrast));
+        if (auto l = loc ("u_gamma");      l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat (Param::gamma));
+        if (auto l = loc ("u_invert");     l >= 0) gl.extensions.glUniform1i (l, getParamAsInt (Param::invert));
 
         juce::gl::glActiveTexture (juce::gl::GL_TEXTURE0);
         juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D,
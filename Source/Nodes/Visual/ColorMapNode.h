@@ -23,11 +23,12 @@ public:
     juce::String getDisplayName() const override { return "Color Map"; }
     juce::String getCategory()    const override { return "Visual"; }
     bool isVisualNode()           const override { return true; }
+    bool isTimeDependent()        const override { return false; }
 
     void renderFrame (juce::OpenGLContext& /*gl*/) override
     {
         float value = juce::jlimit (0.f, 1.f, getConnectedVisualValue (0));
-        int palette = getParamAsInt ("palette", 0);
+        int palette = getParamAsInt (Param::palette);
 
         float r = 0.f, g = 0.f, b = 0.f;
 
@@ -65,6 +66,12 @@ public:
         setVisualOutputValue (2, b);
         setVisualOutputValue (3, 1.f);
     }
+
+private:
+    struct Param
+    {
+        enum Index : int { palette };
+    };
 };
 
 } // namespace pf
@@ -1,5 +1,7 @@
 #include "Nodes/Visual/DisplaceNode.h"
 #include <juce_opengl/juce_opengl.h>
+#include "Rendering/GLResourceRegistry.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
@@ -65,11 +67,11 @@ void DisplaceNode::ensureFBO (juce::OpenGLContext& gl, int width, int height)
 
     if (fbo_ != 0)
     {
-        gl.extensions.glDeleteFramebuffers (1, &fbo_);
-        juce::gl::glDeleteTextures (1, &fboTexture_);
+        GLResourceRegistry::instance().deleteFramebuffers (gl, this, 1, &fbo_);
+        GLResourceRegistry::instance().deleteTextures (this, 1, &fboTexture_);
     }
 
-    juce::gl::glGenTextures (1, &fboTexture_);
+    GLResourceRegistry::instance().genTextures (this, 1, &fboTexture_);
     juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D, fboTexture_);
     juce::gl::glTexImage2D (juce::gl::GL_TEXTURE_2D, 0, juce::gl::GL_RGBA8,
                             width, height, 0,
@@ -79,7 +81,7 @@ void DisplaceNode::ensureFBO (juce::OpenGLContext& gl, int width, int height)
     juce::gl::glTexParameteri (juce::gl::GL_TEXTURE_2D, juce::gl::GL_TEXTURE_WRAP_S, juce::gl::GL_CLAMP_TO_EDGE);
     juce::gl::glTexParameteri (juce::gl::GL_TEXTURE_2D, juce::gl::GL_TEXTURE_WRAP_T, juce::gl::GL_CLAMP_TO_EDGE);
 
-    gl.extensions.glGenFramebuffers (1, &fbo_);
+    GLResourceRegistry::instance().genFramebuffers (gl, this, 1, &fbo_);
     gl.extensions.glBindFramebuffer (juce::gl::GL_FRAMEBUFFER, fbo_);
     gl.extensions.glFramebufferTexture2D (juce::gl::GL_FRAMEBUFFER,
                                           juce::gl::GL_COLOR_ATTACHMENT0,
@@ -177,7 +179,7 @@ void DisplaceNode::compileShader (juce::OpenGLContext& gl)
         return;
     }
 
-    shaderProgram_ = gl.extensions.glCreateProgram();
+    shaderProgram_ = GLResourceRegistry::instance().createProgram (gl, this);
     gl.extensions.glAttachShader (shaderProgram_, vs);
     gl.extensions.glAttachShader (shaderProgram_, fs);
     gl.extensions.glLinkProgram (shaderProgram_);
@@ -191,7 +193,7 @@ void DisplaceNode::compileShader (juce::OpenGLContext& gl)
     if (! linked)
     {
         auto linkLog = getProgramInfoLog (gl, shaderProgram_);
-        gl.extensions.glDeleteProgram (shaderProgram_);
+        GLResourceRegistry::instance().deleteProgram (gl, this, shaderProgram_);
         shaderProgram_ = 0;
         shaderError_ = true;
         DBG ("DisplaceNode shader link error:\n" + linkLog);
@@ -208,7 +210,7 @@ void DisplaceNode::compileShader (juce::OpenGLContext& gl)
             -1.f,  1.f,
              1.f,  1.f
         };
-        gl.extensions.glGenBuffers (1, &quadVBO_);
+        GLResourceRegistry::instance().genBuffers (gl, this, 1, &quadVBO_);
         gl.extensions.glBindBuffer (juce::gl::GL_ARRAY_BUFFER, quadVBO_);
         gl.extensions.glBufferData (juce::gl::GL_ARRAY_BUFFER, sizeof (quadVerts), quadVerts, juce::gl::GL_STATIC_DRAW);
         gl.extensions.glBindBuffer (juce::gl::GL_ARRAY_BUFFER, 0);
@@ -219,7 +221,7 @@ void DisplaceNode::ensureFallbackTextures()
 {
     if (fallbackSourceTexture_ == 0)
     {
-        juce::gl::glGenTextures (1, &fallbackSourceTexture_);
+        GLResourceRegistry::instance().genTextures (this, 1, &fallbackSourceTexture_);
         juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D, fallbackSourceTexture_);
 
         const juce::uint8 blackPixel[4] = { 0, 0, 0, 255 };
@@ -235,7 +237,7 @@ void DisplaceNode::ensureFallbackTextures()
 
     if (fallbackDisplacementTexture_ == 0)
     {
-        juce::gl::glGenTextures (1, &fallbackDisplacementTexture_);
+        GLResourceRegistry::instance().genTextures (this, 1, &fallbackDisplacementTexture_);
         juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D, fallbackDisplacementTexture_);
 
         const juce::uint8 neutralPixel[4] = { 128, 128, 0, 255 };
@@ -252,8 +254,8 @@ void DisplaceNode::ensureFallbackTextures()
 
 void DisplaceNode::renderFrame (juce::OpenGLContext& gl)
 {
-    constexpr int width = 512;
-    constexpr int height = 512;
+    const int width = RenderConfig::getWidth();
+    const int height = RenderConfig::getHeight();
 
     ensureFBO (gl, width, height);
     compileShader (gl);
@@ -275,8 +277,8 @@ void DisplaceNode::renderFrame (juce::OpenGLContext& gl)
             return gl.extensions.glGetUniformLocation (shaderProgram_, name);
         };
 
-        float amount = getParamAsFloat ("amount", 0.03f);
-        float rotationDeg = getParamAsFloat ("rotationDeg", 0.0f);
+        float amount = getParamAsFloat (Param::amount);
+        float rotationDeg = getParamAsFloat (Param::rotationDeg);
 
         if (isInputConnected (2))
             amount *= juce::jlimit (0.0f, 2.0f, getConnectedVisualValue (2) * 2.0f);
@@ -293,10 +295,10 @@ void DisplaceNode::renderFrame (juce::OpenGLContext& gl)
             gl.extensions.glUniform1f (rotateLoc, juce::degreesToRadians (rotationDeg));
 
         if (auto modeLoc = loc ("u_mode"); modeLoc >= 0)
-            gl.extensions.glUniform1i (modeLoc, getParamAsInt ("mode", 1));
+            gl.extensions.glUniform1i (modeLoc, getParamAsInt (Param::mode));
 
         if (auto wrapLoc = loc ("u_wrap"); wrapLoc >= 0)
-            gl.extensions.glUniform1i (wrapLoc, getParamAsInt ("wrap", 1));
+            gl.extensions.glUniform1i (wrapLoc, getParamAsInt (Param::wrap));
 
         juce::gl::glActiveTexture (juce::gl::GL_TEXTURE0);
         juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D,
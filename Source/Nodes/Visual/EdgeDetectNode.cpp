@@ -1,16 +1,17 @@
 #include "Nodes/Visual/EdgeDetectNode.h"
 #include "Rendering/ShaderUtils.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
 
 void EdgeDetectNode::renderFrame (juce::OpenGLContext& gl)
 {
-    constexpr int width = 512, height = 512;
+    const int width = RenderConfig::getWidth(), height = RenderConfig::getHeight();
 
-    ShaderUtils::ensureFBO (gl, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
-    ShaderUtils::ensureQuadVBO (gl, quadVBO_);
-    ShaderUtils::ensureFallbackTexture (fallbackTexture_);
+    ShaderUtils::ensureFBO (gl, this, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
+    ShaderUtils::ensureQuadVBO (gl, this, quadVBO_);
+    ShaderUtils::ensureFallbackTexture (this, fallbackTexture_);
 
     if (! shaderCompiled_ && ! shaderError_)
     {
@@ -67,7 +68,7 @@ void EdgeDetectNode::renderFrame (juce::OpenGLContext& gl)
         auto fs = ShaderUtils::compileShaderStage (gl, juce::gl::GL_FRAGMENT_SHADER, fragSrc, errorLog);
         if (fs == 0) { gl.extensions.glDeleteShader (vs); shaderError_ = true; return; }
 
-        shaderProgram_ = ShaderUtils::linkProgram (gl, vs, fs, errorLog);
+        shaderProgram_ = ShaderUtils::linkProgram (gl, this, vs, fs, errorLog);
         if (shaderProgram_ == 0) { shaderError_ = true; return; }
 
         shaderCompiled_ = true;
@@ -89,14 +90,14 @@ void EdgeDetectNode::renderFrame (juce::OpenGLContext& gl)
             return gl.extensions.glGetUniformLocation (shaderProgram_, name);
         };
 
-        float strength = getParamAsFloat ("strength", 1.0f);
+        float strength = getParamAsFloat (Param::strength);
         if (isInputConnected (1)) strength *= juce::jlimit (0.0f, 5.0f, getConnectedVisualValue (1) * 3.0f);
 
         if (auto l = loc ("u_texel");    l >= 0) gl.extensions.glUniform2f (l, 1.0f / width, 1.0f / height);
-        if (auto l = loc ("u_mode");     l >= 0) gl.extensions.glUniform1i (l, getParamAsInt ("mode", 0));
+        if (auto l = loc ("u_mode");     l >= 0) gl.extensions.glUniform1i (l, getParamAsInt (Param::mode));
         if (auto l = loc ("u_strength"); l >= 0) gl.extensions.glUniform1f (l, strength);
-        if (auto l = loc ("u_invert");   l >= 0) gl.extensions.glUniform1i (l, getParamAsInt ("invert", 0));
-        if (auto l = loc ("u_overlay");  l >= 0) gl.extensions.glUniform1i (l, getParamAsInt ("overlay", 0));
+        if (auto l = loc ("u_invert");   l >= 0) gl.extensions.glUniform1i (l, getParamAsInt (Param::invert));
+        if (auto l = loc ("u_overlay");  l >= 0) gl.extensions.glUniform1i (l, getParamAsInt (Param::overlay));
 
         juce::gl::glActiveTexture (juce::gl::GL_TEXTURE0);
         juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D,
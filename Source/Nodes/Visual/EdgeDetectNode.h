@@ -26,10 +26,16 @@ public:
     juce::String getDisplayName() const override { return "Edge Detect"; }
     juce::String getCategory()    const override { return "Visual"; }
     bool isVisualNode()           const override { return true; }
+    bool isTimeDependent()        const override { return false; }
 
     void renderFrame (juce::OpenGLContext& gl) override;
 
 private:
+    struct Param
+    {
+        enum Index : int { mode, strength, invert, overlay };
+    };
+
     juce::uint32 fbo_ = 0, fboTexture_ = 0;
     int fboWidth_ = 0, fboHeight_ = 0;
     juce::uint32 shaderProgram_ = 0, quadVBO_ = 0, fallbackTexture_ = 0;
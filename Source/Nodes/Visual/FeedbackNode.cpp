@@ -1,5 +1,7 @@
 #include "Nodes/Visual/FeedbackNode.h"
 #include <juce_opengl/juce_opengl.h>
+#include "Rendering/GLResourceRegistry.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
@@ -65,14 +67,14 @@ void FeedbackNode::ensureResources (juce::OpenGLContext& gl, int width, int heig
 
     if (fbos_[0] != 0)
     {
-        gl.extensions.glDeleteFramebuffers (2, fbos_);
-        juce::gl::glDeleteTextures (2, textures_);
+        GLResourceRegistry::instance().deleteFramebuffers (gl, this, 2, fbos_);
+        GLResourceRegistry::instance().deleteTextures (this, 2, textures_);
         fbos_[0] = fbos_[1] = 0;
         textures_[0] = textures_[1] = 0;
     }
 
-    juce::gl::glGenTextures (2, textures_);
-    gl.extensions.glGenFramebuffers (2, fbos_);
+    GLResourceRegistry::instance().genTextures (this, 2, textures_);
+    GLResourceRegistry::instance().genFramebuffers (gl, this, 2, fbos_);
 
     for (int i = 0; i < 2; ++i)
     {
@@ -191,7 +193,7 @@ void FeedbackNode::compileShader (juce::OpenGLContext& gl)
         return;
     }
 
-    shaderProgram_ = gl.extensions.glCreateProgram();
+    shaderProgram_ = GLResourceRegistry::instance().createProgram (gl, this);
     gl.extensions.glAttachShader (shaderProgram_, vs);
     gl.extensions.glAttachShader (shaderProgram_, fs);
     gl.extensions.glLinkProgram (shaderProgram_);
@@ -205,7 +207,7 @@ void FeedbackNode::compileShader (juce::OpenGLContext& gl)
     if (! linked)
     {
         auto linkLog = getProgramInfoLog (gl, shaderProgram_);
-        gl.extensions.glDeleteProgram (shaderProgram_);
+        GLResourceRegistry::instance().deleteProgram (gl, this, shaderProgram_);
         shaderProgram_ = 0;
         shaderError_ = true;
         DBG ("FeedbackNode shader link error:\n" + linkLog);
@@ -222,7 +224,7 @@ void FeedbackNode::compileShader (juce::OpenGLContext& gl)
             -1.f,  1.f,
              1.f,  1.f
         };
-        gl.extensions.glGenBuffers (1, &quadVBO_);
+        GLResourceRegistry::instance().genBuffers (gl, this, 1, &quadVBO_);
         gl.extensions.glBindBuffer (juce::gl::GL_ARRAY_BUFFER, quadVBO_);
         gl.extensions.glBufferData (juce::gl::GL_ARRAY_BUFFER, sizeof (quadVerts), quadVerts, juce::gl::GL_STATIC_DRAW);
         gl.extensions.glBindBuffer (juce::gl::GL_ARRAY_BUFFER, 0);
@@ -234,7 +236,7 @@ void FeedbackNode::ensureFallbackTexture()
     if (fallbackTexture_ != 0)
         return;
 
-    juce::gl::glGenTextures (1, &fallbackTexture_);
+    GLResourceRegistry::instance().genTextures (this, 1, &fallbackTexture_);
     juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D, fallbackTexture_);
 
     const juce::uint8 blackPixel[4] = { 0, 0, 0, 255 };
@@ -250,8 +252,8 @@ void FeedbackNode::ensureFallbackTexture()
 
 void FeedbackNode::renderFrame (juce::OpenGLContext& gl)
 {
-    constexpr int width = 512;
-    constexpr int height = 512;
+    const int width = RenderConfig::getWidth();
+    const int height = RenderConfig::getHeight();
 
     ensureResources (gl, width, height);
     compileShader (gl);
@@ -276,9 +278,9 @@ void FeedbackNode::renderFrame (juce::OpenGLContext& gl)
             return gl.extensions.glGetUniformLocation (shaderProgram_, name);
         };
 
-        float feedbackAmount = getParamAsFloat ("feedback", 0.82f);
-        float offsetX = getParamAsFloat ("offsetX", 0.002f);
-        float offsetY = getParamAsFloat ("offsetY", 0.001f);
+        float feedbackAmount = getParamAsFloat (Param::feedback);
+        float offsetX = getParamAsFloat (Param::offsetX);
+        float offsetY = getParamAsFloat (Param::offsetY);
 
         if (isInputConnected (1))
             feedbackAmount = juce::jlimit (0.0f, 0.99f, feedbackAmount + (getConnectedVisualValue (1) - 0.5f));
@@ -290,9 +292,9 @@ void FeedbackNode::renderFrame (juce::OpenGLContext& gl)
         if (isInputConnected (3))
             offsetY += getConnectedVisualValue (3) * 0.02f;
 
-        const auto mixAmount = juce::jlimit (0.0f, 1.0f, getParamAsFloat ("mix", 1.0f));
-        const auto zoom = juce::jlimit (0.5f, 2.0f, getParamAsFloat ("zoom", 1.0f));
-        const auto rotationRad = juce::degreesToRadians (getParamAsFloat ("rotationDeg", 0.0f));
+        const auto mixAmount = juce::jlimit (0.0f, 1.0f, getParamAsFloat (Param::mix));
+        const auto zoom = juce::jlimit (0.5f, 2.0f, getParamAsFloat (Param::zoom));
+        const auto rotationRad = juce::degreesToRadians (getParamAsFloat (Param::rotationDeg));
 
         if (auto feedbackLoc = loc ("u_feedback"); feedbackLoc >= 0)
             gl.extensions.glUniform1f (feedbackLoc, feedbackAmount);
@@ -310,7 +312,7 @@ void FeedbackNode::renderFrame (juce::OpenGLContext& gl)
             gl.extensions.glUniform1f (rotationLoc, rotationRad);
 
         if (auto wrapLoc = loc ("u_wrap"); wrapLoc >= 0)
-            gl.extensions.glUniform1i (wrapLoc, getParamAsInt ("wrap", 1));
+            gl.extensions.glUniform1i (wrapLoc, getParamAsInt (Param::wrap));
 
         juce::gl::glActiveTexture (juce::gl::GL_TEXTURE0);
         juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D,
@@ -33,6 +33,11 @@ public:
     void renderFrame (juce::OpenGLContext& gl) override;
 
 private:
+    struct Param
+    {
+        enum Index : int { feedback, mix, offsetX, offsetY, zoom, rotationDeg, wrap };
+    };
+
     void ensureResources (juce::OpenGLContext& gl, int width, int height);
     void compileShader (juce::OpenGLContext& gl);
     void ensureFallbackTexture();
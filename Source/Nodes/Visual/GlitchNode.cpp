@@ -1,16 +1,17 @@
 #include "Nodes/Visual/GlitchNode.h"
 #include "Rendering/ShaderUtils.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
 
 void GlitchNode::renderFrame (juce::OpenGLContext& gl)
 {
-    constexpr int width = 512, height = 512;
+    const int width = RenderConfig::getWidth(), height = RenderConfig::getHeight();
 
-    ShaderUtils::ensureFBO (gl, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
-    ShaderUtils::ensureQuadVBO (gl, quadVBO_);
-    ShaderUtils::ensureFallbackTexture (fallbackTexture_);
+    ShaderUtils::ensureFBO (gl, this, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
+    ShaderUtils::ensureQuadVBO (gl, this, quadVBO_);
+    ShaderUtils::ensureFallbackTexture (this, fallbackTexture_);
 
     if (! shaderCompiled_ && ! shaderError_)
     {
@@ -67,7 +68,7 @@ void GlitchNode::renderFrame (juce::OpenGLContext& gl)
         auto fs = ShaderUtils::compileShaderStage (gl, juce::gl::GL_FRAGMENT_SHADER, fragSrc, errorLog);
         if (fs == 0) { gl.extensions.glDeleteShader (vs); shaderError_ = true; return; }
 
-        shaderProgram_ = ShaderUtils::linkProgram (gl, vs, fs, errorLog);
+        shaderProgram_ = ShaderUtils::linkProgram (gl, this, vs, fs, errorLog);
         if (shaderProgram_ == 0) { shaderError_ = true; return; }
 
         shaderCompiled_ = true;
@@ -84,22 +85,22 @@ void GlitchNode::renderFrame (juce::OpenGLContext& gl)
     else
     {
         gl.extensions.glUseProgram (shaderProgram_);
-        time_ += (1.0f / 60.0f) * getParamAsFloat ("speed", 1.0f);
+        time_ += frameSeconds_ * getParamAsFloat (Param::speed);
 
         auto loc = [&] (const char* name) {
             return gl.extensions.glGetUniformLocation (shaderProgram_, name);
         };
 
-        float intensity = getParamAsFloat ("intensity", 0.3f);
+        float intensity = getParamAsFloat (Param::intensity);
         if (isInputConnected (1)) intensity *= juce::jlimit (0.0f, 4.0f, getConnectedVisualValue (1) * 2.0f);
-        if (isInputConnected (2)) intensity = juce::jmax (intensity, getConnectedVisualValue (2));
+        if (isInputConnected (2)) intensity = juce::jmax (intensity, getConnectedVisualPeak (2));
 
         if (auto l = loc ("u_time");      l >= 0) gl.extensions.glUniform1f (l, time_);
         if (auto l = loc ("u_intensity"); l >= 0) gl.extensions.glUniform1f (l, intensity);
-        if (auto l = loc ("u_blockSize"); l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat ("blockSize", 0.05f));
-        if (auto l = loc ("u_rgbSplit");  l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat ("rgbSplit", 0.01f));
-        if (auto l = loc ("u_scanlines"); l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat ("scanlines", 0.5f));
-        if (auto l = loc ("u_noise");     l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat ("noiseAmount", 0.1f));
+        if (auto l = loc ("u_blockSize"); l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat (Param::blockSize));
+        if (auto l = loc ("u_rgbSplit");  l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat (Param::rgbSplit));
+        if (auto l = loc ("u_scanlines"); l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat (Param::scanlines));
+        if (auto l = loc ("u_noise");     l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat (Param::noiseAmount));
 
         juce::gl::glActiveTexture (juce::gl::GL_TEXTURE0);
         juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D,
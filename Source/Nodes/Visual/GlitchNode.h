@@ -30,6 +30,11 @@ public:
     void renderFrame (juce::OpenGLContext& gl) override;
 
 private:
+    struct Param
+    {
+        enum Index : int { intensity, blockSize, rgbSplit, scanlines, noiseAmount, speed };
+    };
+
     juce::uint32 fbo_ = 0, fboTexture_ = 0;
     int fboWidth_ = 0, fboHeight_ = 0;
     juce::uint32 shaderProgram_ = 0, quadVBO_ = 0, fallbackTexture_ = 0;
@@ -1,15 +1,16 @@
 #include "Nodes/Visual/GradientNode.h"
 #include "Rendering/ShaderUtils.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
 
 void GradientNode::renderFrame (juce::OpenGLContext& gl)
 {
-    constexpr int width = 512, height = 512;
+    const int width = RenderConfig::getWidth(), height = RenderConfig::getHeight();
 
-    ShaderUtils::ensureFBO (gl, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
-    ShaderUtils::ensureQuadVBO (gl, quadVBO_);
+    ShaderUtils::ensureFBO (gl, this, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
+    ShaderUtils::ensureQuadVBO (gl, this, quadVBO_);
 
     if (! shaderCompiled_ && ! shaderError_)
     {
@@ -50,7 +51,7 @@ void GradientNode::renderFrame (juce::OpenGLContext& gl)
         auto fs = ShaderUtils::compileShaderStage (gl, juce::gl::GL_FRAGMENT_SHADER, fragSrc, errorLog);
         if (fs == 0) { gl.extensions.glDeleteShader (vs); shaderError_ = true; return; }
 
-        shaderProgram_ = ShaderUtils::linkProgram (gl, vs, fs, errorLog);
+        shaderProgram_ = ShaderUtils::linkProgram (gl, this, vs, fs, errorLog);
         if (shaderProgram_ == 0) { shaderError_ = true; return; }
 
         shaderCompiled_ = true;
@@ -72,22 +73,22 @@ void GradientNode::renderFrame (juce::OpenGLContext& gl)
             return gl.extensions.glGetUniformLocation (shaderProgram_, name);
         };
 
-        float rotation = juce::degreesToRadians (getParamAsFloat ("rotation", 0.0f));
-        float offset = getParamAsFloat ("offset", 0.0f);
-        float spread = getParamAsFloat ("spread", 1.0f);
+        float rotation = juce::degreesToRadians (getParamAsFloat (Param::rotation));
+        float offset = getParamAsFloat (Param::offset);
+        float spread = getParamAsFloat (Param::spread);
 
         if (isInputConnected (0)) rotation += getConnectedVisualValue (0) * 6.283f;
         if (isInputConnected (1)) offset += getConnectedVisualValue (1) - 0.5f;
         if (isInputConnected (2)) spread *= juce::jlimit (0.1f, 4.0f, getConnectedVisualValue (2) * 2.0f);
 
-        if (auto l = loc ("u_type");     l >= 0) gl.extensions.glUniform1i (l, getParamAsInt ("gradientType", 0));
+        if (auto l = loc ("u_type");     l >= 0) gl.extensions.glUniform1i (l, getParamAsInt (Param::gradientType));
         if (auto l = loc ("u_rotation"); l >= 0) gl.extensions.glUniform1f (l, rotation);
         if (auto l = loc ("u_offset");   l >= 0) gl.extensions.glUniform1f (l, offset);
         if (auto l = loc ("u_spread");   l >= 0) gl.extensions.glUniform1f (l, spread);
         if (auto l = loc ("u_colorA");   l >= 0) gl.extensions.glUniform3f (l,
-            getParamAsFloat ("colorA_r", 0.0f), getParamAsFloat ("colorA_g", 0.0f), getParamAsFloat ("colorA_b", 0.0f));
+            getParamAsFloat (Param::colorA_r), getParamAsFloat (Param::colorA_g), getParamAsFloat (Param::colorA_b));
         if (auto l = loc ("u_colorB");   l >= 0) gl.extensions.glUniform3f (l,
-            getParamAsFloat ("colorB_r", 1.0f), getParamAsFloat ("colorB_g", 1.0f), getParamAsFloat ("colorB_b", 1.0f));
+            getParamAsFloat (Param::colorB_r), getParamAsFloat (Param::colorB_g), getParamAsFloat (Param::colorB_b));
 
         ShaderUtils::drawFullscreenQuad (gl, shaderProgram_, quadVBO_);
         gl.extensions.glUseProgram (0);
@@ -1,5 +1,7 @@
 #include "Nodes/Visual/KaleidoscopeNode.h"
 #include <juce_opengl/juce_opengl.h>
+#include "Rendering/GLResourceRegistry.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
@@ -65,11 +67,11 @@ void KaleidoscopeNode::ensureFBO (juce::OpenGLContext& gl, int width, int height
 
     if (fbo_ != 0)
     {
-        gl.extensions.glDeleteFramebuffers (1, &fbo_);
-        juce::gl::glDeleteTextures (1, &fboTexture_);
+        GLResourceRegistry::instance().deleteFramebuffers (gl, this, 1, &fbo_);
+        GLResourceRegistry::instance().deleteTextures (this, 1, &fboTexture_);
     }
 
-    juce::gl::glGenTextures (1, &fboTexture_);
+    GLResourceRegistry::instance().genTextures (this, 1, &fboTexture_);
     juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D, fboTexture_);
     juce::gl::glTexImage2D (juce::gl::GL_TEXTURE_2D, 0, juce::gl::GL_RGBA8,
                             width, height, 0,
@@ -79,7 +81,7 @@ void KaleidoscopeNode::ensureFBO (juce::OpenGLContext& gl, int width, int height
     juce::gl::glTexParameteri (juce::gl::GL_TEXTURE_2D, juce::gl::GL_TEXTURE_WRAP_S, juce::gl::GL_CLAMP_TO_EDGE);
     juce::gl::glTexParameteri (juce::gl::GL_TEXTURE_2D, juce::gl::GL_TEXTURE_WRAP_T, juce::gl::GL_CLAMP_TO_EDGE);
 
-    gl.extensions.glGenFramebuffers (1, &fbo_);
+    GLResourceRegistry::instance().genFramebuffers (gl, this, 1, &fbo_);
     gl.extensions.glBindFramebuffer (juce::gl::GL_FRAMEBUFFER, fbo_);
     gl.extensions.glFramebufferTexture2D (juce::gl::GL_FRAMEBUFFER,
                                           juce::gl::GL_COLOR_ATTACHMENT0,
@@ -174,7 +176,7 @@ void KaleidoscopeNode::compileShader (juce::OpenGLContext& gl)
         return;
     }
 
-    shaderProgram_ = gl.extensions.glCreateProgram();
+    shaderProgram_ = GLResourceRegistry::instance().createProgram (gl, this);
     gl.extensions.glAttachShader (shaderProgram_, vs);
     gl.extensions.glAttachShader (shaderProgram_, fs);
     gl.extensions.glLinkProgram (shaderProgram_);
@@ -188,7 +190,7 @@ void KaleidoscopeNode::compileShader (juce::OpenGLContext& gl)
     if (! linked)
     {
         auto linkLog = getProgramInfoLog (gl, shaderProgram_);
-        gl.extensions.glDeleteProgram (shaderProgram_);
+        GLResourceRegistry::instance().deleteProgram (gl, this, shaderProgram_);
         shaderProgram_ = 0;
         shaderError_ = true;
         DBG ("KaleidoscopeNode shader link error:\n" + linkLog);
@@ -205,7 +207,7 @@ void KaleidoscopeNode::compileShader (juce::OpenGLContext& gl)
             -1.f,  1.f,
              1.f,  1.f
         };
-        gl.extensions.glGenBuffers (1, &quadVBO_);
+        GLResourceRegistry::instance().genBuffers (gl, this, 1, &quadVBO_);
         gl.extensions.glBindBuffer (juce::gl::GL_ARRAY_BUFFER, quadVBO_);
         gl.extensions.glBufferData (juce::gl::GL_ARRAY_BUFFER, sizeof (quadVerts), quadVerts, juce::gl::GL_STATIC_DRAW);
         gl.extensions.glBindBuffer (juce::gl::GL_ARRAY_BUFFER, 0);
@@ -217,7 +219,7 @@ void KaleidoscopeNode::ensureFallbackTexture()
     if (fallbackTexture_ != 0)
         return;
 
-    juce::gl::glGenTextures (1, &fallbackTexture_);
+    GLResourceRegistry::instance().genTextures (this, 1, &fallbackTexture_);
     juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D, fallbackTexture_);
 
     const juce::uint8 blackPixel[4] = { 0, 0, 0, 255 };
@@ -233,8 +235,8 @@ void KaleidoscopeNode::ensureFallbackTexture()
 
 void KaleidoscopeNode::renderFrame (juce::OpenGLContext& gl)
 {
-    constexpr int width = 512;
-    constexpr int height = 512;
+    const int width = RenderConfig::getWidth();
+    const int height = RenderConfig::getHeight();
 
     ensureFBO (gl, width, height);
     compileShader (gl);
@@ -256,9 +258,9 @@ void KaleidoscopeNode::renderFrame (juce::OpenGLContext& gl)
             return gl.extensions.glGetUniformLocation (shaderProgram_, name);
         };
 
-        int segments = getParamAsInt ("segments", 6);
-        float rotationDeg = getParamAsFloat ("rotationDeg", 0.0f);
-        float zoom = getParamAsFloat ("zoom", 1.0f);
+        int segments = getParamAsInt (Param::segments);
+        float rotationDeg = getParamAsFloat (Param::rotationDeg);
+        float zoom = getParamAsFloat (Param::zoom);
 
         if (isInputConnected (1))
             segments += juce::roundToInt ((getConnectedVisualValue (1) - 0.5f) * 12.0f);
@@ -282,10 +284,10 @@ void KaleidoscopeNode::renderFrame (juce::OpenGLContext& gl)
             gl.extensions.glUniform1f (zoomLoc, zoom);
 
         if (auto mirrorLoc = loc ("u_mirror"); mirrorLoc >= 0)
-            gl.extensions.glUniform1i (mirrorLoc, getParamAsInt ("mirror", 1));
+            gl.extensions.glUniform1i (mirrorLoc, getParamAsInt (Param::mirror));
 
         if (auto wrapLoc = loc ("u_wrap"); wrapLoc >= 0)
-            gl.extensions.glUniform1i (wrapLoc, getParamAsInt ("wrap", 1));
+            gl.extensions.glUniform1i (wrapLoc, getParamAsInt (Param::wrap));
 
         juce::gl::glActiveTexture (juce::gl::GL_TEXTURE0);
         juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D,
@@ -31,11 +31,11 @@ public:
 
     void renderFrame (juce::OpenGLContext& /*gl*/) override
     {
-        float freq = getParamAsFloat ("frequency", 1.0f);
-        float amp = getParamAsFloat ("amplitude", 1.0f);
-        float offset = getParamAsFloat ("offset", 0.5f);
-        float phaseOffset = getParamAsFloat ("phase", 0.0f);
-        int waveform = getParamAsInt ("waveform", 0);
+        float freq = getParamAsFloat (Param::frequency);
+        float amp = getParamAsFloat (Param::amplitude);
+        float offset = getParamAsFloat (Param::offset);
+        float phaseOffset = getParamAsFloat (Param::phase);
+        int waveform = getParamAsInt (Param::waveform);
 
         if (isInputConnected (0)) freq *= juce::jlimit (0.01f, 8.0f, getConnectedVisualValue (0) * 4.0f);
         if (isInputConnected (1)) amp *= juce::jlimit (0.0f, 2.0f, getConnectedVisualValue (1));
@@ -43,13 +43,13 @@ public:
         // Sync: reset phase on rising edge
         if (isInputConnected (2))
         {
-            float syncVal = getConnectedVisualValue (2);
+            float syncVal = getConnectedVisualPeak (2);
             if (syncVal > 0.5f && lastSync_ <= 0.5f)
                 phase_ = 0.0f;
             lastSync_ = syncVal;
         }
 
-        phase_ += freq / 60.0f; // 60fps
+        phase_ += freq * frameSeconds_;
         if (phase_ > 1.0f) phase_ -= std::floor (phase_);
 
         float p = std::fmod (phase_ + phaseOffset, 1.0f);
@@ -92,6 +92,11 @@ public:
     }
 
 private:
+    struct Param
+    {
+        enum Index : int { waveform, frequency, amplitude, offset, phase };
+    };
+
     float phase_ = 0.0f;
     float lastSync_ = 0.0f;
     float lastRandomValue_ = 0.5f;
@@ -1,16 +1,17 @@
 #include "Nodes/Visual/MirrorNode.h"
 #include "Rendering/ShaderUtils.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
 
 void MirrorNode::renderFrame (juce::OpenGLContext& gl)
 {
-    constexpr int width = 512, height = 512;
+    const int width = RenderConfig::getWidth(), height = RenderConfig::getHeight();
 
-    ShaderUtils::ensureFBO (gl, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
-    ShaderUtils::ensureQuadVBO (gl, quadVBO_);
-    ShaderUtils::ensureFallbackTexture (fallbackTexture_);
+    ShaderUtils::ensureFBO (gl, this, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
+    ShaderUtils::ensureQuadVBO (gl, this, quadVBO_);
+    ShaderUtils::ensureFallbackTexture (this, fallbackTexture_);
 
     if (! shaderCompiled_ && ! shaderError_)
     {
@@ -52,7 +53,7 @@ void MirrorNode::renderFrame (juce::OpenGLContext& gl)
         auto fs = ShaderUtils::compileShaderStage (gl, juce::gl::GL_FRAGMENT_SHADER, fragSrc, errorLog);
         if (fs == 0) { gl.extensions.glDeleteShader (vs); shaderError_ = true; return; }
 
-        shaderProgram_ = ShaderUtils::linkProgram (gl, vs, fs, errorLog);
+        shaderProgram_ = ShaderUtils::linkProgram (gl, this, vs, fs, errorLog);
         if (shaderProgram_ == 0) { shaderError_ = true; return; }
 
         shaderCompiled_ = true;
@@ -74,12 +75,12 @@ void MirrorNode::renderFrame (juce::OpenGLContext& gl)
             return gl.extensions.glGetUniformLocation (shaderProgram_, name);
         };
 
-        float offset = getParamAsFloat ("offset", 0.5f);
+        float offset = getParamAsFloat (Param::offset);
         if (isInputConnected (1)) offset += getConnectedVisualValue (1) - 0.5f;
 
-        if (auto l = loc ("u_mode");     l >= 0) gl.extensions.glUniform1i (l, getParamAsInt ("mode", 0));
+        if (auto l = loc ("u_mode");     l >= 0) gl.extensions.glUniform1i (l, getParamAsInt (Param::mode));
         if (auto l = loc ("u_offset");   l >= 0) gl.extensions.glUniform1f (l, offset);
-        if (auto l = loc ("u_segments"); l >= 0) gl.extensions.glUniform1i (l, getParamAsInt ("segments", 4));
+        if (auto l = loc ("u_segments"); l >= 0) gl.extensions.glUniform1i (l, getParamAsInt (Param::segments));
 
         juce::gl::glActiveTexture (juce::gl::GL_TEXTURE0);
         juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D,
@@ -1,15 +1,16 @@
 #include "Nodes/Visual/NoiseNode.h"
 #include "Rendering/ShaderUtils.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
 
 void NoiseNode::renderFrame (juce::OpenGLContext& gl)
 {
-    constexpr int width = 512, height = 512;
+    const int width = RenderConfig::getWidth(), height = RenderConfig::getHeight();
 
-    ShaderUtils::ensureFBO (gl, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
-    ShaderUtils::ensureQuadVBO (gl, quadVBO_);
+    ShaderUtils::ensureFBO (gl, this, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
+    ShaderUtils::ensureQuadVBO (gl, this, quadVBO_);
 
     if (! shaderCompiled_ && ! shaderError_)
     {
@@ -152,7 +153,7 @@ void NoiseNode::renderFrame (juce::OpenGLContext& gl)
         auto fs = ShaderUtils::compileShaderStage (gl, juce::gl::GL_FRAGMENT_SHADER, fragSrc, errorLog);
         if (fs == 0) { gl.extensions.glDeleteShader (vs); shaderError_ = true; DBG ("NoiseNode FS error: " + errorLog); return; }
 
-        shaderProgram_ = ShaderUtils::linkProgram (gl, vs, fs, errorLog);
+        shaderProgram_ = ShaderUtils::linkProgram (gl, this, vs, fs, errorLog);
         if (shaderProgram_ == 0) { shaderError_ = true; DBG ("NoiseNode link error: " + errorLog); return; }
 
         shaderCompiled_ = true;
@@ -169,14 +170,14 @@ void NoiseNode::renderFrame (juce::OpenGLContext& gl)
     else
     {
         gl.extensions.glUseProgram (shaderProgram_);
-        time_ += 1.0f / 60.0f;
+        time_ += frameSeconds_;
 
         auto loc = [&] (const char* name) {
             return gl.extensions.glGetUniformLocation (shaderProgram_, name);
         };
 
-        float scale = getParamAsFloat ("scale", 4.0f);
-        float speed = getParamAsFloat ("speed", 0.3f);
+        float scale = getParamAsFloat (Param::scale);
+        float speed = getParamAsFloat (Param::speed);
         float offsetX = 0.0f, offsetY = 0.0f;
 
         if (isInputConnected (0)) scale *= juce::jlimit (0.1f, 8.0f, getConnectedVisualValue (0) * 4.0f);
@@ -188,12 +189,12 @@ void NoiseNode::renderFrame (juce::OpenGLContext& gl)
         if (auto l = loc ("u_scale");       l >= 0) gl.extensions.glUniform1f (l, scale);
         if (auto l = loc ("u_speed");       l >= 0) gl.extensions.glUniform1f (l, speed);
         if (auto l = loc ("u_offset");      l >= 0) gl.extensions.glUniform2f (l, offsetX, offsetY);
-        if (auto l = loc ("u_noiseType");   l >= 0) gl.extensions.glUniform1i (l, getParamAsInt ("noiseType", 0));
-        if (auto l = loc ("u_octaves");     l >= 0) gl.extensions.glUniform1i (l, getParamAsInt ("octaves", 4));
-        if (auto l = loc ("u_lacunarity");  l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat ("lacunarity", 2.0f));
-        if (auto l = loc ("u_persistence"); l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat ("persistence", 0.5f));
-        if (auto l = loc ("u_domainWarp");  l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat ("domainWarp", 0.0f));
-        if (auto l = loc ("u_colorize");    l >= 0) gl.extensions.glUniform1i (l, getParamAsInt ("colorize", 0));
+        if (auto l = loc ("u_noiseType");   l >= 0) gl.extensions.glUniform1i (l, getParamAsInt (Param::noiseType));
+        if (auto l = loc ("u_octaves");     l >= 0) gl.extensions.glUniform1i (l, getParamAsInt (Param::octaves));
+        if (auto l = loc ("u_lacunarity");  l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat (Param::lacunarity));
+        if (auto l = loc ("u_persistence"); l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat (Param::persistence));
+        if (auto l = loc ("u_domainWarp");  l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat (Param::domainWarp));
+        if (auto l = loc ("u_colorize");    l >= 0) gl.extensions.glUniform1i (l, getParamAsInt (Param::colorize));
 
         ShaderUtils::drawFullscreenQuad (gl, shaderProgram_, quadVBO_);
         gl.extensions.glUseProgram (0);
@@ -31,10 +31,19 @@ public:
     juce::String getDisplayName() const override { return "Noise"; }
     juce::String getCategory()    const override { return "Visual"; }
     bool isVisualNode()           const override { return true; }
+    bool isTimeDependent()        const override { return getParamAsFloat (Param::speed) != 0.f; }
 
     void renderFrame (juce::OpenGLContext& gl) override;
 
 private:
+    struct Param
+    {
+        enum Index : int
+        {
+            noiseType, scale, speed, octaves, lacunarity, persistence, domainWarp, colorize
+        };
+    };
+
     juce::uint32 fbo_ = 0;
     juce::uint32 fboTexture_ = 0;
     int fboWidth_ = 0, fboHeight_ = 0;
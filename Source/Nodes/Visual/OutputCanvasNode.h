@@ -19,6 +19,7 @@ public:
     juce::String getDisplayName() const override { return "Output Canvas"; }
     juce::String getCategory()    const override { return "Visual"; }
     bool isVisualNode()           const override { return true; }
+    bool isSink()                 const override { return true; }
 
     void renderFrame (juce::OpenGLContext& gl) override;
 
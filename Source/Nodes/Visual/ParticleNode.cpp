@@ -1,20 +1,21 @@
 #include "Nodes/Visual/ParticleNode.h"
 #include "Rendering/ShaderUtils.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
 
 void ParticleNode::renderFrame (juce::OpenGLContext& gl)
 {
-    constexpr int width = 512, height = 512;
-    constexpr float dt = 1.0f / 60.0f;
+    const int width = RenderConfig::getWidth(), height = RenderConfig::getHeight();
+    const float dt = frameSeconds_;
 
-    ShaderUtils::ensureFBO (gl, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
-    ShaderUtils::ensureFallbackTexture (fallbackTexture_);
+    ShaderUtils::ensureFBO (gl, this, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
+    ShaderUtils::ensureFallbackTexture (this, fallbackTexture_);
 
     // Determine pool size
     static const int poolSizes[] = { 1000, 4000, 16000, 64000 };
-    int desiredPool = poolSizes[juce::jlimit (0, 3, getParamAsInt ("maxParticles", 1))];
+    int desiredPool = poolSizes[juce::jlimit (0, 3, getParamAsInt (Param::maxParticles))];
     if (desiredPool != poolSize_)
     {
         particles_.resize (static_cast<size_t> (desiredPool));
@@ -24,14 +25,14 @@ void ParticleNode::renderFrame (juce::OpenGLContext& gl)
     }
 
     // Params
-    float emissionRate = getParamAsFloat ("emissionRate", 50.0f);
-    float lifetime = getParamAsFloat ("lifetime", 2.0f);
-    float speed = getParamAsFloat ("speed", 0.3f);
-    float gravity = getParamAsFloat ("gravity", 0.0f);
-    float turbulence = getParamAsFloat ("turbulence", 0.1f);
-    float size = getParamAsFloat ("size", 3.0f);
-    int emitterShape = getParamAsInt ("emitterShape", 0);
-    int blendMode = getParamAsInt ("blendMode", 0);
+    float emissionRate = getParamAsFloat (Param::emissionRate);
+    float lifetime = getParamAsFloat (Param::lifetime);
+    float speed = getParamAsFloat (Param::speed);
+    float gravity = getParamAsFloat (Param::gravity);
+    float turbulence = getParamAsFloat (Param::turbulence);
+    float size = getParamAsFloat (Param::size);
+    int emitterShape = getParamAsInt (Param::emitterShape);
+    int blendMode = getParamAsInt (Param::blendMode);
 
     if (isInputConnected (0)) emissionRate *= juce::jlimit (0.0f, 4.0f, getConnectedVisualValue (0) * 2.0f);
     if (isInputConnected (1)) speed *= juce::jlimit (0.0f, 4.0f, getConnectedVisualValue (1) * 2.0f);
@@ -41,6 +41,15 @@ public:
     void renderFrame (juce::OpenGLContext& gl) override;
 
 private:
+    struct Param
+    {
+        enum Index : int
+        {
+            maxParticles, emissionRate, lifetime, speed, gravity, turbulence, size, emitterShape,
+            blendMode
+        };
+    };
+
     struct Particle
     {
         float x = 0, y = 0;
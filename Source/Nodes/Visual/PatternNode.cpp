@@ -1,15 +1,16 @@
 #include "Nodes/Visual/PatternNode.h"
 #include "Rendering/ShaderUtils.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
 
 void PatternNode::renderFrame (juce::OpenGLContext& gl)
 {
-    constexpr int width = 512, height = 512;
+    const int width = RenderConfig::getWidth(), height = RenderConfig::getHeight();
 
-    ShaderUtils::ensureFBO (gl, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
-    ShaderUtils::ensureQuadVBO (gl, quadVBO_);
+    ShaderUtils::ensureFBO (gl, this, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
+    ShaderUtils::ensureQuadVBO (gl, this, quadVBO_);
 
     if (! shaderCompiled_ && ! shaderError_)
     {
@@ -77,7 +78,7 @@ void PatternNode::renderFrame (juce::OpenGLContext& gl)
         auto fs = ShaderUtils::compileShaderStage (gl, juce::gl::GL_FRAGMENT_SHADER, fragSrc, errorLog);
         if (fs == 0) { gl.extensions.glDeleteShader (vs); shaderError_ = true; return; }
 
-        shaderProgram_ = ShaderUtils::linkProgram (gl, vs, fs, errorLog);
+        shaderProgram_ = ShaderUtils::linkProgram (gl, this, vs, fs, errorLog);
         if (shaderProgram_ == 0) { shaderError_ = true; return; }
 
         shaderCompiled_ = true;
@@ -94,26 +95,26 @@ void PatternNode::renderFrame (juce::OpenGLContext& gl)
     else
     {
         gl.extensions.glUseProgram (shaderProgram_);
-        time_ += (1.0f / 60.0f) * getParamAsFloat ("speed", 0.0f);
+        time_ += frameSeconds_ * getParamAsFloat (Param::speed);
 
         auto loc = [&] (const char* name) {
             return gl.extensions.glGetUniformLocation (shaderProgram_, name);
         };
 
-        float freq = getParamAsFloat ("frequency", 8.0f);
-        float rotation = juce::degreesToRadians (getParamAsFloat ("rotation", 0.0f));
-        float thickness = getParamAsFloat ("thickness", 0.5f);
+        float freq = getParamAsFloat (Param::frequency);
+        float rotation = juce::degreesToRadians (getParamAsFloat (Param::rotation));
+        float thickness = getParamAsFloat (Param::thickness);
 
         if (isInputConnected (0)) freq *= juce::jlimit (0.1f, 8.0f, getConnectedVisualValue (0) * 4.0f);
         if (isInputConnected (1)) rotation += getConnectedVisualValue (1) * 6.283f;
         if (isInputConnected (2)) thickness *= juce::jlimit (0.1f, 2.0f, getConnectedVisualValue (2));
 
-        if (auto l = loc ("u_type");      l >= 0) gl.extensions.glUniform1i (l, getParamAsInt ("patternType", 0));
+        if (auto l = loc ("u_type");      l >= 0) gl.extensions.glUniform1i (l, getParamAsInt (Param::patternType));
         if (auto l = loc ("u_freq");      l >= 0) gl.extensions.glUniform1f (l, freq);
         if (auto l = loc ("u_rotation");  l >= 0) gl.extensions.glUniform1f (l, rotation);
         if (auto l = loc ("u_thickness"); l >= 0) gl.extensions.glUniform1f (l, thickness);
         if (auto l = loc ("u_time");      l >= 0) gl.extensions.glUniform1f (l, time_);
-        if (auto l = loc ("u_softness");  l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat ("softness", 0.02f));
+        if (auto l = loc ("u_softness");  l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat (Param::softness));
 
         ShaderUtils::drawFullscreenQuad (gl, shaderProgram_, quadVBO_);
         gl.extensions.glUseProgram (0);
@@ -1,12 +1,14 @@
 #include "Nodes/Visual/ReactionDiffusionNode.h"
 #include "Rendering/ShaderUtils.h"
+#include "Rendering/GLResourceRegistry.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
 
 namespace
 {
-juce::uint32 compileRDShader (juce::OpenGLContext& gl, const juce::String& fragBody)
+juce::uint32 compileRDShader (juce::OpenGLContext& gl, const void* owner, const juce::String& fragBody)
 {
     auto vertSrc = ShaderUtils::getStandardVertexShader();
     auto fragSrc = ShaderUtils::getFragmentPreamble() + fragBody;
@@ -16,22 +18,22 @@ juce::uint32 compileRDShader (juce::OpenGLContext& gl, const juce::String& fragB
     if (vs == 0) return 0;
     auto fs = ShaderUtils::compileShaderStage (gl, juce::gl::GL_FRAGMENT_SHADER, fragSrc, errorLog);
     if (fs == 0) { gl.extensions.glDeleteShader (vs); return 0; }
-    return ShaderUtils::linkProgram (gl, vs, fs, errorLog);
+    return ShaderUtils::linkProgram (gl, owner, vs, fs, errorLog);
 }
 
-void ensureRGFBO (juce::OpenGLContext& gl, juce::uint32 fbos[2], juce::uint32 textures[2],
+void ensureRGFBO (juce::OpenGLContext& gl, const void* owner, juce::uint32 fbos[2], juce::uint32 textures[2],
                   int& fboW, int& fboH, int w, int h)
 {
     if (fbos[0] != 0 && fboW == w && fboH == h) return;
 
     if (fbos[0] != 0)
     {
-        gl.extensions.glDeleteFramebuffers (2, fbos);
-        juce::gl::glDeleteTextures (2, textures);
+        GLResourceRegistry::instance().deleteFramebuffers (gl, owner, 2, fbos);
+        GLResourceRegistry::instance().deleteTextures (owner, 2, textures);
     }
 
-    juce::gl::glGenTextures (2, textures);
-    gl.extensions.glGenFramebuffers (2, fbos);
+    GLResourceRegistry::instance().genTextures (owner, 2, textures);
+    GLResourceRegistry::instance().genFramebuffers (gl, owner, 2, fbos);
 
     for (int i = 0; i < 2; ++i)
     {
@@ -59,16 +61,16 @@ void ensureRGFBO (juce::OpenGLContext& gl, juce::uint32 fbos[2], juce::uint32 te
 void ReactionDiffusionNode::renderFrame (juce::OpenGLContext& gl)
 {
     constexpr int simW = 256, simH = 256; // Lower res for simulation speed
-    constexpr int outW = 512, outH = 512;
+    const int outW = RenderConfig::getWidth(), outH = RenderConfig::getHeight();
 
-    ensureRGFBO (gl, simFBOs_, simTextures_, fboWidth_, fboHeight_, simW, simH);
-    ShaderUtils::ensureFBO (gl, renderFBO_, renderTexture_, renderWidth_, renderHeight_, outW, outH);
-    ShaderUtils::ensureQuadVBO (gl, quadVBO_);
+    ensureRGFBO (gl, this, simFBOs_, simTextures_, fboWidth_, fboHeight_, simW, simH);
+    ShaderUtils::ensureFBO (gl, this, renderFBO_, renderTexture_, renderWidth_, renderHeight_, outW, outH);
+    ShaderUtils::ensureQuadVBO (gl, this, quadVBO_);
 
     if (! shadersCompiled_ && ! shaderError_)
     {
         // Simulation shader (Gray-Scott)
-        simProgram_ = compileRDShader (gl,
+        simProgram_ = compileRDShader (gl, this,
             "varying vec2 v_uv;\n"
             "uniform sampler2D u_state;\n"
             "uniform vec2  u_texel;\n"
@@ -103,7 +105,7 @@ void ReactionDiffusionNode::renderFrame (juce::OpenGLContext& gl)
             "}\n");
 
         // Render shader (colorize)
-        renderProgram_ = compileRDShader (gl,
+        renderProgram_ = compileRDShader (gl, this,
             "varying vec2 v_uv;\n"
             "uniform sampler2D u_state;\n"
             "\n"
@@ -124,7 +126,7 @@ void ReactionDiffusionNode::renderFrame (juce::OpenGLContext& gl)
     // Reset trigger
     if (isInputConnected (2))
     {
-        float resetVal = getConnectedVisualValue (2);
+        float resetVal = getConnectedVisualPeak (2);
         if (resetVal > 0.5f && lastReset_ <= 0.5f)
             needsSeed_ = true;
         lastReset_ = resetVal;
@@ -176,9 +178,9 @@ void ReactionDiffusionNode::renderFrame (juce::OpenGLContext& gl)
     if (shaderError_) return;
 
     // Apply presets
-    float feed = getParamAsFloat ("feed", 0.055f);
-    float kill = getParamAsFloat ("kill", 0.062f);
-    int preset = getParamAsInt ("preset", 0);
+    float feed = getParamAsFloat (Param::feed);
+    float kill = getParamAsFloat (Param::kill);
+    int preset = getParamAsInt (Param::preset);
 
     if (preset != 4) // Not custom
     {
@@ -198,9 +200,9 @@ void ReactionDiffusionNode::renderFrame (juce::OpenGLContext& gl)
     feed = juce::jlimit (0.01f, 0.1f, feed);
     kill = juce::jlimit (0.04f, 0.08f, kill);
 
-    float dA = getParamAsFloat ("diffuseA", 1.0f);
-    float dB = getParamAsFloat ("diffuseB", 0.5f);
-    int steps = getParamAsInt ("speed", 4);
+    float dA = getParamAsFloat (Param::diffuseA);
+    float dB = getParamAsFloat (Param::diffuseB);
+    int steps = getParamAsInt (Param::speed);
 
     // Simulation steps
     gl.extensions.glUseProgram (simProgram_);
@@ -32,6 +32,11 @@ public:
     void renderFrame (juce::OpenGLContext& gl) override;
 
 private:
+    struct Param
+    {
+        enum Index : int { feed, kill, diffuseA, diffuseB, speed, preset };
+    };
+
     juce::uint32 simFBOs_[2] = { 0, 0 };
     juce::uint32 simTextures_[2] = { 0, 0 };
     juce::uint32 renderFBO_ = 0, renderTexture_ = 0;
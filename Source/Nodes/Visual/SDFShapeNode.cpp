@@ -1,15 +1,16 @@
 #include "Nodes/Visual/SDFShapeNode.h"
 #include "Rendering/ShaderUtils.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
 
 void SDFShapeNode::renderFrame (juce::OpenGLContext& gl)
 {
-    constexpr int width = 512, height = 512;
+    const int width = RenderConfig::getWidth(), height = RenderConfig::getHeight();
 
-    ShaderUtils::ensureFBO (gl, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
-    ShaderUtils::ensureQuadVBO (gl, quadVBO_);
+    ShaderUtils::ensureFBO (gl, this, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
+    ShaderUtils::ensureQuadVBO (gl, this, quadVBO_);
 
     if (! shaderCompiled_ && ! shaderError_)
     {
@@ -123,7 +124,7 @@ void SDFShapeNode::renderFrame (juce::OpenGLContext& gl)
         auto fs = ShaderUtils::compileShaderStage (gl, juce::gl::GL_FRAGMENT_SHADER, fragSrc, errorLog);
         if (fs == 0) { gl.extensions.glDeleteShader (vs); shaderError_ = true; DBG ("SDFShapeNode FS error: " + errorLog); return; }
 
-        shaderProgram_ = ShaderUtils::linkProgram (gl, vs, fs, errorLog);
+        shaderProgram_ = ShaderUtils::linkProgram (gl, this, vs, fs, errorLog);
         if (shaderProgram_ == 0) { shaderError_ = true; DBG ("SDFShapeNode link error: " + errorLog); return; }
 
         shaderCompiled_ = true;
@@ -145,26 +146,26 @@ void SDFShapeNode::renderFrame (juce::OpenGLContext& gl)
             return gl.extensions.glGetUniformLocation (shaderProgram_, name);
         };
 
-        float radius = getParamAsFloat ("radius", 0.35f);
-        float rotation = juce::degreesToRadians (getParamAsFloat ("rotation", 0.0f));
-        float edgeSoftness = getParamAsFloat ("edgeSoftness", 0.01f);
-        float repeatX = static_cast<float> (getParamAsInt ("repeatX", 1));
-        float repeatY = static_cast<float> (getParamAsInt ("repeatY", 1));
+        float radius = getParamAsFloat (Param::radius);
+        float rotation = juce::degreesToRadians (getParamAsFloat (Param::rotation));
+        float edgeSoftness = getParamAsFloat (Param::edgeSoftness);
+        float repeatX = static_cast<float> (getParamAsInt (Param::repeatX));
+        float repeatY = static_cast<float> (getParamAsInt (Param::repeatY));
 
         if (isInputConnected (0)) radius *= juce::jlimit (0.1f, 4.0f, getConnectedVisualValue (0) * 2.0f);
         if (isInputConnected (1)) rotation += getConnectedVisualValue (1) * 6.283f;
         if (isInputConnected (2)) edgeSoftness *= juce::jlimit (0.1f, 4.0f, getConnectedVisualValue (2) * 2.0f);
         if (isInputConnected (3)) { float rep = juce::jlimit (1.0f, 8.0f, getConnectedVisualValue (3) * 8.0f); repeatX = rep; repeatY = rep; }
 
-        if (auto l = loc ("u_shape");          l >= 0) gl.extensions.glUniform1i (l, getParamAsInt ("shape", 0));
+        if (auto l = loc ("u_shape");          l >= 0) gl.extensions.glUniform1i (l, getParamAsInt (Param::shape));
         if (auto l = loc ("u_radius");         l >= 0) gl.extensions.glUniform1f (l, radius);
         if (auto l = loc ("u_edgeSoftness");   l >= 0) gl.extensions.glUniform1f (l, edgeSoftness);
         if (auto l = loc ("u_rotation");       l >= 0) gl.extensions.glUniform1f (l, rotation);
         if (auto l = loc ("u_repeatX");        l >= 0) gl.extensions.glUniform1f (l, repeatX);
         if (auto l = loc ("u_repeatY");        l >= 0) gl.extensions.glUniform1f (l, repeatY);
-        if (auto l = loc ("u_ringThickness");  l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat ("ringThickness", 0.05f));
-        if (auto l = loc ("u_starPoints");     l >= 0) gl.extensions.glUniform1i (l, getParamAsInt ("starPoints", 5));
-        if (auto l = loc ("u_fillColor");      l >= 0) gl.extensions.glUniform1i (l, getParamAsInt ("fillColor", 0));
+        if (auto l = loc ("u_ringThickness");  l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat (Param::ringThickness));
+        if (auto l = loc ("u_starPoints");     l >= 0) gl.extensions.glUniform1i (l, getParamAsInt (Param::starPoints));
+        if (auto l = loc ("u_fillColor");      l >= 0) gl.extensions.glUniform1i (l, getParamAsInt (Param::fillColor));
 
         ShaderUtils::drawFullscreenQuad (gl, shaderProgram_, quadVBO_);
         gl.extensions.glUseProgram (0);
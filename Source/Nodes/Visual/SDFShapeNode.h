@@ -32,10 +32,20 @@ public:
     juce::String getDisplayName() const override { return "SDF Shape"; }
     juce::String getCategory()    const override { return "Visual"; }
     bool isVisualNode()           const override { return true; }
+    bool isTimeDependent()        const override { return false; }
 
     void renderFrame (juce::OpenGLContext& gl) override;
 
 private:
+    struct Param
+    {
+        enum Index : int
+        {
+            shape, radius, edgeSoftness, rotation, repeatX, repeatY, ringThickness, starPoints,
+            fillColor
+        };
+    };
+
     juce::uint32 fbo_ = 0;
     juce::uint32 fboTexture_ = 0;
     int fboWidth_ = 0, fboHeight_ = 0;
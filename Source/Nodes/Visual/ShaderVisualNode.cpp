@@ -1,5 +1,7 @@
 #include "Nodes/Visual/ShaderVisualNode.h"
 #include <cmath>
+#include "Rendering/GLResourceRegistry.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
@@ -74,11 +76,11 @@ void ShaderVisualNode::ensureFBO (juce::OpenGLContext& gl, int width, int height
 
     if (fbo_ != 0)
     {
-        gl.extensions.glDeleteFramebuffers (1, &fbo_);
-        juce::gl::glDeleteTextures (1, &fboTexture_);
+        GLResourceRegistry::instance().deleteFramebuffers (gl, this, 1, &fbo_);
+        GLResourceRegistry::instance().deleteTextures (this, 1, &fboTexture_);
     }
 
-    juce::gl::glGenTextures (1, &fboTexture_);
+    GLResourceRegistry::instance().genTextures (this, 1, &fboTexture_);
     juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D, fboTexture_);
     juce::gl::glTexImage2D (juce::gl::GL_TEXTURE_2D, 0, juce::gl::GL_RGBA8,
                             width, height, 0,
@@ -86,7 +88,7 @@ void ShaderVisualNode::ensureFBO (juce::OpenGLContext& gl, int width, int height
     juce::gl::glTexParameteri (juce::gl::GL_TEXTURE_2D, juce::gl::GL_TEXTURE_MIN_FILTER, juce::gl::GL_LINEAR);
     juce::gl::glTexParameteri (juce::gl::GL_TEXTURE_2D, juce::gl::GL_TEXTURE_MAG_FILTER, juce::gl::GL_LINEAR);
 
-    gl.extensions.glGenFramebuffers (1, &fbo_);
+    GLResourceRegistry::instance().genFramebuffers (gl, this, 1, &fbo_);
     gl.extensions.glBindFramebuffer (juce::gl::GL_FRAMEBUFFER, fbo_);
     gl.extensions.glFramebufferTexture2D (juce::gl::GL_FRAMEBUFFER, juce::gl::GL_COLOR_ATTACHMENT0,
                                           juce::gl::GL_TEXTURE_2D, fboTexture_, 0);
@@ -98,7 +100,7 @@ void ShaderVisualNode::ensureFBO (juce::OpenGLContext& gl, int width, int height
 
 void ShaderVisualNode::compileShader (juce::OpenGLContext& gl)
 {
-    auto requestedFragSource = getParam ("fragmentShader").toString();
+    auto requestedFragSource = getParamAsString (Param::fragmentShader);
     if (requestedFragSource.isEmpty())
         requestedFragSource = getDefaultFragmentShader();
 
@@ -111,7 +113,7 @@ void ShaderVisualNode::compileShader (juce::OpenGLContext& gl)
     // Clean up old shader
     if (shaderProgram_ != 0)
     {
-        gl.extensions.glDeleteProgram (shaderProgram_);
+        GLResourceRegistry::instance().deleteProgram (gl, this, shaderProgram_);
         shaderProgram_ = 0;
     }
 
@@ -163,7 +165,7 @@ void ShaderVisualNode::compileShader (juce::OpenGLContext& gl)
     }
 
     // Link program
-    shaderProgram_ = gl.extensions.glCreateProgram();
+    shaderProgram_ = GLResourceRegistry::instance().createProgram (gl, this);
     gl.extensions.glAttachShader (shaderProgram_, vs);
     gl.extensions.glAttachShader (shaderProgram_, fs);
     gl.extensions.glLinkProgram (shaderProgram_);
@@ -177,7 +179,7 @@ void ShaderVisualNode::compileShader (juce::OpenGLContext& gl)
     if (! linked)
     {
         auto linkLog = getProgramInfoLog (gl, shaderProgram_);
-        gl.extensions.glDeleteProgram (shaderProgram_);
+        GLResourceRegistry::instance().deleteProgram (gl, this, shaderProgram_);
         shaderProgram_ = 0;
         shaderError_ = true;
         DBG ("ShaderVisual shader link error:\n" + linkLog);
@@ -195,7 +197,7 @@ void ShaderVisualNode::compileShader (juce::OpenGLContext& gl)
             -1.f,  1.f,
              1.f,  1.f
         };
-        gl.extensions.glGenBuffers (1, &quadVBO_);
+        GLResourceRegistry::instance().genBuffers (gl, this, 1, &quadVBO_);
         gl.extensions.glBindBuffer (juce::gl::GL_ARRAY_BUFFER, quadVBO_);
         gl.extensions.glBufferData (juce::gl::GL_ARRAY_BUFFER, sizeof (quadVerts), quadVerts, juce::gl::GL_STATIC_DRAW);
         gl.extensions.glBindBuffer (juce::gl::GL_ARRAY_BUFFER, 0);
@@ -206,7 +208,7 @@ void ShaderVisualNode::updateSpectrumTexture (juce::OpenGLContext& /*gl*/)
 {
     if (spectrumTexture_ == 0)
     {
-        juce::gl::glGenTextures (1, &spectrumTexture_);
+        GLResourceRegistry::instance().genTextures (this, 1, &spectrumTexture_);
         juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D, spectrumTexture_);
         juce::gl::glTexParameteri (juce::gl::GL_TEXTURE_2D, juce::gl::GL_TEXTURE_MIN_FILTER, juce::gl::GL_LINEAR);
         juce::gl::glTexParameteri (juce::gl::GL_TEXTURE_2D, juce::gl::GL_TEXTURE_MAG_FILTER, juce::gl::GL_LINEAR);
@@ -214,9 +216,10 @@ void ShaderVisualNode::updateSpectrumTexture (juce::OpenGLContext& /*gl*/)
         juce::gl::glTexParameteri (juce::gl::GL_TEXTURE_2D, juce::gl::GL_TEXTURE_WRAP_T, juce::gl::GL_CLAMP_TO_EDGE);
     }
 
-    if (! magnitudeSnapshot_.empty())
+    const auto magnitudes = getConnectedChannelData (4);
+    if (! magnitudes.empty())
     {
-        int numBins = static_cast<int> (magnitudeSnapshot_.size());
+        int numBins = static_cast<int> (magnitudes.size());
         if (static_cast<int> (processedSpectrum_.size()) != numBins)
             processedSpectrum_.assign (static_cast<size_t> (numBins), 0.0f);
 
@@ -231,7 +234,7 @@ void ShaderVisualNode::updateSpectrumTexture (juce::OpenGLContext& /*gl*/)
 
         for (int i = 0; i < numBins; ++i)
         {
-            const auto target = remapMagnitudeForVisuals (magnitudeSnapshot_[i]);
+            const auto target = remapMagnitudeForVisuals (magnitudes[i]);
             const auto previous = processedSpectrum_[i];
 
             float smoothed = previous;
@@ -305,7 +308,7 @@ void ShaderVisualNode::updateSpectrumTexture (juce::OpenGLContext& /*gl*/)
 
 void ShaderVisualNode::renderFrame (juce::OpenGLContext& gl)
 {
-    int width = 512, height = 512;
+    const int width = RenderConfig::getWidth(), height = RenderConfig::getHeight();
     ensureFBO (gl, width, height);
     compileShader (gl);
     updateSpectrumTexture (gl);
@@ -323,7 +326,7 @@ void ShaderVisualNode::renderFrame (juce::OpenGLContext& gl)
     {
         gl.extensions.glUseProgram (shaderProgram_);
 
-        time_ += 1.0f / 60.0f;
+        time_ += frameSeconds_;
 
         // Set uniforms
         auto loc = [&] (const char* name) {
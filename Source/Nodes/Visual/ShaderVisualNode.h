@@ -25,18 +25,10 @@ public:
     juce::String getDisplayName() const override { return "Shader Visual"; }
     juce::String getCategory()    const override { return "Visual"; }
     bool isVisualNode()           const override { return true; }
+    bool readsAnalysis()          const override { return true; }
 
     void renderFrame (juce::OpenGLContext& gl) override;
 
-    void updateMagnitudes (const float* data, int numBins)
-    {
-        if (data && numBins > 0)
-        {
-            magnitudeSnapshot_.resize (static_cast<size_t> (numBins));
-            std::memcpy (magnitudeSnapshot_.data(), data, sizeof (float) * numBins);
-        }
-    }
-
     static juce::String getDefaultFragmentShader()
     {
         return
@@ -135,11 +127,15 @@ public:
     }
 
 private:
+    struct Param
+    {
+        enum Index : int { fragmentShader };
+    };
+
     void ensureFBO (juce::OpenGLContext& gl, int width, int height);
     void compileShader (juce::OpenGLContext& gl);
     void updateSpectrumTexture (juce::OpenGLContext& gl);
 
-    std::vector<float> magnitudeSnapshot_;
 
     juce::uint32 fbo_ = 0;
     juce::uint32 fboTexture_ = 0;
@@ -1,6 +1,8 @@
 #include "Nodes/Visual/SpectrumRendererNode.h"
 #include <juce_opengl/juce_opengl.h>
 #include <cmath>
+#include "Rendering/GLResourceRegistry.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
@@ -25,7 +27,7 @@ int mapBarToBin (int barIndex, int numBars, int numBins, int scaleMode)
     return juce::jlimit (0, numBins - 1, static_cast<int> (t * static_cast<float> (numBins - 1)));
 }
 
-float averageMagnitudeWindow (const std::vector<float>& bins, int centreBin, int radius)
+float averageMagnitudeWindow (std::span<const float> bins, int centreBin, int radius)
 {
     const auto numBins = static_cast<int> (bins.size());
     const auto start = juce::jlimit (0, numBins - 1, centreBin - radius);
@@ -46,11 +48,11 @@ void SpectrumRendererNode::ensureFBO (juce::OpenGLContext& gl, int width, int he
 
     if (fbo_ != 0)
     {
-        gl.extensions.glDeleteFramebuffers (1, &fbo_);
-        juce::gl::glDeleteTextures (1, &fboTexture_);
+        GLResourceRegistry::instance().deleteFramebuffers (gl, this, 1, &fbo_);
+        GLResourceRegistry::instance().deleteTextures (this, 1, &fboTexture_);
     }
 
-    juce::gl::glGenTextures (1, &fboTexture_);
+    GLResourceRegistry::instance().genTextures (this, 1, &fboTexture_);
     juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D, fboTexture_);
     juce::gl::glTexImage2D (juce::gl::GL_TEXTURE_2D, 0, juce::gl::GL_RGBA8,
                             width, height, 0,
@@ -58,7 +60,7 @@ void SpectrumRendererNode::ensureFBO (juce::OpenGLContext& gl, int width, int he
     juce::gl::glTexParameteri (juce::gl::GL_TEXTURE_2D, juce::gl::GL_TEXTURE_MIN_FILTER, juce::gl::GL_LINEAR);
     juce::gl::glTexParameteri (juce::gl::GL_TEXTURE_2D, juce::gl::GL_TEXTURE_MAG_FILTER, juce::gl::GL_LINEAR);
 
-    gl.extensions.glGenFramebuffers (1, &fbo_);
+    GLResourceRegistry::instance().genFramebuffers (gl, this, 1, &fbo_);
     gl.extensions.glBindFramebuffer (juce::gl::GL_FRAMEBUFFER, fbo_);
     gl.extensions.glFramebufferTexture2D (juce::gl::GL_FRAMEBUFFER, juce::gl::GL_COLOR_ATTACHMENT0,
                                           juce::gl::GL_TEXTURE_2D, fboTexture_, 0);
@@ -70,7 +72,7 @@ void SpectrumRendererNode::ensureFBO (juce::OpenGLContext& gl, int width, int he
 
 void SpectrumRendererNode::renderFrame (juce::OpenGLContext& gl)
 {
-    int width = 512, height = 256;
+    const int width = RenderConfig::getWidth(), height = RenderConfig::getHeight() / 2;
     ensureFBO (gl, width, height);
 
     gl.extensions.glBindFramebuffer (juce::gl::GL_FRAMEBUFFER, fbo_);
@@ -93,13 +95,15 @@ void SpectrumRendererNode::renderFrame (juce::OpenGLContext& gl)
     const auto baseG = juce::jlimit (0.0f, 1.2f, isInputConnected (2) ? getConnectedVisualValue (2) : 0.9f);
     const auto baseB = juce::jlimit (0.0f, 1.2f, isInputConnected (3) ? getConnectedVisualValue (3) : 0.4f);
 
-    if (! magnitudeSnapshot_.empty() && magnitudeSnapshot_.size() > 4)
+    // The latest spectrum, through its channel
+    const auto magnitudes = getConnectedChannelData (0);
+    if (magnitudes.size() > 4)
     {
-        int numBins = static_cast<int> (magnitudeSnapshot_.size());
+        int numBins = static_cast<int> (magnitudes.size());
         const int numBars = juce::jlimit (8, 160, juce::jmin (numBins, 96));
-        const int scaleMode = getParamAsInt ("scale", 0);
-        const int style = getParamAsInt ("barStyle", 0);
-        const float dbRange = getParamAsFloat ("dbRange", -60.0f);
+        const int scaleMode = getParamAsInt (Param::scale);
+        const int style = getParamAsInt (Param::barStyle);
+        const float dbRange = getParamAsFloat (Param::dbRange);
 
         if (static_cast<int> (smoothedBars_.size()) != numBars)
         {
@@ -114,7 +118,7 @@ void SpectrumRendererNode::renderFrame (juce::OpenGLContext& gl)
         for (int i = 0; i < numBars; ++i)
         {
             const auto bin = mapBarToBin (i, numBars, numBins, scaleMode);
-            const auto mag = averageMagnitudeWindow (magnitudeSnapshot_, bin, neighbourhood);
+            const auto mag = averageMagnitudeWindow (magnitudes, bin, neighbourhood);
             const auto target = magnitudeToDisplay (mag, dbRange);
 
             const auto previous = smoothedBars_[static_cast<size_t> (i)];
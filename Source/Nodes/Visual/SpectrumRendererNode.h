@@ -25,23 +25,18 @@ public:
     juce::String getDisplayName() const override { return "Spectrum Renderer"; }
     juce::String getCategory()    const override { return "Visual"; }
     bool isVisualNode()           const override { return true; }
+    bool readsAnalysis()          const override { return true; }
 
     void renderFrame (juce::OpenGLContext& gl) override;
 
-    // Called from GUI thread with latest magnitudes from analysis snapshot
-    void updateMagnitudes (const float* data, int numBins)
+private:
+    struct Param
     {
-        if (data && numBins > 0)
-        {
-            magnitudeSnapshot_.resize (static_cast<size_t> (numBins));
-            std::memcpy (magnitudeSnapshot_.data(), data, sizeof (float) * numBins);
-        }
-    }
+        enum Index : int { scale, barStyle, dbRange };
+    };
 
-private:
     void ensureFBO (juce::OpenGLContext& gl, int width, int height);
 
-    std::vector<float> magnitudeSnapshot_;
     std::vector<float> smoothedBars_;
     std::vector<float> peakBars_;
     juce::uint32 fbo_ = 0;
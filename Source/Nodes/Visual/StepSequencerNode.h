@@ -37,14 +37,14 @@ public:
 
     void renderFrame (juce::OpenGLContext& /*gl*/) override
     {
-        int numSteps = getParamAsInt ("steps", 8);
-        int mode = getParamAsInt ("mode", 0);
+        int numSteps = getParamAsInt (Param::steps);
+        int mode = getParamAsInt (Param::mode);
         numSteps = juce::jlimit (2, 16, numSteps);
 
         // Reset on rising edge
         if (isInputConnected (1))
         {
-            float resetVal = getConnectedVisualValue (1);
+            float resetVal = getConnectedVisualPeak (1);
             if (resetVal > 0.5f && lastReset_ <= 0.5f)
             {
                 currentStep_ = 0;
@@ -57,7 +57,7 @@ public:
         bool advance = false;
         if (isInputConnected (0))
         {
-            float clockVal = getConnectedVisualValue (0);
+            float clockVal = getConnectedVisualPeak (0);
             if (clockVal > 0.5f && lastClock_ <= 0.5f)
                 advance = true;
             lastClock_ = clockVal;
@@ -65,8 +65,8 @@ public:
         else
         {
             // Internal clock
-            float speed = getParamAsFloat ("speed", 2.0f);
-            internalPhase_ += speed / 60.0f;
+            float speed = getParamAsFloat (Param::speed);
+            internalPhase_ += speed * frameSeconds_;
             if (internalPhase_ >= 1.0f)
             {
                 internalPhase_ -= std::floor (internalPhase_);
@@ -100,11 +100,10 @@ public:
             gateDecay_ *= 0.85f;
         }
 
-        // Get step value
-        static const char* stepNames[] = { "step1","step2","step3","step4","step5","step6","step7","step8" };
+        // Get step value (step1..step8 occupy consecutive param slots)
         float value = 0.5f;
         if (currentStep_ < 8)
-            value = getParamAsFloat (stepNames[currentStep_], 0.5f);
+            value = getParamAsFloat (Param::step1 + currentStep_);
 
         setVisualOutputValue (0, value);
         setVisualOutputValue (1, gateDecay_);
@@ -112,6 +111,14 @@ public:
     }
 
 private:
+    struct Param
+    {
+        enum Index : int
+        {
+            steps, step1, step2, step3, step4, step5, step6, step7, step8, mode, speed
+        };
+    };
+
     int currentStep_ = 0;
     int direction_ = 1;
     float lastClock_ = 0.0f;
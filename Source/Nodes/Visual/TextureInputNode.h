@@ -1,6 +1,7 @@
 #pragma once
 #include "Nodes/NodeBase.h"
 #include <juce_opengl/juce_opengl.h>
+#include "Rendering/GLResourceRegistry.h"
 
 namespace pf
 {
@@ -19,10 +20,11 @@ public:
     juce::String getDisplayName() const override { return "Texture Input"; }
     juce::String getCategory()    const override { return "Visual"; }
     bool isVisualNode()           const override { return true; }
+    bool isTimeDependent()        const override { return false; }
 
     void renderFrame (juce::OpenGLContext& gl) override
     {
-        auto filePath = getParam ("filePath").toString();
+        auto filePath = getParamAsString (Param::filePath);
 
         if (filePath != loadedPath_)
         {
@@ -43,7 +45,7 @@ public:
                     int h = image.getHeight();
 
                     if (texture_ == 0)
-                        juce::gl::glGenTextures (1, &texture_);
+                        GLResourceRegistry::instance().genTextures (this, 1, &texture_);
 
                     juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D, texture_);
 
@@ -66,6 +68,11 @@ public:
     }
 
 private:
+    struct Param
+    {
+        enum Index : int { filePath };
+    };
+
     juce::uint32 texture_ = 0;
     juce::String loadedPath_;
     bool needsReload_ = false;
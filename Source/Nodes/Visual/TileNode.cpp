@@ -1,16 +1,17 @@
 #include "Nodes/Visual/TileNode.h"
 #include "Rendering/ShaderUtils.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
 
 void TileNode::renderFrame (juce::OpenGLContext& gl)
 {
-    constexpr int width = 512, height = 512;
+    const int width = RenderConfig::getWidth(), height = RenderConfig::getHeight();
 
-    ShaderUtils::ensureFBO (gl, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
-    ShaderUtils::ensureQuadVBO (gl, quadVBO_);
-    ShaderUtils::ensureFallbackTexture (fallbackTexture_);
+    ShaderUtils::ensureFBO (gl, this, fbo_, fboTexture_, fboWidth_, fboHeight_, width, height);
+    ShaderUtils::ensureQuadVBO (gl, this, quadVBO_);
+    ShaderUtils::ensureFallbackTexture (this, fallbackTexture_);
 
     if (! shaderCompiled_ && ! shaderError_)
     {
@@ -55,7 +56,7 @@ void TileNode::renderFrame (juce::OpenGLContext& gl)
         auto fs = ShaderUtils::compileShaderStage (gl, juce::gl::GL_FRAGMENT_SHADER, fragSrc, errorLog);
         if (fs == 0) { gl.extensions.glDeleteShader (vs); shaderError_ = true; return; }
 
-        shaderProgram_ = ShaderUtils::linkProgram (gl, vs, fs, errorLog);
+        shaderProgram_ = ShaderUtils::linkProgram (gl, this, vs, fs, errorLog);
         if (shaderProgram_ == 0) { shaderError_ = true; return; }
 
         shaderCompiled_ = true;
@@ -77,16 +78,16 @@ void TileNode::renderFrame (juce::OpenGLContext& gl)
             return gl.extensions.glGetUniformLocation (shaderProgram_, name);
         };
 
-        float countX = static_cast<float> (getParamAsInt ("countX", 2));
-        float countY = static_cast<float> (getParamAsInt ("countY", 2));
+        float countX = static_cast<float> (getParamAsInt (Param::countX));
+        float countY = static_cast<float> (getParamAsInt (Param::countY));
         if (isInputConnected (1)) { float c = juce::jlimit (1.0f, 16.0f, getConnectedVisualValue (1) * 16.0f); countX = c; countY = c; }
 
         if (auto l = loc ("u_countX");    l >= 0) gl.extensions.glUniform1f (l, countX);
         if (auto l = loc ("u_countY");    l >= 0) gl.extensions.glUniform1f (l, countY);
-        if (auto l = loc ("u_offsetX");   l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat ("offsetX", 0.0f));
-        if (auto l = loc ("u_offsetY");   l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat ("offsetY", 0.0f));
-        if (auto l = loc ("u_rotation");  l >= 0) gl.extensions.glUniform1f (l, juce::degreesToRadians (getParamAsFloat ("rotation", 0.0f)));
-        if (auto l = loc ("u_mirror");    l >= 0) gl.extensions.glUniform1i (l, getParamAsInt ("mirror", 0));
+        if (auto l = loc ("u_offsetX");   l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat (Param::offsetX));
+        if (auto l = loc ("u_offsetY");   l >= 0) gl.extensions.glUniform1f (l, getParamAsFloat (Param::offsetY));
+        if (auto l = loc ("u_rotation");  l >= 0) gl.extensions.glUniform1f (l, juce::degreesToRadians (getParamAsFloat (Param::rotation)));
+        if (auto l = loc ("u_mirror");    l >= 0) gl.extensions.glUniform1i (l, getParamAsInt (Param::mirror));
 
         juce::gl::glActiveTexture (juce::gl::GL_TEXTURE0);
         juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D,
@@ -27,7 +27,7 @@ public:
 
     void renderFrame (juce::OpenGLContext& /*gl*/) override
     {
-        float triggerVal = isInputConnected (0) ? getConnectedVisualValue (0) : 0.0f;
+        float triggerVal = isInputConnected (0) ? getConnectedVisualPeak (0) : 0.0f;
 
         // Rising edge detection
         if (triggerVal > 0.5f && lastTrigger_ <= 0.5f)
@@ -37,14 +37,14 @@ public:
         }
         lastTrigger_ = triggerVal;
 
-        float attackMs = getParamAsFloat ("attackMs", 5.0f);
-        float decayMs = getParamAsFloat ("decayMs", 200.0f);
-        int shape = getParamAsInt ("shape", 0);
+        float attackMs = getParamAsFloat (Param::attackMs);
+        float decayMs = getParamAsFloat (Param::decayMs);
+        int shape = getParamAsInt (Param::shape);
 
         if (isInputConnected (1))
             attackMs *= juce::jlimit (0.1f, 4.0f, getConnectedVisualValue (1) * 2.0f);
 
-        constexpr float frameDt = 1000.0f / 60.0f; // ms per frame at 60fps
+        const float frameDt = 1000.0f * frameSeconds_; // ms this frame
 
         float output = 0.0f;
 
@@ -90,6 +90,11 @@ public:
     }
 
 private:
+    struct Param
+    {
+        enum Index : int { attackMs, decayMs, shape };
+    };
+
     float lastTrigger_ = 0.0f;
     bool triggered_ = false;
     float envelopePhase_ = 0.0f; // in milliseconds
@@ -1,6 +1,8 @@
 #include "Nodes/Visual/WaveformRendererNode.h"
 #include <juce_opengl/juce_opengl.h>
 #include <cmath>
+#include "Rendering/GLResourceRegistry.h"
+#include "Rendering/RenderConfig.h"
 
 namespace pf
 {
@@ -12,11 +14,11 @@ void WaveformRendererNode::ensureFBO (juce::OpenGLContext& gl, int width, int he
 
     if (fbo_ != 0)
     {
-        gl.extensions.glDeleteFramebuffers (1, &fbo_);
-        juce::gl::glDeleteTextures (1, &fboTexture_);
+        GLResourceRegistry::instance().deleteFramebuffers (gl, this, 1, &fbo_);
+        GLResourceRegistry::instance().deleteTextures (this, 1, &fboTexture_);
     }
 
-    juce::gl::glGenTextures (1, &fboTexture_);
+    GLResourceRegistry::instance().genTextures (this, 1, &fboTexture_);
     juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D, fboTexture_);
     juce::gl::glTexImage2D (juce::gl::GL_TEXTURE_2D, 0, juce::gl::GL_RGBA8,
                             width, height, 0,
@@ -24,7 +26,7 @@ void WaveformRendererNode::ensureFBO (juce::OpenGLContext& gl, int width, int he
     juce::gl::glTexParameteri (juce::gl::GL_TEXTURE_2D, juce::gl::GL_TEXTURE_MIN_FILTER, juce::gl::GL_LINEAR);
     juce::gl::glTexParameteri (juce::gl::GL_TEXTURE_2D, juce::gl::GL_TEXTURE_MAG_FILTER, juce::gl::GL_LINEAR);
 
-    gl.extensions.glGenFramebuffers (1, &fbo_);
+    GLResourceRegistry::instance().genFramebuffers (gl, this, 1, &fbo_);
     gl.extensions.glBindFramebuffer (juce::gl::GL_FRAMEBUFFER, fbo_);
     gl.extensions.glFramebufferTexture2D (juce::gl::GL_FRAMEBUFFER, juce::gl::GL_COLOR_ATTACHMENT0,
                                           juce::gl::GL_TEXTURE_2D, fboTexture_, 0);
@@ -36,7 +38,7 @@ void WaveformRendererNode::ensureFBO (juce::OpenGLContext& gl, int width, int he
 
 void WaveformRendererNode::renderFrame (juce::OpenGLContext& gl)
 {
-    int width = 512, height = 256;
+    const int width = RenderConfig::getWidth(), height = RenderConfig::getHeight() / 2;
     ensureFBO (gl, width, height);
 
     gl.extensions.glBindFramebuffer (juce::gl::GL_FRAMEBUFFER, fbo_);
@@ -59,16 +61,18 @@ void WaveformRendererNode::renderFrame (juce::OpenGLContext& gl)
     const auto g = juce::jlimit (0.0f, 1.2f, isInputConnected (2) ? getConnectedVisualValue (2) : 0.8f);
     const auto b = juce::jlimit (0.0f, 1.2f, isInputConnected (3) ? getConnectedVisualValue (3) : 1.0f);
 
-    if (! waveformSnapshot_.empty() && waveformSnapshot_.size() > 1)
+    // The latest block of the audio input, through its channel
+    const auto waveform = getConnectedChannelData (0);
+    if (waveform.size() > 1)
     {
-        const auto numSamples = static_cast<int> (waveformSnapshot_.size());
+        const auto numSamples = static_cast<int> (waveform.size());
         if (static_cast<int> (smoothedWaveform_.size()) != numSamples)
             smoothedWaveform_.assign (static_cast<size_t> (numSamples), 0.0f);
 
         float rms = 0.0f;
         for (int i = 0; i < numSamples; ++i)
         {
-            const auto target = juce::jlimit (-1.0f, 1.0f, waveformSnapshot_[static_cast<size_t> (i)]);
+            const auto target = juce::jlimit (-1.0f, 1.0f, waveform[static_cast<size_t> (i)]);
             const auto previous = smoothedWaveform_[static_cast<size_t> (i)];
             const auto smoothed = previous + (target - previous) * 0.34f;
             smoothedWaveform_[static_cast<size_t> (i)] = smoothed;
@@ -77,7 +81,7 @@ void WaveformRendererNode::renderFrame (juce::OpenGLContext& gl)
         rms = std::sqrt (rms / static_cast<float> (numSamples));
         rmsLevel_ = rmsLevel_ * 0.88f + rms * 0.12f;
 
-        auto thickness = getParamAsFloat ("lineThickness", 2.0f);
+        auto thickness = getParamAsFloat (Param::lineThickness);
         if (isInputConnected (4))
         {
             const auto thicknessMod = juce::jlimit (0.0f, 2.0f, getConnectedVisualValue (4));
@@ -86,7 +90,7 @@ void WaveformRendererNode::renderFrame (juce::OpenGLContext& gl)
         thickness *= 1.0f + juce::jlimit (0.0f, 1.2f, rmsLevel_ * 2.2f) * 0.35f;
         thickness = juce::jlimit (1.0f, 6.5f, thickness);
 
-        const auto style = getParamAsInt ("style", 0);
+        const auto style = getParamAsInt (Param::style);
         const auto glow = juce::jlimit (0.0f, 1.0f, rmsLevel_ * 4.0f);
 
         juce::gl::glEnable (juce::gl::GL_BLEND);
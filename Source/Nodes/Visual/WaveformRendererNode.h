@@ -24,29 +24,18 @@ public:
     juce::String getDisplayName() const override { return "Waveform Renderer"; }
     juce::String getCategory()    const override { return "Visual"; }
     bool isVisualNode()           const override { return true; }
-
-    void prepareToPlay (double sampleRate, int blockSize) override
-    {
-        NodeBase::prepareToPlay (sampleRate, blockSize);
-        waveformSnapshot_.resize (static_cast<size_t> (blockSize), 0.f);
-    }
+    bool readsAnalysis()          const override { return true; }
 
     void renderFrame (juce::OpenGLContext& gl) override;
 
-    // Called from GUI thread to snapshot latest audio block
-    void updateWaveformSnapshot (const float* data, int numSamples)
+private:
+    struct Param
     {
-        if (data && numSamples > 0)
-        {
-            waveformSnapshot_.resize (static_cast<size_t> (numSamples));
-            std::memcpy (waveformSnapshot_.data(), data, sizeof (float) * numSamples);
-        }
-    }
+        enum Index : int { lineThickness, style };
+    };
 
-private:
     void ensureFBO (juce::OpenGLContext& gl, int width, int height);
 
-    std::vector<float> waveformSnapshot_;
     std::vector<float> smoothedWaveform_;
     float rmsLevel_ = 0.0f;
     juce::uint32 fbo_ = 0;
@@ -0,0 +1,93 @@
+#include "Render/OffscreenGLContext.h"
+
+// Keep Xlib (and its None/Bool/Status macros) out; no native window is ever used
+#define EGL_NO_X11 1
+#define MESA_EGL_NO_X11_HEADERS 1
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstring>
+
+namespace pf
+{
+
+OffscreenGLContext::~OffscreenGLContext()
+{
+    if (display_ == nullptr)
+        return;
+
+    eglMakeCurrent (display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+    if (context_ != nullptr)
+        eglDestroyContext (display_, context_);
+    if (surface_ != nullptr)
+        eglDestroySurface (display_, surface_);
+
+    eglTerminate (display_);
+}
+
+juce::String OffscreenGLContext::create()
+{
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC> (
+        eglGetProcAddress ("eglGetPlatformDisplayEXT"));
+
+    EGLDisplay display = EGL_NO_DISPLAY;
+    if (getPlatformDisplay != nullptr)
+        display = getPlatformDisplay (EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (display == EGL_NO_DISPLAY)
+        display = eglGetDisplay (EGL_DEFAULT_DISPLAY);
+
+    if (display == EGL_NO_DISPLAY || ! eglInitialize (display, nullptr, nullptr))
+        return "no EGL display available";
+
+    display_ = display;
+
+    // Desktop GL with the default (compatibility) profile, like the app's canvas
+    if (! eglBindAPI (EGL_OPENGL_API))
+        return "EGL implementation has no desktop OpenGL";
+
+    const EGLint configAttributes[] =
+    {
+        EGL_SURFACE_TYPE,    EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE,   8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE,  8,
+        EGL_ALPHA_SIZE, 8,
+        EGL_NONE
+    };
+
+    EGLConfig config = nullptr;
+    EGLint numConfigs = 0;
+    if (! eglChooseConfig (display, configAttributes, &config, 1, &numConfigs) || numConfigs == 0)
+        return "no RGBA8 OpenGL config";
+
+    context_ = eglCreateContext (display, config, EGL_NO_CONTEXT, nullptr);
+    if (context_ == EGL_NO_CONTEXT)
+        return "eglCreateContext failed (0x" + juce::String::toHexString (eglGetError()) + ")";
+
+    // Without EGL_KHR_surfaceless_context, a 1x1 pbuffer stands in for the window
+    const auto* extensions = eglQueryString (display, EGL_EXTENSIONS);
+    if (extensions == nullptr || std::strstr (extensions, "EGL_KHR_surfaceless_context") == nullptr)
+    {
+        const EGLint pbufferAttributes[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+        surface_ = eglCreatePbufferSurface (display, config, pbufferAttributes);
+        if (surface_ == EGL_NO_SURFACE)
+            return "eglCreatePbufferSurface failed (0x" + juce::String::toHexString (eglGetError()) + ")";
+    }
+
+    auto surface = surface_ != nullptr ? surface_ : EGL_NO_SURFACE;
+    if (! eglMakeCurrent (display, surface, surface, context_))
+        return "eglMakeCurrent failed (0x" + juce::String::toHexString (eglGetError()) + ")";
+
+    juce::gl::loadFunctions();
+    juce::gl::loadExtensions();
+    return {};
+}
+
+juce::String OffscreenGLContext::getRendererName()
+{
+    auto* renderer = juce::gl::glGetString (juce::gl::GL_RENDERER);
+    return renderer != nullptr ? juce::String (reinterpret_cast<const char*> (renderer)) : juce::String ("unknown");
+}
+
+} // namespace pf
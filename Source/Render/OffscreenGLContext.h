@@ -0,0 +1,42 @@
+#pragma once
+#include <juce_opengl/juce_opengl.h>
+
+namespace pf
+{
+
+/**
+ * An OpenGL context without a window, for rendering on machines with no display.
+ *
+ * Created through EGL, on Mesa's surfaceless platform when it's available (no X
+ * server or GPU needed: llvmpipe renders on the CPU), otherwise on the default
+ * display. The context is made current on the creating thread and has no default
+ * framebuffer worth drawing to; visual nodes render into their own FBOs anyway.
+ *
+ * Visual nodes take a juce::OpenGLContext only to reach gl.extensions, so an
+ * unattached one can be passed to them while this context is current.
+ *
+ * Linux only.
+ */
+class OffscreenGLContext
+{
+public:
+    OffscreenGLContext() = default;
+    ~OffscreenGLContext();
+
+    /** Creates the context, makes it current and loads the GL entry points.
+        Returns an error message, or an empty string on success. */
+    juce::String create();
+
+    /** GL_RENDERER of the current context, e.g. "llvmpipe (LLVM 15.0.7, 256 bits)". */
+    static juce::String getRendererName();
+
+private:
+    // EGLDisplay, EGLSurface and EGLContext, kept opaque to keep EGL out of this header
+    void* display_ = nullptr;
+    void* surface_ = nullptr;
+    void* context_ = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE (OffscreenGLContext)
+};
+
+} // namespace pf
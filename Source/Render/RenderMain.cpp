@@ -0,0 +1,283 @@
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_gui_basics/juce_gui_basics.h>
+#include "Graph/GraphModel.h"
+#include "Graph/GraphCompiler.h"
+#include "Rendering/GLResourceRegistry.h"
+#include "Rendering/RenderConfig.h"
+#include "Nodes/Visual/OutputCanvasNode.h"
+#include "Render/OffscreenGLContext.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+/**
+ * Renders a patch offline: audio from a WAV file, frames to PNG files.
+ *
+ *   PatchFlowRender <patch.json> <audio.wav> [--out=<dir>] [--fps=60] [--block=512]
+ *                   [--size=1280x720] [--frames=<n>]
+ *
+ * The audio is streamed through the compiled graph in fixed blocks, and after each
+ * frame's worth of blocks the visual nodes render one frame, all on this thread and
+ * as fast as the machine allows: no window, audio device or wall clock is involved,
+ * so two runs of the same inputs give the same frames. Without --out the frames are
+ * rendered but not written, for timing. Visual nodes animate by 1/fps per frame,
+ * keeping step with the audio at any frame rate.
+ */
+namespace
+{
+
+struct Options
+{
+    juce::File patch, audio, outputDir;
+    double fps = 60.0;
+    int blockSize = 512;
+    int width = 1280, height = 720;
+    int maxFrames = 0;   // 0: until the audio ends
+};
+
+bool parseOptions (const juce::ArgumentList& args, Options& options)
+{
+    juce::StringArray positional;
+    for (auto& arg : args.arguments)
+        if (! arg.isLongOption())
+            positional.add (arg.text);
+
+    if (positional.size() != 2)
+        return false;
+
+    options.patch = juce::File::getCurrentWorkingDirectory().getChildFile (positional[0]);
+    options.audio = juce::File::getCurrentWorkingDirectory().getChildFile (positional[1]);
+
+    if (args.containsOption ("--out"))
+        options.outputDir = juce::File::getCurrentWorkingDirectory().getChildFile (args.getValueForOption ("--out"));
+    if (args.containsOption ("--fps"))
+        options.fps = args.getValueForOption ("--fps").getDoubleValue();
+    if (args.containsOption ("--block"))
+        options.blockSize = args.getValueForOption ("--block").getIntValue();
+    if (args.containsOption ("--frames"))
+        options.maxFrames = args.getValueForOption ("--frames").getIntValue();
+    if (args.containsOption ("--size"))
+    {
+        auto size = args.getValueForOption ("--size");
+        options.width = size.upToFirstOccurrenceOf ("x", false, true).getIntValue();
+        options.height = size.fromFirstOccurrenceOf ("x", false, true).getIntValue();
+    }
+
+    return options.fps > 0.0 && options.blockSize > 0 && options.width > 0 && options.height > 0;
+}
+
+/** Reads textures back into images through one reused framebuffer. */
+class FrameReader
+{
+public:
+    explicit FrameReader (juce::OpenGLContext& gl) : gl_ (gl) {}
+
+    ~FrameReader()
+    {
+        if (fbo_ != 0)
+            gl_.extensions.glDeleteFramebuffers (1, &fbo_);
+    }
+
+    juce::Image read (juce::uint32 texture)
+    {
+        using namespace juce::gl;
+
+        GLint width = 0, height = 0;
+        glBindTexture (GL_TEXTURE_2D, texture);
+        glGetTexLevelParameteriv (GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width);
+        glGetTexLevelParameteriv (GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height);
+        glBindTexture (GL_TEXTURE_2D, 0);
+
+        if (width <= 0 || height <= 0)
+            return {};
+
+        if (fbo_ == 0)
+            gl_.extensions.glGenFramebuffers (1, &fbo_);
+
+        gl_.extensions.glBindFramebuffer (GL_FRAMEBUFFER, fbo_);
+        gl_.extensions.glFramebufferTexture2D (GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+
+        // BGRA bytes are juce::PixelARGB's layout on little-endian machines
+        pixels_.resize (static_cast<size_t> (width) * static_cast<size_t> (height) * 4);
+        glPixelStorei (GL_PACK_ALIGNMENT, 4);
+        glReadPixels (0, 0, width, height, GL_BGRA, GL_UNSIGNED_BYTE, pixels_.data());
+        gl_.extensions.glBindFramebuffer (GL_FRAMEBUFFER, 0);
+
+        juce::Image image (juce::Image::ARGB, width, height, false);
+        juce::Image::BitmapData bitmap (image, juce::Image::BitmapData::writeOnly);
+        const auto rowBytes = static_cast<size_t> (width) * 4;
+
+        for (int y = 0; y < height; ++y)
+        {
+            // GL rows run bottom-up
+            auto* row = bitmap.getLinePointer (y);
+            std::memcpy (row, pixels_.data() + static_cast<size_t> (height - 1 - y) * rowBytes, rowBytes);
+
+            // The canvas is shown opaque, whatever alpha the last node left behind
+            for (size_t i = 3; i < rowBytes; i += 4)
+                row[i] = 0xff;
+        }
+
+        return image;
+    }
+
+private:
+    juce::OpenGLContext& gl_;
+    juce::uint32 fbo_ = 0;
+    std::vector<juce::uint8> pixels_;
+};
+
+bool writePng (const juce::Image& image, const juce::File& file)
+{
+    file.deleteFile();
+    juce::FileOutputStream stream (file);
+    if (! stream.openedOk())
+        return false;
+
+    juce::PNGImageFormat png;
+    return png.writeImageToStream (image, stream);
+}
+
+int render (const Options& options, juce::OpenGLContext& gl)
+{
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+    std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor (options.audio));
+    if (reader == nullptr)
+    {
+        std::fprintf (stderr, "can't read audio file %s\n", options.audio.getFullPathName().toRawUTF8());
+        return 1;
+    }
+
+    pf::GraphModel model;
+    if (! model.loadFromJSON (options.patch.loadFileAsString()))
+    {
+        std::fprintf (stderr, "can't load patch %s\n", options.patch.getFullPathName().toRawUTF8());
+        return 1;
+    }
+
+    pf::RenderConfig::setResolution (options.width, options.height);
+
+    pf::GraphCompiler compiler (model);
+    compiler.setSampleRateAndBlockSize (reader->sampleRate, options.blockSize);
+    if (! compiler.compileNow())
+    {
+        std::fprintf (stderr, "compile failed: %s\n", compiler.getErrorMessage().toRawUTF8());
+        return 1;
+    }
+
+    auto* graph = compiler.getLatestGraph();
+    if (graph == nullptr)
+        return 1;
+
+    graph->bindAudioNodes();
+    graph->bindVisualNodes();
+
+    pf::NodeBase* inputNode = nullptr;
+    for (auto* node : graph->getAudioProcessOrder())
+        if (node->getTypeId() == "AudioInput")
+            inputNode = node;
+
+    pf::OutputCanvasNode* canvasNode = nullptr;
+    for (auto* node : graph->getVisualProcessOrder())
+        if (auto* canvas = dynamic_cast<pf::OutputCanvasNode*> (node))
+            canvasNode = canvas;
+
+    const auto sampleRate = reader->sampleRate;
+    auto numFrames = static_cast<int> (std::floor (static_cast<double> (reader->lengthInSamples) * options.fps / sampleRate));
+    if (options.maxFrames > 0)
+        numFrames = juce::jmin (numFrames, options.maxFrames);
+
+    if (options.outputDir != juce::File {} && ! options.outputDir.createDirectory())
+    {
+        std::fprintf (stderr, "can't create %s\n", options.outputDir.getFullPathName().toRawUTF8());
+        return 1;
+    }
+
+    std::printf ("%s: %d frames at %dx%d, %.0f fps, %s\n", options.patch.getFileName().toRawUTF8(), numFrames,
+                 options.width, options.height, options.fps, pf::OffscreenGLContext::getRendererName().toRawUTF8());
+
+    juce::AudioBuffer<float> block (2, options.blockSize);
+    FrameReader frameReader (gl);
+    juce::int64 position = 0;
+    int numWritten = 0;
+
+    auto start = juce::Time::getHighResolutionTicks();
+
+    for (int frame = 0; frame < numFrames; ++frame)
+    {
+        const auto frameEnd = static_cast<juce::int64> (std::llround ((frame + 1) * sampleRate / options.fps));
+
+        while (position < frameEnd)
+        {
+            const auto chunk = static_cast<int> (juce::jmin (static_cast<juce::int64> (options.blockSize), frameEnd - position));
+            reader->read (&block, 0, chunk, position, true, true);
+
+            if (inputNode != nullptr)
+                for (int ch = 0; ch < 2; ++ch)
+                    if (auto* out = inputNode->getAudioOutputBuffer (ch))
+                        std::memcpy (out, block.getReadPointer (ch), sizeof (float) * static_cast<size_t> (chunk));
+
+            graph->processAudioBlock (chunk);
+            position += chunk;
+        }
+
+        // Visual nodes read the frame's last block through their channels
+        graph->processVisualFrame (gl, 1.0 / options.fps);
+
+        if (options.outputDir != juce::File {} && canvasNode != nullptr && canvasNode->getInputTexture() != 0)
+        {
+            auto file = options.outputDir.getChildFile ("frame_" + juce::String (frame).paddedLeft ('0', 6) + ".png");
+            if (! writePng (frameReader.read (canvasNode->getInputTexture()), file))
+            {
+                std::fprintf (stderr, "can't write %s\n", file.getFullPathName().toRawUTF8());
+                return 1;
+            }
+            ++numWritten;
+        }
+    }
+
+    // Let the GPU finish, so the time covers the rendering and not just its submission
+    juce::gl::glFinish();
+    auto seconds = juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start);
+
+    std::printf ("%d frames (%d written) in %.3f s: %.1f frames/s, %.2fx realtime\n", numFrames, numWritten, seconds,
+                 seconds > 0.0 ? numFrames / seconds : 0.0,
+                 seconds > 0.0 ? static_cast<double> (position) / sampleRate / seconds : 0.0);
+    return 0;
+}
+
+} // namespace
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInit;
+
+    juce::ArgumentList args (argc, argv);
+    Options options;
+    if (! parseOptions (args, options))
+    {
+        std::fprintf (stderr, "usage: %s <patch.json> <audio.wav> [--out=<dir>] [--fps=60] [--block=512]\n"
+                              "                       [--size=1280x720] [--frames=<n>]\n",
+                      args.getExecutableName().toRawUTF8());
+        return 2;
+    }
+
+    pf::OffscreenGLContext context;
+    auto error = context.create();
+    if (error.isNotEmpty())
+    {
+        std::fprintf (stderr, "no offscreen OpenGL context: %s\n", error.toRawUTF8());
+        return 1;
+    }
+
+    // Never attached: the nodes only reach the GL functions through it
+    juce::OpenGLContext gl;
+    auto result = render (options, gl);
+
+    // The graphs are gone by now; free their GPU objects while the context is current
+    pf::GLResourceRegistry::instance().processPendingReleases (gl);
+    return result;
+}
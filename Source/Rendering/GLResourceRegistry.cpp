@@ -0,0 +1,156 @@
+#include "Rendering/GLResourceRegistry.h"
+#include <algorithm>
+
+namespace pf
+{
+
+void GLResourceRegistry::genTextures (const void* owner, int count, juce::uint32* ids)
+{
+    juce::gl::glGenTextures (count, ids);
+    track (owner, Kind::Texture, count, ids);
+}
+
+void GLResourceRegistry::genFramebuffers (juce::OpenGLContext& gl, const void* owner, int count, juce::uint32* ids)
+{
+    gl.extensions.glGenFramebuffers (count, ids);
+    track (owner, Kind::Framebuffer, count, ids);
+}
+
+void GLResourceRegistry::genBuffers (juce::OpenGLContext& gl, const void* owner, int count, juce::uint32* ids)
+{
+    gl.extensions.glGenBuffers (count, ids);
+    track (owner, Kind::Buffer, count, ids);
+}
+
+juce::uint32 GLResourceRegistry::createProgram (juce::OpenGLContext& gl, const void* owner)
+{
+    juce::uint32 program = gl.extensions.glCreateProgram();
+    track (owner, Kind::Program, 1, &program);
+    return program;
+}
+
+void GLResourceRegistry::deleteTextures (const void* owner, int count, const juce::uint32* ids)
+{
+    untrack (owner, Kind::Texture, count, ids);
+    juce::gl::glDeleteTextures (count, ids);
+}
+
+void GLResourceRegistry::deleteFramebuffers (juce::OpenGLContext& gl, const void* owner, int count, const juce::uint32* ids)
+{
+    untrack (owner, Kind::Framebuffer, count, ids);
+    gl.extensions.glDeleteFramebuffers (count, ids);
+}
+
+void GLResourceRegistry::deleteBuffers (juce::OpenGLContext& gl, const void* owner, int count, const juce::uint32* ids)
+{
+    untrack (owner, Kind::Buffer, count, ids);
+    gl.extensions.glDeleteBuffers (count, ids);
+}
+
+void GLResourceRegistry::deleteProgram (juce::OpenGLContext& gl, const void* owner, juce::uint32 program)
+{
+    untrack (owner, Kind::Program, 1, &program);
+    gl.extensions.glDeleteProgram (program);
+}
+
+//==============================================================================
+void GLResourceRegistry::releaseOwner (const void* owner)
+{
+    const juce::ScopedLock sl (lock_);
+
+    auto it = owned_.find (owner);
+    if (it == owned_.end())
+        return;
+
+    pending_.insert (pending_.end(), it->second.begin(), it->second.end());
+    owned_.erase (it);
+}
+
+void GLResourceRegistry::processPendingReleases (juce::OpenGLContext& gl)
+{
+    std::vector<Resource> toDelete;
+    {
+        const juce::ScopedLock sl (lock_);
+        if (pending_.empty())
+            return;
+
+        toDelete.swap (pending_);
+    }
+
+    for (auto& resource : toDelete)
+        destroy (gl, resource);
+
+    const juce::ScopedLock sl (lock_);
+    for (auto& resource : toDelete)
+        --liveCounts_[static_cast<size_t> (resource.kind)];
+    totalReleased_ += static_cast<juce::int64> (toDelete.size());
+}
+
+GLResourceRegistry::Stats GLResourceRegistry::getStats() const
+{
+    const juce::ScopedLock sl (lock_);
+
+    Stats stats;
+    stats.live = liveCounts_;
+    stats.pendingRelease = static_cast<int> (pending_.size());
+    stats.totalReleased = totalReleased_;
+    return stats;
+}
+
+//==============================================================================
+void GLResourceRegistry::track (const void* owner, Kind kind, int count, const juce::uint32* ids)
+{
+    const juce::ScopedLock sl (lock_);
+
+    auto& resources = owned_[owner];
+    for (int i = 0; i < count; ++i)
+    {
+        if (ids[i] == 0)
+            continue;
+
+        resources.push_back ({ kind, ids[i] });
+        ++liveCounts_[static_cast<size_t> (kind)];
+    }
+}
+
+void GLResourceRegistry::untrack (const void* owner, Kind kind, int count, const juce::uint32* ids)
+{
+    const juce::ScopedLock sl (lock_);
+
+    auto it = owned_.find (owner);
+    if (it == owned_.end())
+        return;
+
+    auto& resources = it->second;
+    for (int i = 0; i < count; ++i)
+    {
+        auto found = std::find_if (resources.begin(), resources.end(),
+                                   [&] (const Resource& r) { return r.kind == kind && r.id == ids[i]; });
+        if (found != resources.end())
+        {
+            resources.erase (found);
+            --liveCounts_[static_cast<size_t> (kind)];
+        }
+    }
+}
+
+void GLResourceRegistry::destroy (juce::OpenGLContext& gl, const Resource& resource)
+{
+    switch (resource.kind)
+    {
+        case Kind::Texture:
+            juce::gl::glDeleteTextures (1, &resource.id);
+            break;
+        case Kind::Framebuffer:
+            gl.extensions.glDeleteFramebuffers (1, &resource.id);
+            break;
+        case Kind::Buffer:
+            gl.extensions.glDeleteBuffers (1, &resource.id);
+            break;
+        case Kind::Program:
+            gl.extensions.glDeleteProgram (resource.id);
+            break;
+    }
+}
+
+} // namespace pf
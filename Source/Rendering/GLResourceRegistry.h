@@ -0,0 +1,86 @@
+#pragma once
+#include <juce_opengl/juce_opengl.h>
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+namespace pf
+{
+
+/**
+ * Central bookkeeping for GPU objects created by visual nodes.
+ *
+ * Nodes allocate textures, framebuffers, buffers and programs through the registry
+ * (on the GL thread), which records each object against its owner. Nodes are
+ * destroyed on the message thread when their graph is reclaimed, where no context
+ * is current, so NodeBase's destructor only queues its owner's objects for release.
+ * VisualCanvas deletes the queued objects at the start of the next frame.
+ *
+ * The owner key is the NodeBase address.
+ */
+class GLResourceRegistry
+{
+public:
+    enum class Kind { Texture, Framebuffer, Buffer, Program };
+    static constexpr int kNumKinds = 4;
+
+    struct Stats
+    {
+        std::array<int, kNumKinds> live {};   // per Kind
+        int pendingRelease = 0;
+        juce::int64 totalReleased = 0;
+
+        int getTotalLive() const { return live[0] + live[1] + live[2] + live[3]; }
+    };
+
+    static GLResourceRegistry& instance()
+    {
+        static GLResourceRegistry reg;
+        return reg;
+    }
+
+    //==============================================================================
+    // GL thread — allocation and explicit deletion (e.g. resizing an FBO)
+    void genTextures (const void* owner, int count, juce::uint32* ids);
+    void genFramebuffers (juce::OpenGLContext& gl, const void* owner, int count, juce::uint32* ids);
+    void genBuffers (juce::OpenGLContext& gl, const void* owner, int count, juce::uint32* ids);
+    juce::uint32 createProgram (juce::OpenGLContext& gl, const void* owner);
+
+    void deleteTextures (const void* owner, int count, const juce::uint32* ids);
+    void deleteFramebuffers (juce::OpenGLContext& gl, const void* owner, int count, const juce::uint32* ids);
+    void deleteBuffers (juce::OpenGLContext& gl, const void* owner, int count, const juce::uint32* ids);
+    void deleteProgram (juce::OpenGLContext& gl, const void* owner, juce::uint32 program);
+
+    //==============================================================================
+    /** Any thread: queues every object owned by `owner` for deletion on the GL thread. */
+    void releaseOwner (const void* owner);
+
+    /** GL thread, with the context current: deletes everything queued by releaseOwner(). */
+    void processPendingReleases (juce::OpenGLContext& gl);
+
+    /** Snapshot of live/pending counts for monitoring. */
+    Stats getStats() const;
+
+private:
+    GLResourceRegistry() = default;
+
+    struct Resource
+    {
+        Kind kind;
+        juce::uint32 id;
+    };
+
+    void track (const void* owner, Kind kind, int count, const juce::uint32* ids);
+    void untrack (const void* owner, Kind kind, int count, const juce::uint32* ids);
+    static void destroy (juce::OpenGLContext& gl, const Resource& resource);
+
+    mutable juce::CriticalSection lock_;
+    std::unordered_map<const void*, std::vector<Resource>> owned_;
+    std::vector<Resource> pending_;
+    std::array<int, kNumKinds> liveCounts_ {};
+    juce::int64 totalReleased_ = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (GLResourceRegistry)
+};
+
+} // namespace pf
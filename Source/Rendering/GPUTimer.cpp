@@ -0,0 +1,144 @@
+#include "Rendering/GPUTimer.h"
+#include "Nodes/NodeBase.h"
+
+namespace pf
+{
+
+bool GPUTimer::beginFrame()
+{
+    if (! isEnabled() || ! checkSupport())
+    {
+        discardPending();
+        timing_ = false;
+        return false;
+    }
+
+    // The oldest slot's queries were issued kLatency frames ago
+    current_ = (current_ + 1) % kLatency;
+    collect (frames_[static_cast<size_t> (current_)]);
+    timing_ = true;
+    return true;
+}
+
+void GPUTimer::beginNode (NodeBase& node)
+{
+    if (! timing_)
+        return;
+
+    auto& frame = frames_[static_cast<size_t> (current_)];
+    auto index = static_cast<size_t> (frame.numIssued);
+    if (index == frame.queries.size())
+    {
+        juce::uint32 query = 0;
+        juce::gl::glGenQueries (1, &query);
+        frame.queries.push_back (query);
+        frame.nodes.push_back (nullptr);
+    }
+
+    frame.nodes[index] = &node;
+    juce::gl::glBeginQuery (juce::gl::GL_TIME_ELAPSED, frame.queries[index]);
+    queryOpen_ = true;
+}
+
+void GPUTimer::endNode()
+{
+    if (! queryOpen_)
+        return;
+
+    juce::gl::glEndQuery (juce::gl::GL_TIME_ELAPSED);
+    ++frames_[static_cast<size_t> (current_)].numIssued;
+    queryOpen_ = false;
+}
+
+void GPUTimer::discardPending()
+{
+    // Unread queries can simply be reissued; their old results are overwritten
+    for (auto& frame : frames_)
+        frame.numIssued = 0;
+}
+
+void GPUTimer::release()
+{
+    for (auto& frame : frames_)
+    {
+        if (! frame.queries.empty())
+            juce::gl::glDeleteQueries (static_cast<int> (frame.queries.size()), frame.queries.data());
+        frame = Frame {};
+    }
+
+    // The next context may be a different one
+    support_.store (Support::unknown, std::memory_order_relaxed);
+    timing_ = false;
+    queryOpen_ = false;
+}
+
+//==============================================================================
+bool GPUTimer::checkSupport()
+{
+    auto support = support_.load (std::memory_order_relaxed);
+    if (support != Support::unknown)
+        return support == Support::available;
+
+    bool supported = false;
+
+   #if ! JUCE_OPENGL_ES
+    using namespace juce::gl;
+
+    // GL_MAJOR_VERSION is unknown to 2.x contexts; they leave the values at 0
+    GLint major = 0, minor = 0;
+    glGetIntegerv (GL_MAJOR_VERSION, &major);
+    glGetIntegerv (GL_MINOR_VERSION, &minor);
+    juce::OpenGLHelpers::resetErrorState();
+
+    supported = (major > 3 || (major == 3 && minor >= 3))
+                || juce::OpenGLHelpers::isExtensionSupported ("GL_ARB_timer_query");
+
+    supported = supported && glGenQueries != nullptr && glGetQueryObjectui64v != nullptr;
+
+    // Drivers without a usable clock may expose the query with a 0-bit counter
+    if (supported)
+    {
+        GLint bits = 0;
+        glGetQueryiv (GL_TIME_ELAPSED, GL_QUERY_COUNTER_BITS, &bits);
+        supported = bits > 0 && glGetError() == GL_NO_ERROR;
+    }
+   #endif
+
+    if (! supported)
+        DBG ("GPUTimer: GL_TIME_ELAPSED queries unsupported, GPU timing disabled");
+
+    support_.store (supported ? Support::available : Support::unavailable, std::memory_order_relaxed);
+    return supported;
+}
+
+void GPUTimer::collect (Frame& frame)
+{
+    using namespace juce::gl;
+
+    GLuint64 totalNanos = 0;
+    bool complete = true;
+
+    for (size_t i = 0; i < static_cast<size_t> (frame.numIssued); ++i)
+    {
+        GLuint available = 0;
+        glGetQueryObjectuiv (frame.queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == 0)
+        {
+            complete = false;   // the GPU is more than kLatency frames behind
+            continue;
+        }
+
+        GLuint64 nanos = 0;
+        glGetQueryObjectui64v (frame.queries[i], GL_QUERY_RESULT, &nanos);
+        frame.nodes[i]->getGpuTimings().record (static_cast<float> (nanos) * 0.001f,
+                                                NodeTimings::kFrameBudgetMicros);
+        totalNanos += nanos;
+    }
+
+    if (frame.numIssued > 0 && complete)
+        frameTimings_.record (static_cast<float> (totalNanos) * 0.001f, NodeTimings::kFrameBudgetMicros);
+
+    frame.numIssued = 0;
+}
+
+} // namespace pf
@@ -0,0 +1,84 @@
+#pragma once
+#include <juce_opengl/juce_opengl.h>
+#include "Graph/NodeTimings.h"
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace pf
+{
+
+class NodeBase;
+
+/**
+ * GPU time of each visual node's renderFrame(), measured with GL_TIME_ELAPSED queries.
+ *
+ * GL calls return long before the GPU runs them, so the CPU time of renderFrame()
+ * is mostly submission cost. Here every rendered node is bracketed by a query, and
+ * a frame's queries are read back kLatency frames later, when the GPU is normally
+ * done with them. A result that still isn't available is dropped rather than waited
+ * for, so timing never stalls the pipeline.
+ *
+ * Results go into each node's getGpuTimings(), and their sum into getFrameTimings()
+ * (only for frames whose results all arrived).
+ *
+ * Off by default. Where timer queries are missing (GL ES, a context older than 3.3
+ * without GL_ARB_timer_query, or a driver reporting a 0-bit counter) it stays idle
+ * and isSupported() turns false.
+ *
+ * GL thread only, except setEnabled(), isEnabled(), isSupported() and getFrameTimings().
+ */
+class GPUTimer
+{
+public:
+    static constexpr int kLatency = 3;   // frames between issuing a query and reading it
+
+    void setEnabled (bool shouldBeEnabled) { enabled_.store (shouldBeEnabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled_.load (std::memory_order_relaxed); }
+
+    /** False once the context turned out not to support timer queries. */
+    bool isSupported() const { return support_.load (std::memory_order_relaxed) != Support::unavailable; }
+
+    const NodeTimings& getFrameTimings() const { return frameTimings_; }
+
+    //==============================================================================
+    // GL thread
+
+    /** Reads back the results issued kLatency frames ago and starts a new frame.
+        Returns false if this frame isn't timed (disabled or unsupported). */
+    bool beginFrame();
+
+    void beginNode (NodeBase& node);
+    void endNode();
+
+    /** Forgets the queries in flight. Call when switching graphs: the nodes they were
+        issued for may be gone by the time they would be read. */
+    void discardPending();
+
+    /** Deletes the query objects. Call while the context is still active. */
+    void release();
+
+private:
+    enum class Support { unknown, available, unavailable };
+
+    struct Frame
+    {
+        std::vector<juce::uint32> queries;   // grown on demand, reused every kLatency frames
+        std::vector<NodeBase*> nodes;        // the node each query timed
+        int numIssued = 0;
+    };
+
+    bool checkSupport();
+    void collect (Frame& frame);
+
+    std::array<Frame, kLatency> frames_;
+    int current_ = 0;
+    bool timing_ = false;
+    bool queryOpen_ = false;
+
+    NodeTimings frameTimings_;
+    std::atomic<bool> enabled_ { false };
+    std::atomic<Support> support_ { Support::unknown };
+};
+
+} // namespace pf
@@ -1,4 +1,5 @@
 #include "Rendering/ShaderUtils.h"
+#include "Rendering/GLResourceRegistry.h"
 
 namespace pf
 {
@@ -57,11 +58,12 @@ juce::uint32 compileShaderStage (juce::OpenGLContext& gl,
 }
 
 juce::uint32 linkProgram (juce::OpenGLContext& gl,
+                          const void* owner,
                           juce::uint32 vs,
                           juce::uint32 fs,
                           juce::String& outErrorLog)
 {
-    auto program = gl.extensions.glCreateProgram();
+    auto program = GLResourceRegistry::instance().createProgram (gl, owner);
     gl.extensions.glAttachShader (program, vs);
     gl.extensions.glAttachShader (program, fs);
     gl.extensions.glLinkProgram (program);
@@ -75,7 +77,7 @@ juce::uint32 linkProgram (juce::OpenGLContext& gl,
     if (! linked)
     {
         outErrorLog = getProgramInfoLog (gl, program);
-        gl.extensions.glDeleteProgram (program);
+        GLResourceRegistry::instance().deleteProgram (gl, owner, program);
         return 0;
     }
 
@@ -84,6 +86,7 @@ juce::uint32 linkProgram (juce::OpenGLContext& gl,
 }
 
 void ensureFBO (juce::OpenGLContext& gl,
+                const void* owner,
                 juce::uint32& fbo, juce::uint32& fboTexture,
                 int& fboWidth, int& fboHeight,
                 int width, int height)
@@ -93,11 +96,11 @@ void ensureFBO (juce::OpenGLContext& gl,
 
     if (fbo != 0)
     {
-        gl.extensions.glDeleteFramebuffers (1, &fbo);
-        juce::gl::glDeleteTextures (1, &fboTexture);
+        GLResourceRegistry::instance().deleteFramebuffers (gl, owner, 1, &fbo);
+        GLResourceRegistry::instance().deleteTextures (owner, 1, &fboTexture);
     }
 
-    juce::gl::glGenTextures (1, &fboTexture);
+    GLResourceRegistry::instance().genTextures (owner, 1, &fboTexture);
     juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D, fboTexture);
     juce::gl::glTexImage2D (juce::gl::GL_TEXTURE_2D, 0, juce::gl::GL_RGBA8,
                             width, height, 0,
@@ -107,7 +110,7 @@ void ensureFBO (juce::OpenGLContext& gl,
     juce::gl::glTexParameteri (juce::gl::GL_TEXTURE_2D, juce::gl::GL_TEXTURE_WRAP_S, juce::gl::GL_CLAMP_TO_EDGE);
     juce::gl::glTexParameteri (juce::gl::GL_TEXTURE_2D, juce::gl::GL_TEXTURE_WRAP_T, juce::gl::GL_CLAMP_TO_EDGE);
 
-    gl.extensions.glGenFramebuffers (1, &fbo);
+    GLResourceRegistry::instance().genFramebuffers (gl, owner, 1, &fbo);
     gl.extensions.glBindFramebuffer (juce::gl::GL_FRAMEBUFFER, fbo);
     gl.extensions.glFramebufferTexture2D (juce::gl::GL_FRAMEBUFFER,
                                           juce::gl::GL_COLOR_ATTACHMENT0,
@@ -120,6 +123,7 @@ void ensureFBO (juce::OpenGLContext& gl,
 }
 
 void ensurePingPongFBOs (juce::OpenGLContext& gl,
+                         const void* owner,
                          juce::uint32 fbos[2], juce::uint32 textures[2],
                          int& fboWidth, int& fboHeight,
                          int width, int height)
@@ -129,14 +133,14 @@ void ensurePingPongFBOs (juce::OpenGLContext& gl,
 
     if (fbos[0] != 0)
     {
-        gl.extensions.glDeleteFramebuffers (2, fbos);
-        juce::gl::glDeleteTextures (2, textures);
+        GLResourceRegistry::instance().deleteFramebuffers (gl, owner, 2, fbos);
+        GLResourceRegistry::instance().deleteTextures (owner, 2, textures);
         fbos[0] = fbos[1] = 0;
         textures[0] = textures[1] = 0;
     }
 
-    juce::gl::glGenTextures (2, textures);
-    gl.extensions.glGenFramebuffers (2, fbos);
+    GLResourceRegistry::instance().genTextures (owner, 2, textures);
+    GLResourceRegistry::instance().genFramebuffers (gl, owner, 2, fbos);
 
     for (int i = 0; i < 2; ++i)
     {
@@ -165,7 +169,7 @@ void ensurePingPongFBOs (juce::OpenGLContext& gl,
     fboHeight = height;
 }
 
-void ensureQuadVBO (juce::OpenGLContext& gl, juce::uint32& quadVBO)
+void ensureQuadVBO (juce::OpenGLContext& gl, const void* owner, juce::uint32& quadVBO)
 {
     if (quadVBO != 0)
         return;
@@ -176,18 +180,18 @@ void ensureQuadVBO (juce::OpenGLContext& gl, juce::uint32& quadVBO)
         -1.f,  1.f,
          1.f,  1.f
     };
-    gl.extensions.glGenBuffers (1, &quadVBO);
+    GLResourceRegistry::instance().genBuffers (gl, owner, 1, &quadVBO);
     gl.extensions.glBindBuffer (juce::gl::GL_ARRAY_BUFFER, quadVBO);
     gl.extensions.glBufferData (juce::gl::GL_ARRAY_BUFFER, sizeof (quadVerts), quadVerts, juce::gl::GL_STATIC_DRAW);
     gl.extensions.glBindBuffer (juce::gl::GL_ARRAY_BUFFER, 0);
 }
 
-void ensureFallbackTexture (juce::uint32& fallbackTexture)
+void ensureFallbackTexture (const void* owner, juce::uint32& fallbackTexture)
 {
     if (fallbackTexture != 0)
         return;
 
-    juce::gl::glGenTextures (1, &fallbackTexture);
+    GLResourceRegistry::instance().genTextures (owner, 1, &fallbackTexture);
     juce::gl::glBindTexture (juce::gl::GL_TEXTURE_2D, fallbackTexture);
 
     const juce::uint8 blackPixel[4] = { 0, 0, 0, 255 };
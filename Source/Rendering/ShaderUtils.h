@@ -6,6 +6,9 @@ namespace pf
 
 namespace ShaderUtils
 {
+    // Helpers that allocate GPU objects take the owning node, and allocate through
+    // GLResourceRegistry so the objects are released when the node goes away.
+
     juce::String getShaderInfoLog (juce::OpenGLContext& gl, juce::uint32 shader);
     juce::String getProgramInfoLog (juce::OpenGLContext& gl, juce::uint32 program);
 
@@ -15,23 +18,26 @@ namespace ShaderUtils
                                      juce::String& outErrorLog);
 
     juce::uint32 linkProgram (juce::OpenGLContext& gl,
+                              const void* owner,
                               juce::uint32 vs,
                               juce::uint32 fs,
                               juce::String& outErrorLog);
 
     void ensureFBO (juce::OpenGLContext& gl,
+                    const void* owner,
                     juce::uint32& fbo, juce::uint32& fboTexture,
                     int& fboWidth, int& fboHeight,
                     int width, int height);
 
     void ensurePingPongFBOs (juce::OpenGLContext& gl,
+                             const void* owner,
                              juce::uint32 fbos[2], juce::uint32 textures[2],
                              int& fboWidth, int& fboHeight,
                              int width, int height);
 
-    void ensureQuadVBO (juce::OpenGLContext& gl, juce::uint32& quadVBO);
+    void ensureQuadVBO (juce::OpenGLContext& gl, const void* owner, juce::uint32& quadVBO);
 
-    void ensureFallbackTexture (juce::uint32& fallbackTexture);
+    void ensureFallbackTexture (const void* owner, juce::uint32& fallbackTexture);
 
     void drawFullscreenQuad (juce::OpenGLContext& gl,
                              juce::uint32 shaderProgram,
@@ -1,8 +1,6 @@
 #include "Rendering/VisualCanvas.h"
+#include "Rendering/GLResourceRegistry.h"
 #include "UI/Theme.h"
-#include "Nodes/Visual/WaveformRendererNode.h"
-#include "Nodes/Visual/SpectrumRendererNode.h"
-#include "Nodes/Visual/ShaderVisualNode.h"
 
 namespace pf
 {
@@ -32,6 +30,16 @@ void VisualCanvas::newOpenGLContextCreated()
 void VisualCanvas::renderOpenGL()
 {
     auto startTick = juce::Time::getHighResolutionTicks();
+
+    // Animate by the time since the last frame, capped so a stall doesn't jump ahead
+    double frameSeconds = 1.0 / 60.0;
+    if (lastFrameTick_ != 0)
+        frameSeconds = juce::jmin (0.1, juce::Time::highResolutionTicksToSeconds (startTick - lastFrameTick_));
+    lastFrameTick_ = startTick;
+
+    // Free GPU objects of nodes destroyed since the last frame
+    GLResourceRegistry::instance().processPendingReleases (glContext_);
+
     auto scale = static_cast<float> (glContext_.getRenderingScale());
     int width  = static_cast<int> (getWidth() * scale);
     int height = static_cast<int> (getHeight() * scale);
@@ -47,43 +55,24 @@ void VisualCanvas::renderOpenGL()
     bool foundOutputCanvas = false;
     OutputCanvasNode* outputCanvasNode = nullptr;
     juce::uint32 outputCanvasTexture = 0;
-    AnalysisSnapshot localSnapshot;
+
+    auto* graphs = graphs_.load (std::memory_order_acquire);
+    auto* graph = graphs ? graphs->acquire (GraphReclaimer::Reader::Visual) : nullptr;
+    if (graph != boundGraph_)
     {
-        const juce::SpinLock::ScopedLockType lock (snapshotLock_);
-        localSnapshot = snapshot_;
+        if (graph)
+            graph->bindVisualNodes (boundGraph_);
+        boundGraph_ = graph;
+        gpuTimer_.discardPending();
     }
 
-    auto* graph = runtimeGraph_.load (std::memory_order_acquire);
     if (graph)
     {
         const auto& visualOrder = graph->getVisualProcessOrder();
         visualNodeCount_.store (static_cast<int> (visualOrder.size()), std::memory_order_release);
 
-        // Update visual nodes with latest analysis data
-        for (auto* node : visualOrder)
-        {
-            if (auto* wfn = dynamic_cast<WaveformRendererNode*> (node))
-            {
-                if (localSnapshot.hasData)
-                    wfn->updateWaveformSnapshot (localSnapshot.latestFrame.waveform.data(),
-                                                  localSnapshot.latestFrame.waveformSize);
-            }
-            else if (auto* srn = dynamic_cast<SpectrumRendererNode*> (node))
-            {
-                if (localSnapshot.hasData)
-                    srn->updateMagnitudes (localSnapshot.latestFrame.magnitudes.data(),
-                                            localSnapshot.latestFrame.numBins);
-            }
-            else if (auto* svn = dynamic_cast<ShaderVisualNode*> (node))
-            {
-                if (localSnapshot.hasData)
-                    svn->updateMagnitudes (localSnapshot.latestFrame.magnitudes.data(),
-                                            localSnapshot.latestFrame.numBins);
-            }
-        }
-
         // Process visual nodes
-        graph->processVisualFrame (glContext_);
+        graph->processVisualFrame (glContext_, frameSeconds, gpuTimer_.beginFrame() ? &gpuTimer_ : nullptr);
 
         // Find OutputCanvas and blit its input texture
         for (auto* node : visualOrder)
@@ -162,6 +151,13 @@ void VisualCanvas::renderOpenGL()
 
 void VisualCanvas::openGLContextClosing()
 {
+    if (auto* graphs = graphs_.load (std::memory_order_acquire))
+        graphs->release (GraphReclaimer::Reader::Visual);
+    boundGraph_ = nullptr;
+
+    GLResourceRegistry::instance().processPendingReleases (glContext_);
+    gpuTimer_.release();
+
     if (blitProgram_ != 0)
     {
         glContext_.extensions.glDeleteProgram (blitProgram_);
@@ -181,16 +177,6 @@ void VisualCanvas::openGLContextClosing()
 
 void VisualCanvas::timerCallback()
 {
-    if (analysisFifo_)
-    {
-        AnalysisFrame frame;
-        if (analysisFifo_->popLatestFrame (frame))
-        {
-            const juce::SpinLock::ScopedLockType lock (snapshotLock_);
-            snapshot_.latestFrame = frame;
-            snapshot_.hasData = true;
-        }
-    }
     repaint();
 }
 
@@ -204,6 +190,19 @@ void VisualCanvas::paint (juce::Graphics& g)
     if (visualNodeCount > 0)
         info += "  |  Nodes: " + juce::String (visualNodeCount);
 
+    const auto glStats = GLResourceRegistry::instance().getStats();
+    if (glStats.getTotalLive() > 0)
+        info += "  |  GL: " + juce::String (glStats.getTotalLive());
+
+    if (gpuTimer_.isEnabled())
+    {
+        const auto gpuStats = gpuTimer_.getFrameTimings().getStats();
+        if (! gpuTimer_.isSupported())
+            info += "  |  GPU: n/a";
+        else if (gpuStats.numSamples > 0)
+            info += "  |  GPU: " + juce::String (gpuStats.avgMicros / 1000.f, 2) + " ms";
+    }
+
     float textWidth = juce::Font (Theme::kFontGroupHeader).getStringWidthFloat (info) + 16.f;
     float pillWidth = juce::jmax (textWidth, 80.f);
     float pillHeight = 22.f;
@@ -1,8 +1,8 @@
 #pragma once
 #include <juce_opengl/juce_opengl.h>
 #include <juce_gui_basics/juce_gui_basics.h>
-#include "Graph/RuntimeGraph.h"
-#include "Audio/AnalysisSnapshot.h"
+#include "Graph/GraphReclaimer.h"
+#include "Rendering/GPUTimer.h"
 #include "Nodes/Visual/OutputCanvasNode.h"
 #include <atomic>
 
@@ -28,21 +28,24 @@ public:
     void openGLContextClosing() override;
 
     //==============================================================================
-    // Timer — consumes analysis FIFO on GUI thread
+    // Timer — repaints the stats overlay
     void timerCallback() override;
 
     void paint (juce::Graphics& g) override;
 
     //==============================================================================
-    void setRuntimeGraph (RuntimeGraph* graph) { runtimeGraph_.store (graph, std::memory_order_release); }
-    void setAnalysisFIFO (AnalysisFIFO* fifo) { analysisFifo_ = fifo; }
+    void setGraphSource (GraphReclaimer* graphs) { graphs_.store (graphs, std::memory_order_release); }
+
+    /** Turns per-node GPU timing (see GPUTimer) on or off. */
+    void setGpuTimingEnabled (bool enabled) { gpuTimer_.setEnabled (enabled); }
+    bool isGpuTimingEnabled() const { return gpuTimer_.isEnabled(); }
 
 private:
     juce::OpenGLContext glContext_;
-    std::atomic<RuntimeGraph*> runtimeGraph_ { nullptr };
-    AnalysisFIFO* analysisFifo_ = nullptr;
-    AnalysisSnapshot snapshot_;
-    mutable juce::SpinLock snapshotLock_;
+    std::atomic<GraphReclaimer*> graphs_ { nullptr };
+    RuntimeGraph* boundGraph_ = nullptr;  // GL thread: graph whose visual bindings are applied
+    GPUTimer gpuTimer_;
+    juce::int64 lastFrameTick_ = 0;  // GL thread: start of the previous frame, 0 before the first
 
     // Blit shader for final output
     juce::uint32 blitProgram_ = 0;
@@ -0,0 +1,99 @@
+#include "Audio/AudioWorkerPool.h"
+#include <array>
+
+namespace pf
+{
+
+namespace
+{
+
+/** Counts the runs of every index of one batch, and flags items handed the wrong
+    context (a worker mixing one batch's function with another's context). */
+struct Batch
+{
+    static constexpr int kMaxItems = 64;
+
+    std::array<std::atomic<int>, kMaxItems> runs {};
+    std::atomic<int> wrongContext { 0 };
+    int id = 0;
+    int count = 0;
+
+    void reset (int batchId, int numItems)
+    {
+        for (auto& r : runs)
+            r.store (0, std::memory_order_relaxed);
+        wrongContext.store (0, std::memory_order_relaxed);
+        id = batchId;
+        count = numItems;
+    }
+};
+
+std::atomic<int> currentBatch { 0 };
+
+void runItem (void* context, int index)
+{
+    auto& batch = *static_cast<Batch*> (context);
+    if (batch.id != currentBatch.load (std::memory_order_relaxed) || index >= batch.count)
+        batch.wrongContext.fetch_add (1, std::memory_order_relaxed);
+    else
+        batch.runs[static_cast<size_t> (index)].fetch_add (1, std::memory_order_relaxed);
+}
+
+} // namespace
+
+class AudioWorkerPoolTests : public juce::UnitTest
+{
+public:
+    AudioWorkerPoolTests() : juce::UnitTest ("AudioWorkerPool", "Audio") {}
+
+    void runTest() override
+    {
+        beginTest ("Back-to-back small batches run every index exactly once");
+        {
+            AudioWorkerPool pool;
+            pool.start (3);
+
+            // Alternate between two contexts so a stale worker would pick up the
+            // other one's id
+            std::array<Batch, 2> batches;
+            juce::Random random (4321);
+            int failures = 0;
+
+            for (int b = 1; b <= 200000 && failures == 0; ++b)
+            {
+                auto& batch = batches[static_cast<size_t> (b % 2)];
+                batch.reset (b, 2 + random.nextInt (Batch::kMaxItems - 1));
+                currentBatch.store (b, std::memory_order_relaxed);
+
+                pool.parallelFor (batch.count, runItem, &batch);
+
+                if (batch.wrongContext.load() != 0)
+                    ++failures;
+
+                for (int i = 0; i < batch.count; ++i)
+                    if (batch.runs[static_cast<size_t> (i)].load() != 1)
+                        ++failures;
+            }
+
+            expectEquals (failures, 0);
+            pool.stop();
+        }
+
+        beginTest ("Runs serially without workers");
+        {
+            AudioWorkerPool pool;
+            Batch batch;
+            batch.reset (0, 10);
+            currentBatch.store (0);
+
+            pool.parallelFor (batch.count, runItem, &batch);
+
+            for (int i = 0; i < batch.count; ++i)
+                expectEquals (batch.runs[static_cast<size_t> (i)].load(), 1);
+        }
+    }
+};
+
+static AudioWorkerPoolTests audioWorkerPoolTests;
+
+} // namespace pf
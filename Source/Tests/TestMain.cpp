@@ -0,0 +1,24 @@
+#include <juce_core/juce_core.h>
+
+/**
+ * Runs every juce::UnitTest linked into PatchFlowTests (or those of one category
+ * with --category=<name>) and exits non-zero if any failed. Registered with CTest.
+ */
+int main (int argc, char* argv[])
+{
+    juce::ArgumentList args (argc, argv);
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure (false);
+
+    if (args.containsOption ("--category"))
+        runner.runTestsInCategory (args.getValueForOption ("--category"));
+    else
+        runner.runAllTests();
+
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        if (runner.getResult (i)->failures > 0)
+            return 1;
+
+    return 0;
+}
@@ -68,10 +68,15 @@ void NodeComponent::paint (juce::Graphics& g)
     g.setColour (juce::Colour (0x20000000));
     g.drawHorizontalLine (static_cast<int> (headerBounds.getBottom()), bounds.getX(), bounds.getX() + bounds.getWidth());
 
+    // Profiling badge, right of the title
+    auto titleBounds = headerBounds.reduced (8, 0);
+    if (running_)
+        paintTimingBadge (g, titleBounds.removeFromRight (44.f));
+
     // Title
     g.setColour (juce::Colour (Theme::kTextPrimary));
     g.setFont (juce::Font (Theme::kFontNodeHeader));
-    g.drawText (displayName_, headerBounds.reduced (8, 0), juce::Justification::centredLeft);
+    g.drawText (displayName_, titleBounds, juce::Justification::centredLeft);
 
     // Port labels
     g.setFont (juce::Font (Theme::kFontSmall));
@@ -176,6 +181,48 @@ PortComponent* NodeComponent::getOutputPort (int index) const
     return (index < static_cast<int> (outputPorts_.size())) ? outputPorts_[index].get() : nullptr;
 }
 
+void NodeComponent::setTimings (const NodeTimings::Stats& stats, const NodeTimings::Stats& gpuStats)
+{
+    // Not recorded since the last update: not scheduled, or skipped as unchanged
+    bool running = stats.numRecorded != timings_.numRecorded;
+    if (! running && ! running_)
+        return;
+
+    bool gpuRunning = gpuStats.numRecorded != gpuRecorded_;
+    timings_ = stats;
+    gpuRecorded_ = gpuStats.numRecorded;
+    running_ = running;
+
+    auto ms = [] (float micros) { return juce::String (micros / 1000.f, 3) + " ms"; };
+    juce::String tooltip;
+    if (running)
+    {
+        tooltip = "min " + ms (stats.minMicros) + "  avg " + ms (stats.avgMicros)
+                + "  p99 " + ms (stats.p99Micros);
+
+        if (gpuRunning)
+            tooltip += "\nGPU  avg " + ms (gpuStats.avgMicros) + "  p99 " + ms (gpuStats.p99Micros);
+    }
+
+    setTooltip (tooltip);
+    repaint();
+}
+
+void NodeComponent::paintTimingBadge (juce::Graphics& g, juce::Rectangle<float> area)
+{
+    auto badge = area.withSizeKeepingCentre (area.getWidth(), 14.f);
+    g.setColour (Theme::heatColourForLoad (timings_.getLoad()).withAlpha (0.85f));
+    g.fillRoundedRectangle (badge, 7.f);
+
+    auto micros = timings_.avgMicros;
+    auto text = micros < 1000.f ? juce::String (juce::roundToInt (micros)) + "us"
+                                : juce::String (micros / 1000.f, 1) + "ms";
+
+    g.setColour (juce::Colour (Theme::kBgPrimary));
+    g.setFont (juce::Font (Theme::kFontSmall));
+    g.drawText (text, badge, juce::Justification::centred);
+}
+
 juce::Colour NodeComponent::getHeaderColour() const
 {
     return Theme::headerColourForCategory (category_);
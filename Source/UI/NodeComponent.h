@@ -1,6 +1,7 @@
 #pragma once
 #include <juce_gui_basics/juce_gui_basics.h>
 #include "Nodes/NodeBase.h"
+#include "Graph/NodeTimings.h"
 #include "UI/PortComponent.h"
 #include <vector>
 #include <memory>
@@ -10,7 +11,8 @@ namespace pf
 
 class NodeEditorComponent;
 
-class NodeComponent : public juce::Component
+class NodeComponent : public juce::Component,
+                      public juce::SettableTooltipClient
 {
 public:
     NodeComponent (NodeEditorComponent& editor, const juce::String& nodeId,
@@ -29,6 +31,10 @@ public:
     bool isSelected() const { return selected_; }
     void setSelected (bool s) { selected_ = s; repaint(); }
 
+    /** Latest processing-time stats; shown as a heat badge while the node runs.
+        GPU stats, if recorded, are added to the tooltip. */
+    void setTimings (const NodeTimings::Stats& stats, const NodeTimings::Stats& gpuStats);
+
     PortComponent* getInputPort (int index) const;
     PortComponent* getOutputPort (int index) const;
 
@@ -48,6 +54,10 @@ private:
     juce::String category_;
     bool selected_ = false;
 
+    NodeTimings::Stats timings_;
+    uint32_t gpuRecorded_ = 0;
+    bool running_ = false;
+
     std::vector<std::unique_ptr<PortComponent>> inputPorts_;
     std::vector<std::unique_ptr<PortComponent>> outputPorts_;
 
@@ -56,6 +66,7 @@ private:
     bool isDragging_ = false;
 
     juce::Colour getHeaderColour() const;
+    void paintTimingBadge (juce::Graphics& g, juce::Rectangle<float> area);
 };
 
 } // namespace pf
@@ -1,5 +1,6 @@
 #include "UI/NodeEditorComponent.h"
 #include "UI/InspectorPanel.h"
+#include "Graph/RuntimeGraph.h"
 #include "UI/Theme.h"
 #include <cmath>
 
@@ -464,7 +465,8 @@ void NodeEditorComponent::portDragEnded (PortComponent* targetPort)
     if (&sourcePort->getOwner() == &destPort->getOwner())
         return; // no self-connections
 
-    if (auto existing = findConnectionForInputPort (destPort))
+    auto existing = findConnectionForInputPort (destPort);
+    if (existing)
     {
         const bool sameConnection = (existing->sourceNode == sourcePort->getOwner().getNodeId()
                                      && existing->sourcePort == sourcePort->getPortIndex());
@@ -481,7 +483,9 @@ void NodeEditorComponent::portDragEnded (PortComponent* targetPort)
     conn.destNode   = destPort->getOwner().getNodeId();
     conn.destPort   = destPort->getPortIndex();
 
-    model_.addConnection (conn);
+    // Refused if it would close a cycle; keep what was connected before
+    if (! model_.addConnection (conn) && existing)
+        model_.addConnection (*existing);
 }
 
 PortComponent* NodeEditorComponent::findPortAt (juce::Point<float> position) const
@@ -606,6 +610,20 @@ void NodeEditorComponent::graphChanged()
     juce::MessageManager::callAsync ([this] { rebuildFromModel(); });
 }
 
+void NodeEditorComponent::nodeLayoutChanged (const juce::String& nodeId)
+{
+    if (isRebuilding_) return;
+
+    auto it = nodeComponents_.find (nodeId.toStdString());
+    if (it == nodeComponents_.end()) return;
+
+    auto nodeTree = model_.getNodeTree (nodeId);
+    it->second->setTopLeftPosition (static_cast<int> (static_cast<float> (nodeTree[IDs::x])),
+                                    static_cast<int> (static_cast<float> (nodeTree[IDs::y])));
+    updateCablePositions();
+    repaint();
+}
+
 void NodeEditorComponent::rebuildFromModel()
 {
     isRebuilding_ = true;
@@ -728,6 +746,16 @@ void NodeEditorComponent::zoomToFit()
     rebuildFromModel();
 }
 
+void NodeEditorComponent::showNodeTimings (const RuntimeGraph& graph)
+{
+    for (auto& node : graph.getAllNodes())
+    {
+        auto it = nodeComponents_.find (node->nodeId.toStdString());
+        if (it != nodeComponents_.end())
+            it->second->setTimings (node->getTimings().getStats(), node->getGpuTimings().getStats());
+    }
+}
+
 void NodeEditorComponent::deleteSelectedNodes()
 {
     for (auto& id : selectedNodes_)
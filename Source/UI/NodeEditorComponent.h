@@ -13,6 +13,7 @@ namespace pf
 {
 
 class InspectorPanel;
+class RuntimeGraph;
 
 /**
  * The main node editor canvas. Handles zoom, pan, background grid,
@@ -53,9 +54,13 @@ public:
     // View
     void zoomToFit();
 
+    /** Updates every node's profiling badge from the graph's recorded timings. */
+    void showNodeTimings (const RuntimeGraph& graph);
+
     //==============================================================================
     // GraphModel::Listener
     void graphChanged() override;
+    void nodeLayoutChanged (const juce::String& nodeId) override;
 
 private:
     void rebuildFromModel();
@@ -88,6 +88,14 @@ inline constexpr juce::uint32 kPortGlow         = 0x44ffffff;
 inline constexpr juce::uint32 kPortCompatible   = 0xff66ff88;
 inline constexpr juce::uint32 kPortIncompatible  = 0x44ff4444;
 
+//==============================================================================
+// Profiling badge (share of the block/frame budget a node takes)
+inline constexpr juce::uint32 kHeatCool = 0xff4caf50;
+inline constexpr juce::uint32 kHeatWarm = 0xffffc107;
+inline constexpr juce::uint32 kHeatHot  = 0xfff44336;
+inline constexpr float kHeatWarmLoad = 0.05f;
+inline constexpr float kHeatHotLoad  = 0.25f;
+
 //==============================================================================
 // Node dimensions
 inline constexpr int kNodeCornerRadius = 6;
@@ -105,5 +113,14 @@ inline juce::Colour headerColourForCategory (const juce::String& category)
     return juce::Colour (kHeaderDefault);
 }
 
+inline juce::Colour heatColourForLoad (float load)
+{
+    if (load <= kHeatWarmLoad)
+        return juce::Colour (kHeatCool).interpolatedWith (juce::Colour (kHeatWarm), load / kHeatWarmLoad);
+
+    auto t = juce::jmin (1.f, (load - kHeatWarmLoad) / (kHeatHotLoad - kHeatWarmLoad));
+    return juce::Colour (kHeatWarm).interpolatedWith (juce::Colour (kHeatHot), t);
+}
+
 } // namespace Theme
 } // namespace pf